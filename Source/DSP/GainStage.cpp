@@ -0,0 +1,114 @@
+/*
+  ==============================================================================
+
+    GainStage.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "GainStage.h"
+
+void GainStage::prepare(double newSampleRate)
+{
+    jassert( newSampleRate > 0.0 );
+    sampleRate = newSampleRate;
+    reset();
+}
+
+void GainStage::setRampDurationSeconds(double seconds)
+{
+    if( rampSeconds == seconds )
+        return;
+
+    rampSeconds = seconds;
+    reset();
+}
+
+void GainStage::setGainDecibels(float decibels) noexcept
+{
+    gain.setTargetValue(juce::Decibels::decibelsToGain(decibels));
+}
+
+void GainStage::reset() noexcept
+{
+    if( sampleRate > 0.0 )
+        gain.reset(sampleRate, rampSeconds);
+}
+
+void GainStage::process(const juce::dsp::AudioBlock<float>& block, Matrix matrix) noexcept
+{
+    const auto numSamples = block.getNumSamples();
+    const auto numChannels = block.getNumChannels();
+    if( numChannels < 2 )
+        matrix = Matrix::None;
+
+    //the plain gain: one vector multiply per channel, or a ramp
+    if( matrix == Matrix::None )
+    {
+        if( gain.isSmoothing() )
+        {
+            for( size_t i = 0; i < numSamples; ++i )
+            {
+                auto g = gain.getNextValue();
+                for( size_t ch = 0; ch < numChannels; ++ch )
+                    block.getChannelPointer(ch)[i] *= g;
+            }
+        }
+        else if( gain.getTargetValue() != 1.f )
+        {
+            block.multiplyBy(gain.getTargetValue());
+        }
+
+        return;
+    }
+
+    //the matrix takes channels 0 and 1. anything after them only gets the gain.
+    auto* a = block.getChannelPointer(0);
+    auto* b = block.getChannelPointer(1);
+    //the encoder's 1/2 is folded into the gain
+    const auto scale = matrix == Matrix::EncodeMidSide ? 0.5f : 1.f;
+
+    if( gain.isSmoothing() )
+    {
+        for( size_t i = 0; i < numSamples; ++i )
+        {
+            auto g = gain.getNextValue();
+            auto x = a[i], y = b[i];
+            a[i] = (x + y) * g * scale;
+            b[i] = (x - y) * g * scale;
+            for( size_t ch = 2; ch < numChannels; ++ch )
+                block.getChannelPointer(ch)[i] *= g;
+        }
+
+        return;
+    }
+
+    //a constant gain: a loop the compiler vectorizes
+    const auto g = gain.getTargetValue() * scale;
+    for( size_t i = 0; i < numSamples; ++i )
+    {
+        auto x = a[i], y = b[i];
+        a[i] = (x + y) * g;
+        b[i] = (x - y) * g;
+    }
+
+    for( size_t ch = 2; ch < numChannels; ++ch )
+        juce::FloatVectorOperations::multiply(block.getChannelPointer(ch), g / scale, static_cast<int>(numSamples));
+}
+
+void GainStage::applyMatrix(const juce::dsp::AudioBlock<float>& block, Matrix matrix) noexcept
+{
+    if( matrix == Matrix::None || block.getNumChannels() < 2 )
+        return;
+
+    auto* a = block.getChannelPointer(0);
+    auto* b = block.getChannelPointer(1);
+    const auto scale = matrix == Matrix::EncodeMidSide ? 0.5f : 1.f;
+    for( size_t i = 0; i < block.getNumSamples(); ++i )
+    {
+        auto x = a[i], y = b[i];
+        a[i] = (x + y) * scale;
+        b[i] = (x - y) * scale;
+    }
+}
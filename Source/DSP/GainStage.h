@@ -0,0 +1,52 @@
+/*
+  ==============================================================================
+
+    GainStage.h
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/*
+ The input and output gain stages, with the mid/side matrix fused in.
+
+ The gain ramps linearly to a new value over the ramp duration, like juce::dsp::Gain.
+ In mid/side mode the input stage encodes left/right into mid/side and the output stage decodes it back,
+    in the same pass over the samples as the gain. the mode costs an add and a subtract per sample pair,
+    and no extra pass over the block.
+    M = (L + R) / 2 and S = (L - R) / 2 on the way in, L = M + S and R = M - S on the way out,
+    so a chain that leaves the signal alone gives back exactly what came in.
+ Blocks with fewer than 2 channels only get the gain.
+ */
+struct GainStage
+{
+    enum class Matrix : juce::uint8
+    {
+        None,
+        EncodeMidSide,
+        DecodeMidSide,
+        END_OF_LIST
+    };
+
+    void prepare(double sampleRate);
+    //the ramp starts over at the current target
+    void setRampDurationSeconds(double seconds);
+    void setGainDecibels(float decibels) noexcept;
+
+    //jumps to the target gain
+    void reset() noexcept;
+
+    //channels 0 and 1 are the pair the matrix works on
+    void process(const juce::dsp::AudioBlock<float>& block, Matrix matrix) noexcept;
+
+    //the matrix on its own, without the gain. for a chain that is in mid/side while the gain stages aren't.
+    static void applyMatrix(const juce::dsp::AudioBlock<float>& block, Matrix matrix) noexcept;
+
+private:
+    juce::LinearSmoothedValue<float> gain { 1.f };
+    double sampleRate = 0.0, rampSeconds = 0.0;
+};
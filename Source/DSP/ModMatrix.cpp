@@ -0,0 +1,288 @@
+/*
+  ==============================================================================
+
+    ModMatrix.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "ModMatrix.h"
+
+namespace
+{
+constexpr float envelopeFloorDb = -60.f;
+
+float getLfoValue(ModMatrix::LfoShape shape, double phase)
+{
+    //phase is in [0, 1)
+    auto x = static_cast<float>(phase);
+    switch( shape )
+    {
+        case ModMatrix::LfoShape::Sine: return std::sin(x * juce::MathConstants<float>::twoPi);
+        case ModMatrix::LfoShape::Triangle: return 1.f - 4.f * std::abs(x - 0.5f);
+        case ModMatrix::LfoShape::Saw: return 2.f * x - 1.f;
+        case ModMatrix::LfoShape::Square: return x < 0.5f ? 1.f : -1.f;
+        case ModMatrix::LfoShape::END_OF_LIST: break;
+    }
+
+    jassertfalse;
+    return 0.f;
+}
+
+//the per-sample coefficient of a one-pole that gets 63% of the way in timeMs
+float getFollowerCoefficient(float timeMs, double sampleRate)
+{
+    return std::exp(-1.f / (juce::jmax(0.1f, timeMs) * 0.001f * static_cast<float>(sampleRate)));
+}
+
+/*
+ what a follower follows, for numSamples of input from start: the loudest channel's magnitude for Peak,
+    the channels' mean square for RMS. vector operations across each channel, into signal.
+ an input without channels is silence. channelScratch holds a channel's part on the way.
+ */
+void detect(ModMatrix::Detector detector, const juce::dsp::AudioBlock<float>& input, size_t start, int numSamples,
+            float* signal, float* channelScratch) noexcept
+{
+    using FVO = juce::FloatVectorOperations;
+
+    const auto numChannels = input.getNumChannels();
+    if( numChannels == 0 )
+    {
+        FVO::clear(signal, numSamples);
+        return;
+    }
+
+    for( size_t ch = 0; ch < numChannels; ++ch )
+    {
+        const auto* samples = input.getChannelPointer(ch) + start;
+        auto* dest = ch == 0 ? signal : channelScratch;
+        if( detector == ModMatrix::Detector::Rms )
+            FVO::multiply(dest, samples, samples, numSamples);
+        else
+            FVO::abs(dest, samples, numSamples);
+
+        if( ch == 0 )
+            continue;
+
+        if( detector == ModMatrix::Detector::Rms )
+            FVO::add(signal, channelScratch, numSamples);
+        else
+            FVO::max(signal, signal, channelScratch, numSamples);
+    }
+
+    if( detector == ModMatrix::Detector::Rms && numChannels > 1 )
+        FVO::multiply(signal, 1.f / static_cast<float>(numChannels), numSamples);
+}
+
+//the one-pole, the only part that has to go a sample at a time
+float stepFollower(const float* signal, int numSamples, float level, float attack, float release) noexcept
+{
+    for( int i = 0; i < numSamples; ++i )
+    {
+        auto x = signal[i];
+        level = x + (level - x) * (x > level ? attack : release);
+    }
+
+    //keeps denormals out of a follower that has fallen silent
+    return level < 1.0e-15f ? 0.f : level;
+}
+} //end anonymous namespace
+
+void ModMatrix::Routing::setDepth(Source s, size_t target, float depth)
+{
+    jassert( s != Source::END_OF_LIST && target < maxTargets );
+    depths[static_cast<size_t>(s)][target] = juce::jlimit(-1.f, 1.f, depth);
+}
+
+bool ModMatrix::Routing::isSourceUsed(Source s) const
+{
+    const auto& row = depths[static_cast<size_t>(s)];
+    return std::any_of(row.begin(), row.end(), [](auto depth) { return depth != 0.f; });
+}
+
+bool ModMatrix::Routing::hasRoutes() const
+{
+    for( size_t s = 0; s < numSources; ++s )
+    {
+        if( isSourceUsed(static_cast<Source>(s)) )
+            return true;
+    }
+
+    return false;
+}
+
+juce::String ModMatrix::getSourceName(Source s)
+{
+    switch( s )
+    {
+        case Source::Lfo1: return "LFO 1";
+        case Source::Lfo2: return "LFO 2";
+        case Source::Envelope1: return "Envelope 1";
+        case Source::Envelope2: return "Envelope 2";
+        case Source::END_OF_LIST: break;
+    }
+
+    jassertfalse;
+    return {};
+}
+
+juce::String ModMatrix::getDetectorName(Detector detector)
+{
+    switch( detector )
+    {
+        case Detector::Peak: return "Peak";
+        case Detector::Rms: return "RMS";
+        case Detector::END_OF_LIST: break;
+    }
+
+    jassertfalse;
+    return {};
+}
+
+juce::String ModMatrix::getEnvelopeInputName(EnvelopeInput input)
+{
+    switch( input )
+    {
+        case EnvelopeInput::Main: return "Main";
+        case EnvelopeInput::Sidechain: return "Sidechain";
+        case EnvelopeInput::END_OF_LIST: break;
+    }
+
+    jassertfalse;
+    return {};
+}
+
+juce::String ModMatrix::getLfoShapeName(LfoShape shape)
+{
+    switch( shape )
+    {
+        case LfoShape::Sine: return "Sine";
+        case LfoShape::Triangle: return "Triangle";
+        case LfoShape::Saw: return "Saw";
+        case LfoShape::Square: return "Square";
+        case LfoShape::END_OF_LIST: break;
+    }
+
+    jassertfalse;
+    return {};
+}
+
+void ModMatrix::prepare(double newSampleRate)
+{
+    jassert( newSampleRate > 0.0 );
+    sampleRate = newSampleRate;
+    updateFollowerCoefficients();
+    reset();
+}
+
+void ModMatrix::updateFollowerCoefficients() noexcept
+{
+    for( size_t e = 0; e < numEnvelopes; ++e )
+    {
+        attackCoefficients[e] = getFollowerCoefficient(routing.envelopes[e].attackMs, sampleRate);
+        releaseCoefficients[e] = getFollowerCoefficient(routing.envelopes[e].releaseMs, sampleRate);
+    }
+}
+
+void ModMatrix::reset() noexcept
+{
+    lfoPhases.fill(0.0);
+    envelopeLevels.fill(0.f);
+    values.fill(0.f);
+    offsets.fill(0.f);
+}
+
+void ModMatrix::setRouting(const Routing& newRouting) noexcept
+{
+    routing = newRouting;
+
+    active = false;
+    for( size_t t = 0; t < maxTargets; ++t )
+    {
+        targeted[t] = false;
+        for( size_t s = 0; s < numSources; ++s )
+            targeted[t] = targeted[t] || routing.depths[s][t] != 0.f;
+
+        active = active || targeted[t];
+    }
+
+    detectorsUsed = {};
+    for( size_t e = 0; e < numEnvelopes; ++e )
+    {
+        envelopesUsed[e] = routing.isSourceUsed(static_cast<Source>(static_cast<size_t>(Source::Envelope1) + e));
+        if( envelopesUsed[e] )
+        {
+            const auto& settings = routing.envelopes[e];
+            detectorsUsed[static_cast<size_t>(settings.input)][static_cast<size_t>(settings.detector)] = true;
+        }
+    }
+    
+    updateFollowerCoefficients();
+
+    //a target that was just unrouted doesn't keep its last offset
+    offsets.fill(0.f);
+}
+
+void ModMatrix::follow(const juce::dsp::AudioBlock<float>& main, const juce::dsp::AudioBlock<float>& sidechain) noexcept
+{
+    const auto numSamples = main.getNumSamples();
+    if( active == false || numSamples == 0 )
+        return;
+
+    for( size_t start = 0; start < numSamples; start += detectorChunk )
+    {
+        const auto chunk = static_cast<int>(juce::jmin(detectorChunk, numSamples - start));
+
+        //each input and detector that some follower uses is worked out once, and shared by the followers
+        for( size_t in = 0; in < numInputs; ++in )
+        {
+            const auto& input = static_cast<EnvelopeInput>(in) == EnvelopeInput::Sidechain ? sidechain : main;
+            for( size_t d = 0; d < numDetectors; ++d )
+            {
+                if( detectorsUsed[in][d] )
+                    detect(static_cast<Detector>(d), input, start, chunk, detectorSignals[in][d].data(), channelScratch.data());
+            }
+        }
+
+        //a one-pole follower, stepped every sample, so the level doesn't depend on where the segments start
+        for( size_t e = 0; e < numEnvelopes; ++e )
+        {
+            if( envelopesUsed[e] == false )
+                continue;
+
+            const auto& settings = routing.envelopes[e];
+            const auto& signal = detectorSignals[static_cast<size_t>(settings.input)][static_cast<size_t>(settings.detector)];
+            envelopeLevels[e] = stepFollower(signal.data(), chunk, envelopeLevels[e], attackCoefficients[e], releaseCoefficients[e]);
+        }
+    }
+}
+
+void ModMatrix::advance(int numSamples) noexcept
+{
+    if( active == false )
+        return;
+
+    for( size_t l = 0; l < numLfos; ++l )
+    {
+        const auto& settings = routing.lfos[l];
+        auto& phase = lfoPhases[l];
+        phase += static_cast<double>(settings.rateHz) * numSamples / sampleRate;
+        phase -= std::floor(phase);
+        values[static_cast<size_t>(Source::Lfo1) + l] = getLfoValue(settings.shape, phase);
+    }
+
+    for( size_t e = 0; e < numEnvelopes; ++e )
+    {
+        auto level = routing.envelopes[e].detector == Detector::Rms ? std::sqrt(envelopeLevels[e]) : envelopeLevels[e];
+        auto db = juce::Decibels::gainToDecibels(level, envelopeFloorDb);
+        values[static_cast<size_t>(Source::Envelope1) + e] = juce::jlimit(0.f, 1.f, juce::jmap(db, envelopeFloorDb, 0.f, 0.f, 1.f));
+    }
+
+    offsets.fill(0.f);
+    for( size_t s = 0; s < numSources; ++s )
+    {
+        if( values[s] != 0.f )
+            juce::FloatVectorOperations::addWithMultiply(offsets.data(), routing.depths[s].data(), values[s], static_cast<int>(maxTargets));
+    }
+}
@@ -0,0 +1,174 @@
+/*
+  ==============================================================================
+
+    ModMatrix.h
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/*
+ The modulation matrix: 2 LFOs and 2 envelope followers that move parameters without a trip through the host.
+
+ The sources are computed once per control tick, at the end of the tick's interval, the same point the
+    smoothers are advanced to. see Project13AudioProcessor::runControlTick().
+ Every target gets the sum of all of its routes: source value * depth, in normalized parameter units,
+    so a depth of 1 sweeps the target's whole range, whatever its skew. negative depths invert.
+    the processor adds the sum to the smoothed value of the target and clamps it to the range.
+ The depths are a dense source x target matrix, so summing all the routes is one vector multiply-add
+    per source that is doing anything, no matter how many routes there are.
+
+ LFOs are bipolar: -1 to 1.
+ Envelope followers are unipolar: 0 at -60 dBFS and below, 1 at 0 dBFS.
+    each one follows the peak or RMS level of the signal entering the chain, or of the sidechain input,
+        sample by sample, with its own attack and release. so the level at a control tick is the same
+        however the host splits the audio into blocks.
+    what they follow (a magnitude or a square per sample, across the channels) is worked out with vector
+        operations, once per input and detector, however many followers share it. only the one-pole
+        itself runs a sample at a time.
+    a follower only runs while it is routed, so an instance that doesn't use them pays nothing.
+    without a sidechain connected, a follower listening to it hears silence and falls to 0.
+
+ Targets are identified by index, which the processor maps to its StateParam stable IDs.
+ Nothing here allocates or locks once prepared, so the audio thread can own a ModMatrix outright.
+ */
+struct ModMatrix
+{
+    enum class Source : juce::uint8
+    {
+        Lfo1,
+        Lfo2,
+        Envelope1,
+        Envelope2,
+        END_OF_LIST
+    };
+
+    static constexpr size_t numSources = static_cast<size_t>(Source::END_OF_LIST);
+    static constexpr size_t numLfos = 2, numEnvelopes = 2;
+    static constexpr size_t maxTargets = 64;
+
+    enum class LfoShape : juce::uint8
+    {
+        Sine,
+        Triangle,
+        Saw,
+        Square,
+        END_OF_LIST
+    };
+
+    struct LfoSettings
+    {
+        float rateHz = 1.f;
+        LfoShape shape = LfoShape::Sine;
+
+        bool operator==(const LfoSettings&) const = default;
+    };
+
+    enum class Detector : juce::uint8
+    {
+        Peak,
+        Rms,
+        END_OF_LIST
+    };
+
+    enum class EnvelopeInput : juce::uint8
+    {
+        Main,
+        Sidechain,
+        END_OF_LIST
+    };
+
+    struct EnvelopeSettings
+    {
+        float attackMs = 10.f;
+        float releaseMs = 150.f;
+        Detector detector = Detector::Peak;
+        EnvelopeInput input = EnvelopeInput::Main;
+
+        bool operator==(const EnvelopeSettings&) const = default;
+    };
+
+    /*
+     everything about the modulation that is saved in the plugin state.
+     a default Routing has no routes, and modulates nothing.
+     */
+    struct Routing
+    {
+        std::array<LfoSettings, numLfos> lfos {};
+        std::array<EnvelopeSettings, numEnvelopes> envelopes {};
+        //[source][target]
+        std::array<std::array<float, maxTargets>, numSources> depths {};
+
+        float getDepth(Source s, size_t target) const { return depths[static_cast<size_t>(s)][target]; }
+        void setDepth(Source s, size_t target, float depth);
+
+        bool isSourceUsed(Source s) const;
+        bool hasRoutes() const;
+
+        bool operator==(const Routing&) const = default;
+    };
+
+    static juce::String getSourceName(Source s);
+    static juce::String getLfoShapeName(LfoShape shape);
+    static juce::String getDetectorName(Detector detector);
+    static juce::String getEnvelopeInputName(EnvelopeInput input);
+
+    //not while the audio thread is using it
+    void prepare(double sampleRate);
+
+    //audio thread. clears the LFO phases and the envelopes.
+    void reset() noexcept;
+
+    //audio thread. the LFOs keep their phases and the envelopes their levels.
+    void setRouting(const Routing& newRouting) noexcept;
+    const Routing& getRouting() const noexcept { return routing; }
+
+    //true while any route is set. until then, the processor can skip the matrix entirely.
+    bool isActive() const noexcept { return active; }
+    bool isTargeted(size_t target) const noexcept { return targeted[target]; }
+
+    /*
+     audio thread. feeds the envelope followers a segment of the signal entering the chain,
+        and the same segment of the sidechain, which has no channels when there isn't one.
+     */
+    void follow(const juce::dsp::AudioBlock<float>& main, const juce::dsp::AudioBlock<float>& sidechain) noexcept;
+
+    //audio thread. moves the LFOs on by numSamples, then sums every route into the targets' offsets.
+    void advance(int numSamples) noexcept;
+
+    //from the last advance(). normalized units, maxTargets of them.
+    const float* getOffsets() const noexcept { return offsets.data(); }
+    float getSourceValue(Source s) const noexcept { return values[static_cast<size_t>(s)]; }
+
+private:
+    Routing routing;
+    bool active = false;
+    std::array<bool, maxTargets> targeted {};
+    std::array<bool, numEnvelopes> envelopesUsed {};
+
+    double sampleRate = 44100.0;
+    std::array<double, numLfos> lfoPhases {};
+    //linear peak levels, or mean squares for the RMS followers
+    std::array<float, numEnvelopes> envelopeLevels {};
+    //per sample, from the attack and release times
+    std::array<float, numEnvelopes> attackCoefficients {}, releaseCoefficients {};
+
+    void updateFollowerCoefficients() noexcept;
+
+    static constexpr size_t numInputs = static_cast<size_t>(EnvelopeInput::END_OF_LIST);
+    static constexpr size_t numDetectors = static_cast<size_t>(Detector::END_OF_LIST);
+    //follow() works through a segment this many samples at a time
+    static constexpr size_t detectorChunk = 256;
+
+    //[input][detector], for the routed followers
+    std::array<std::array<bool, numDetectors>, numInputs> detectorsUsed {};
+    alignas(16) std::array<std::array<std::array<float, detectorChunk>, numDetectors>, numInputs> detectorSignals {};
+    alignas(16) std::array<float, detectorChunk> channelScratch {};
+
+    std::array<float, numSources> values {};
+    alignas(16) std::array<float, maxTargets> offsets {};
+};
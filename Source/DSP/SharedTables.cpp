@@ -0,0 +1,75 @@
+/*
+  ==============================================================================
+
+    SharedTables.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "SharedTables.h"
+
+#include <mutex>
+#include <thread>
+
+namespace
+{
+/*
+ the registry. the mutex only guards handle creation and destruction.
+ readers only ever touch 'published', which holds the tables once the builder has finished them.
+ */
+std::mutex registryMutex;
+int numHandles = 0;
+std::thread builder;
+std::atomic<const SharedTables*> published { nullptr };
+} //end anonymous namespace
+
+void SharedTables::build()
+{
+    for( int i = 0; i <= quarterSineSize; ++i )
+    {
+        auto angle = static_cast<double>(i) / quarterSineSize * juce::MathConstants<double>::halfPi;
+        quarterSineTable[static_cast<size_t>(i)] = static_cast<float>(std::sin(angle));
+    }
+}
+
+SharedTables::Handle::Handle()
+{
+    std::lock_guard<std::mutex> lock(registryMutex);
+    if( numHandles++ > 0 )
+        return;
+
+    //a previous builder was joined when the last handle went away, so this is the only one
+    jassert( builder.joinable() == false && published.load() == nullptr );
+    builder = std::thread([]
+    {
+        //the constructor is private, and make_unique can't reach it
+        auto tables = std::unique_ptr<SharedTables>(new SharedTables());
+        tables->build();
+        published.store(tables.release(), std::memory_order_release);
+    });
+}
+
+SharedTables::Handle::~Handle()
+{
+    std::lock_guard<std::mutex> lock(registryMutex);
+    if( --numHandles > 0 )
+        return;
+
+    //every reader holds a handle, so nobody can be using the tables anymore
+    if( builder.joinable() )
+        builder.join();
+
+    delete published.exchange(nullptr, std::memory_order_acq_rel);
+}
+
+const SharedTables* SharedTables::Handle::get() const noexcept
+{
+    return published.load(std::memory_order_acquire);
+}
+
+int SharedTables::getNumHandles()
+{
+    std::lock_guard<std::mutex> lock(registryMutex);
+    return numHandles;
+}
@@ -0,0 +1,72 @@
+/*
+  ==============================================================================
+
+    SharedTables.h
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/*
+ Read-only lookup tables, shared by every Project13AudioProcessor in the process.
+
+ A host with hundreds of instances would otherwise hold hundreds of copies of the same tables,
+    and the copies would compete for the same cache.
+ The tables are built once, on a background thread, when the first Handle is created,
+    and freed when the last Handle goes away.
+ Until they are built, Handle::get() returns nullptr and callers compute the values directly,
+    so creating an instance never waits for them.
+
+ The tables never change once they are published, so any thread can read them without locking.
+ Each table starts on its own cache line.
+
+ New tables go in this struct and are filled in build().
+ */
+struct SharedTables
+{
+    static constexpr int quarterSineSize = 1024;
+
+    /*
+     sin(position * pi/2) for a position in [0, 1], linearly interpolated.
+     the error stays below 4e-7, around -128 dB.
+     */
+    float quarterSine(float position) const noexcept
+    {
+        auto x = juce::jlimit(0.f, 1.f, position) * static_cast<float>(quarterSineSize);
+        auto i = juce::jmin(static_cast<int>(x), quarterSineSize - 1);
+        auto frac = x - static_cast<float>(i);
+        return quarterSineTable[static_cast<size_t>(i)] + frac * (quarterSineTable[static_cast<size_t>(i) + 1] - quarterSineTable[static_cast<size_t>(i)]);
+    }
+
+    //the gains for an equal-power crossfade, at a position in [0, 1]
+    float fadeOutGain(float position) const noexcept { return quarterSine(1.f - position); }
+    float fadeInGain(float position) const noexcept { return quarterSine(position); }
+
+    /*
+     A reference to the shared tables. every processor owns one.
+     creating and destroying handles takes a lock, so do it from the message thread, never from the audio thread.
+     */
+    struct Handle
+    {
+        Handle();
+        ~Handle();
+
+        //any thread. nullptr while the tables are still being built.
+        const SharedTables* get() const noexcept;
+
+        JUCE_DECLARE_NON_COPYABLE(Handle)
+    };
+
+    //for diagnostics: the number of live handles
+    static int getNumHandles();
+
+private:
+    SharedTables() = default;
+    void build();
+
+    alignas(64) std::array<float, quarterSineSize + 1> quarterSineTable {};
+};
@@ -0,0 +1,161 @@
+/*
+  ==============================================================================
+
+    PresetBar.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "PresetBar.h"
+#include "../State/PresetLibrary.h"
+#include "../State/UndoJournal.h"
+#include "../PluginProcessor.h"
+
+PresetBar::PresetBar(Project13AudioProcessor& processor) :
+    library(processor.getPresetLibrary()),
+    journal(processor.getUndoJournal())
+{
+    searchBox.setTextToShowWhenEmpty("search presets", juce::Colours::grey);
+    searchBox.onTextChange = [this]() { refreshList(); };
+
+    presetList.setTextWhenNothingSelected("PRESETS");
+    presetList.onChange = [this]()
+    {
+        auto idx = presetList.getSelectedId() - 1;
+        if( juce::isPositiveAndBelow(idx, static_cast<int>(shownPresets.size())) )
+        {
+            library.loadPresetAsync(shownPresets[static_cast<size_t>(idx)]);
+        }
+    };
+
+    saveButton.onClick = [this]() { showSaveDialog(); };
+    undoButton.onClick = [this]() { journal.undo(); };
+    redoButton.onClick = [this]() { journal.redo(); };
+
+    crossfadeButton.setClickingTogglesState(true);
+    crossfadeButton.setTooltip("crossfade between the old and new settings when the order or preset changes");
+    crossfadeTime.setTextValueSuffix(" ms");
+    crossfadeModeAttachment = std::make_unique<juce::ButtonParameterAttachment>(*processor.crossfadeMode,
+                                                                                crossfadeButton);
+    crossfadeTimeAttachment = std::make_unique<juce::SliderParameterAttachment>(*processor.crossfadeTimeMs,
+                                                                                crossfadeTime);
+
+    storeAButton.setTooltip("store the current settings as morph snapshot A");
+    storeBButton.setTooltip("store the current settings as morph snapshot B");
+    storeAButton.onClick = [&processor]() { processor.storeMorphSnapshot(Project13AudioProcessor::MorphSlot::A); };
+    storeBButton.onClick = [&processor]() { processor.storeMorphSnapshot(Project13AudioProcessor::MorphSlot::B); };
+    morphButton.setClickingTogglesState(true);
+    morphSlider.setTextValueSuffix(" %");
+    morphEnabledAttachment = std::make_unique<juce::ButtonParameterAttachment>(*processor.morphEnabled,
+                                                                               morphButton);
+    morphAttachment = std::make_unique<juce::SliderParameterAttachment>(*processor.morph,
+                                                                        morphSlider);
+
+    midSideButton.setClickingTogglesState(true);
+    midSideButton.setTooltip("process mid on the left channel path and side on the right. each module gets a separate side bypass.");
+    midSideModeAttachment = std::make_unique<juce::ButtonParameterAttachment>(*processor.midSideMode,
+                                                                              midSideButton);
+
+    addAndMakeVisible(undoButton);
+    addAndMakeVisible(redoButton);
+    addAndMakeVisible(searchBox);
+    addAndMakeVisible(presetList);
+    addAndMakeVisible(saveButton);
+    addAndMakeVisible(crossfadeButton);
+    addAndMakeVisible(crossfadeTime);
+    addAndMakeVisible(storeAButton);
+    addAndMakeVisible(storeBButton);
+    addAndMakeVisible(morphButton);
+    addAndMakeVisible(morphSlider);
+    addAndMakeVisible(midSideButton);
+
+    library.addChangeListener(this);
+    journal.addChangeListener(this);
+    refreshList();
+    refreshUndoButtons();
+}
+
+PresetBar::~PresetBar()
+{
+    library.removeChangeListener(this);
+    journal.removeChangeListener(this);
+}
+
+void PresetBar::resized()
+{
+    auto bounds = getLocalBounds().reduced(2);
+    undoButton.setBounds(bounds.removeFromLeft(45));
+    redoButton.setBounds(bounds.removeFromLeft(45));
+    bounds.removeFromLeft(4);
+    midSideButton.setBounds(bounds.removeFromRight(40));
+    bounds.removeFromRight(4);
+    morphSlider.setBounds(bounds.removeFromRight(80));
+    morphButton.setBounds(bounds.removeFromRight(50));
+    storeBButton.setBounds(bounds.removeFromRight(20));
+    storeAButton.setBounds(bounds.removeFromRight(20));
+    bounds.removeFromRight(4);
+    crossfadeTime.setBounds(bounds.removeFromRight(80));
+    crossfadeButton.setBounds(bounds.removeFromRight(50));
+    bounds.removeFromRight(4);
+    saveButton.setBounds(bounds.removeFromRight(50));
+    bounds.removeFromRight(4);
+    searchBox.setBounds(bounds.removeFromLeft(bounds.getWidth() / 3));
+    bounds.removeFromLeft(4);
+    presetList.setBounds(bounds);
+}
+
+void PresetBar::changeListenerCallback(juce::ChangeBroadcaster* source)
+{
+    if( source == &journal )
+        refreshUndoButtons();
+    else
+        refreshList();
+}
+
+void PresetBar::refreshUndoButtons()
+{
+    undoButton.setEnabled(journal.canUndo());
+    redoButton.setEnabled(journal.canRedo());
+}
+
+void PresetBar::refreshList()
+{
+    shownPresets = library.search(searchBox.getText(), maxListedPresets);
+
+    presetList.clear(juce::dontSendNotification);
+    for( size_t i = 0; i < shownPresets.size(); ++i )
+    {
+        presetList.addItem(library.getPresetName(shownPresets[i]), static_cast<int>(i) + 1);
+    }
+
+    auto current = std::find(shownPresets.begin(), shownPresets.end(), library.getCurrentPreset());
+    if( current != shownPresets.end() )
+    {
+        presetList.setSelectedId(static_cast<int>(std::distance(shownPresets.begin(), current)) + 1,
+                                 juce::dontSendNotification);
+    }
+}
+
+void PresetBar::showSaveDialog()
+{
+    saveDialog = std::make_unique<juce::AlertWindow>("Save Preset",
+                                                     "Preset name:",
+                                                     juce::MessageBoxIconType::NoIcon);
+    saveDialog->addTextEditor("name", presetList.getText());
+    saveDialog->addButton("Save", 1, juce::KeyPress(juce::KeyPress::returnKey));
+    saveDialog->addButton("Cancel", 0, juce::KeyPress(juce::KeyPress::escapeKey));
+
+    saveDialog->enterModalState(true,
+                                juce::ModalCallbackFunction::create([safeThis = juce::Component::SafePointer<PresetBar>(this)](int result)
+    {
+        if( safeThis == nullptr )
+            return;
+
+        if( result == 1 )
+        {
+            safeThis->library.savePreset(safeThis->saveDialog->getTextEditorContents("name"));
+        }
+        safeThis->saveDialog.reset();
+    }), false);
+}
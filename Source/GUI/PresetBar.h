@@ -0,0 +1,66 @@
+/*
+  ==============================================================================
+
+    PresetBar.h
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+struct PresetLibrary;
+struct UndoJournal;
+struct Project13AudioProcessor;
+
+/*
+ A search box, a preset list and a save button across the top of the editor.
+ The list shows the presets matching the search text, straight from the memory-mapped index.
+ The crossfade toggle and time sit on the right, since they control how presets and order changes are switched.
+ The morph section stores the current settings as snapshot A or B and blends between them.
+ The M/S toggle switches the whole chain to mid/side processing.
+ Undo and redo step through the processor's UndoJournal.
+ */
+struct PresetBar : juce::Component, juce::ChangeListener
+{
+    PresetBar(Project13AudioProcessor& processor);
+    ~PresetBar() override;
+
+    void resized() override;
+    void changeListenerCallback(juce::ChangeBroadcaster* source) override;
+
+private:
+    void refreshList();
+    void refreshUndoButtons();
+    void showSaveDialog();
+
+    PresetLibrary& library;
+    UndoJournal& journal;
+
+    juce::TextEditor searchBox;
+    juce::ComboBox presetList;
+    juce::TextButton saveButton { "SAVE" };
+    juce::TextButton undoButton { "UNDO" }, redoButton { "REDO" };
+    
+    juce::TextButton crossfadeButton { "XFADE" };
+    juce::Slider crossfadeTime { juce::Slider::LinearBar, juce::Slider::TextBoxLeft };
+    std::unique_ptr<juce::ButtonParameterAttachment> crossfadeModeAttachment;
+    std::unique_ptr<juce::SliderParameterAttachment> crossfadeTimeAttachment;
+    
+    juce::TextButton storeAButton { "A" }, storeBButton { "B" };
+    juce::TextButton morphButton { "MORPH" };
+    juce::Slider morphSlider { juce::Slider::LinearBar, juce::Slider::TextBoxLeft };
+    std::unique_ptr<juce::ButtonParameterAttachment> morphEnabledAttachment;
+    std::unique_ptr<juce::SliderParameterAttachment> morphAttachment;
+    
+    juce::TextButton midSideButton { "M/S" };
+    std::unique_ptr<juce::ButtonParameterAttachment> midSideModeAttachment;
+
+    //presetList item id - 1 is an index into this vector, which holds library indexes
+    std::vector<int> shownPresets;
+    std::unique_ptr<juce::AlertWindow> saveDialog;
+
+    static constexpr int maxListedPresets = 500;
+};
@@ -0,0 +1,285 @@
+/*
+  ==============================================================================
+
+    ResponseCurveComponent.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "ResponseCurveComponent.h"
+
+bool ResponseCurveComponent::CurveState::operator==(const CurveState& other) const
+{
+    return generalMode == other.generalMode &&
+        generalFreq == other.generalFreq &&
+        generalQ == other.generalQ &&
+        generalGain == other.generalGain &&
+        generalBypassed == other.generalBypassed &&
+        ladderMode == other.ladderMode &&
+        ladderCutoff == other.ladderCutoff &&
+        ladderResonance == other.ladderResonance &&
+        ladderBypassed == other.ladderBypassed &&
+        sampleRate == other.sampleRate &&
+        width == other.width &&
+        height == other.height;
+}
+//==============================================================================
+ResponseCurveComponent::ResponseCurveComponent(Project13AudioProcessor& p) : processor(p)
+{
+    //the analyzer underneath handles the mouse.
+    setInterceptsMouseClicks(false, false);
+}
+
+juce::Rectangle<int> ResponseCurveComponent::getAnalysisArea() const
+{
+    /*
+     these are the same insets SpectrumAnalyzer::getRenderArea() and getAnalysisArea() use.
+     */
+    auto bounds = getLocalBounds();
+    bounds.removeFromTop(12);
+    bounds.removeFromBottom(2);
+    bounds.removeFromLeft(20);
+    bounds.removeFromRight(20);
+
+    bounds.removeFromTop(4);
+    bounds.removeFromBottom(4);
+    return bounds;
+}
+
+ResponseCurveComponent::CurveState ResponseCurveComponent::readState() const
+{
+    CurveState state;
+
+    state.generalMode = processor.generalFilterMode->getIndex();
+    state.generalFreq = processor.generalFilterFreqHz->get();
+    state.generalQ = processor.generalFilterQuality->get();
+    state.generalGain = processor.generalFilterGain->get();
+    state.generalBypassed = processor.generalFilterBypass->get();
+
+    state.ladderMode = processor.ladderFilterMode->getIndex();
+    state.ladderCutoff = processor.ladderFilterCutoffHz->get();
+    state.ladderResonance = processor.ladderFilterResonance->get();
+    state.ladderBypassed = processor.ladderFilterBypass->get();
+
+    //before prepareToPlay() is called the sample rate is 0.
+    state.sampleRate = processor.getSampleRate() > 0.0 ? processor.getSampleRate() : 44100.0;
+
+    auto area = getAnalysisArea();
+    state.width = juce::jmax(0, area.getWidth());
+    state.height = juce::jmax(0, area.getHeight());
+
+    return state;
+}
+
+bool ResponseCurveComponent::update()
+{
+    auto state = readState();
+    if( state == cachedState )
+        return false;
+
+    if( state.width != cachedState.width || state.sampleRate != cachedState.sampleRate )
+        rebuildFrequencyTables(state);
+
+    if( numPixels > 0 )
+    {
+        juce::FloatVectorOperations::clear(magnitudesDb.get(), numPixels);
+
+        if( state.generalBypassed == false )
+            addGeneralFilterMagnitudes(state);
+
+        if( state.ladderBypassed == false )
+            addLadderFilterMagnitudes(state);
+    }
+
+    rebuildPath(state);
+    cachedState = state;
+    repaint();
+
+    return true;
+}
+
+void ResponseCurveComponent::rebuildFrequencyTables(const CurveState& state)
+{
+    numPixels = state.width;
+    if( numPixels <= 0 )
+        return;
+
+    for( auto* block : { &frequencies, &cosW, &cos2W, &numerator, &denominator, &ratio, &magnitudesDb } )
+    {
+        block->realloc(static_cast<size_t>(numPixels));
+    }
+
+    const auto nyquist = static_cast<float>(state.sampleRate * 0.5);
+    for( int i = 0; i < numPixels; ++i )
+    {
+        //same log mapping the analyzer uses for its x axis
+        auto freq = juce::mapToLog10(static_cast<float>(i) / static_cast<float>(numPixels), 20.f, 20000.f);
+        freq = juce::jmin(freq, nyquist);
+        frequencies[i] = freq;
+
+        auto w = juce::MathConstants<float>::twoPi * freq / static_cast<float>(state.sampleRate);
+        cosW[i] = std::cos(w);
+        cos2W[i] = std::cos(2.f * w);
+    }
+}
+
+void ResponseCurveComponent::addGeneralFilterMagnitudes(const CurveState& state)
+{
+    using AC = juce::dsp::IIR::ArrayCoefficients<float>;
+
+    //ArrayCoefficients don't allocate, unlike Coefficients::Ptr.
+    std::array<float, 6> c {};
+    auto freq = juce::jmin(state.generalFreq, static_cast<float>(state.sampleRate * 0.5));
+    switch( static_cast<GeneralFilterMode>(state.generalMode) )
+    {
+        case GeneralFilterMode::Peak:
+            c = AC::makePeakFilter(state.sampleRate, freq, state.generalQ,
+                                   juce::Decibels::decibelsToGain(state.generalGain));
+            break;
+        case GeneralFilterMode::Bandpass:
+            c = AC::makeBandPass(state.sampleRate, freq, state.generalQ);
+            break;
+        case GeneralFilterMode::Notch:
+            c = AC::makeNotch(state.sampleRate, freq, state.generalQ);
+            break;
+        case GeneralFilterMode::Allpass:
+            c = AC::makeAllPass(state.sampleRate, freq, state.generalQ);
+            break;
+        case GeneralFilterMode::END_OF_LIST:
+            jassertfalse;
+            return;
+    }
+
+    /*
+     c is { b0, b1, b2, a0, a1, a2 }.
+     for z = e^jw the squared magnitude of a biquad reduces to
+
+             (b0^2 + b1^2 + b2^2) + 2(b0b1 + b1b2)cos(w) + 2b0b2 cos(2w)
+     |H|^2 = -----------------------------------------------------------
+             (a0^2 + a1^2 + a2^2) + 2(a0a1 + a1a2)cos(w) + 2a0a2 cos(2w)
+
+     so every pixel is just two multiply-adds against the cached cos tables.
+     */
+    const auto b0 = c[0], b1 = c[1], b2 = c[2], a0 = c[3], a1 = c[4], a2 = c[5];
+
+    auto* num = numerator.get();
+    auto* den = denominator.get();
+
+    juce::FloatVectorOperations::copyWithMultiply(num, cosW.get(), 2.f * (b0 * b1 + b1 * b2), numPixels);
+    juce::FloatVectorOperations::addWithMultiply(num, cos2W.get(), 2.f * b0 * b2, numPixels);
+    juce::FloatVectorOperations::add(num, b0 * b0 + b1 * b1 + b2 * b2, numPixels);
+
+    juce::FloatVectorOperations::copyWithMultiply(den, cosW.get(), 2.f * (a0 * a1 + a1 * a2), numPixels);
+    juce::FloatVectorOperations::addWithMultiply(den, cos2W.get(), 2.f * a0 * a2, numPixels);
+    juce::FloatVectorOperations::add(den, a0 * a0 + a1 * a1 + a2 * a2, numPixels);
+
+    auto* db = magnitudesDb.get();
+    for( int i = 0; i < numPixels; ++i )
+    {
+        db[i] += 10.f * std::log10(juce::jmax(num[i] / den[i], 1.0e-12f));
+    }
+}
+
+void ResponseCurveComponent::addLadderFilterMagnitudes(const CurveState& state)
+{
+    /*
+     this is an approximation of juce::dsp::LadderFilter using its analog prototype.
+     each of the 4 stages is a one-pole lowpass G = 1 / (1 + jx), where x = freq / cutoff.
+     the resonance feeds the 4th stage back into the input:
+         u = in * (1 + 4r * comp) / (1 + 4r * G^4)
+     and the mode picks a weighted sum of the stage outputs:
+         out = sum( A[n] * G^n * u )
+     the weights, comp and the resonance mapping are the same values LadderFilter::setMode()
+     and LadderFilter::setResonance() use.
+     the drive is a nonlinearity, so it's left out.
+     */
+    using Weights = std::array<float, 5>;
+    Weights A {};
+    float comp = 0.f;
+    switch( static_cast<juce::dsp::LadderFilterMode>(state.ladderMode) )
+    {
+        case juce::dsp::LadderFilterMode::LPF12: A = { 0.f, 0.f, 1.f, 0.f, 0.f };   comp = 0.5f; break;
+        case juce::dsp::LadderFilterMode::HPF12: A = { 1.f, -2.f, 1.f, 0.f, 0.f };  comp = 0.f;  break;
+        case juce::dsp::LadderFilterMode::BPF12: A = { 0.f, 0.f, -1.f, 1.f, 0.f };  comp = 0.5f; break;
+        case juce::dsp::LadderFilterMode::LPF24: A = { 0.f, 0.f, 0.f, 0.f, 1.f };   comp = 0.5f; break;
+        case juce::dsp::LadderFilterMode::HPF24: A = { 1.f, -4.f, 6.f, -4.f, 1.f }; comp = 0.f;  break;
+        case juce::dsp::LadderFilterMode::BPF24: A = { 0.f, 0.f, 1.f, -2.f, 1.f };  comp = 0.5f; break;
+    }
+
+    const auto resonance = juce::jmap(state.ladderResonance * 0.01f, 0.1f, 1.f);
+    const auto k = 4.f * resonance;
+    const auto inputScale = 1.f + k * comp;
+
+    auto* x = ratio.get();
+    juce::FloatVectorOperations::copyWithMultiply(x, frequencies.get(), 1.f / state.ladderCutoff, numPixels);
+
+    auto* db = magnitudesDb.get();
+    /*
+     straight-line complex math with no branches, so the compiler can vectorize this loop.
+     */
+    for( int i = 0; i < numPixels; ++i )
+    {
+        const auto d = 1.f / (1.f + x[i] * x[i]);
+        //G = (1 - jx) / (1 + x^2)
+        const auto gr = d;
+        const auto gi = -x[i] * d;
+
+        //G^2, G^3, G^4
+        const auto g2r = gr * gr - gi * gi,    g2i = 2.f * gr * gi;
+        const auto g3r = g2r * gr - g2i * gi,  g3i = g2r * gi + g2i * gr;
+        const auto g4r = g2r * g2r - g2i * g2i, g4i = 2.f * g2r * g2i;
+
+        //u = inputScale / (1 + k * G^4)
+        const auto denR = 1.f + k * g4r;
+        const auto denI = k * g4i;
+        const auto denMag = 1.f / (denR * denR + denI * denI);
+        const auto ur = inputScale * denR * denMag;
+        const auto ui = -inputScale * denI * denMag;
+
+        //sum of weighted stages
+        const auto sr = A[0] + A[1] * gr + A[2] * g2r + A[3] * g3r + A[4] * g4r;
+        const auto si =        A[1] * gi + A[2] * g2i + A[3] * g3i + A[4] * g4i;
+
+        const auto outR = sr * ur - si * ui;
+        const auto outI = sr * ui + si * ur;
+
+        db[i] += 10.f * std::log10(juce::jmax(outR * outR + outI * outI, 1.0e-12f));
+    }
+}
+
+void ResponseCurveComponent::rebuildPath(const CurveState& state)
+{
+    responseCurve.clear();
+    if( numPixels <= 0 || state.height <= 0 )
+        return;
+
+    auto area = getAnalysisArea().toFloat();
+    auto map = [&area](float db)
+    {
+        return juce::jmap(juce::jlimit(-maxDecibels, maxDecibels, db),
+                          -maxDecibels, maxDecibels,
+                          area.getBottom(), area.getY());
+    };
+
+    responseCurve.preallocateSpace(numPixels * 3);
+    responseCurve.startNewSubPath(area.getX(), map(magnitudesDb[0]));
+    for( int i = 1; i < numPixels; ++i )
+    {
+        responseCurve.lineTo(area.getX() + static_cast<float>(i), map(magnitudesDb[i]));
+    }
+}
+
+void ResponseCurveComponent::resized()
+{
+    update();
+}
+
+void ResponseCurveComponent::paint(juce::Graphics& g)
+{
+    if( cachedState.generalBypassed && cachedState.ladderBypassed )
+        return;
+
+    g.setColour(juce::Colours::white);
+    g.strokePath(responseCurve, juce::PathStrokeType(2.f));
+}
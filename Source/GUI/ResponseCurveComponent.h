@@ -0,0 +1,87 @@
+/*
+  ==============================================================================
+
+    ResponseCurveComponent.h
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../PluginProcessor.h"
+
+/*
+ Draws the combined magnitude response of the general filter and the ladder filter on top of the
+    spectrum analyzer.
+
+ Calling getMagnitudeForFrequency() once per pixel on every repaint is too slow when many editors are open.
+ Instead, the magnitude for every pixel column is computed in one batch over contiguous float arrays
+    (FloatVectorOperations + loops the compiler can vectorize), and the resulting path is cached.
+ The cache is keyed on the filter state (mode, frequency, Q, gain, cutoff, resonance, bypass, sample rate, width).
+ update() is called from the editor's timer and only recomputes when that key changes.
+ */
+struct ResponseCurveComponent : juce::Component
+{
+    ResponseCurveComponent(Project13AudioProcessor& p);
+
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+
+    /*
+     call this from the GUI timer.
+     returns true if the curve was recomputed.
+     */
+    bool update();
+
+private:
+    struct CurveState
+    {
+        int generalMode = -1;
+        float generalFreq = 0.f, generalQ = 0.f, generalGain = 0.f;
+        bool generalBypassed = true;
+
+        int ladderMode = -1;
+        float ladderCutoff = 0.f, ladderResonance = 0.f;
+        bool ladderBypassed = true;
+
+        double sampleRate = 0.0;
+        int width = 0, height = 0;
+
+        bool operator==(const CurveState& other) const;
+        bool operator!=(const CurveState& other) const { return !(*this == other); }
+    };
+
+    CurveState readState() const;
+
+    void rebuildFrequencyTables(const CurveState& state);
+    void addGeneralFilterMagnitudes(const CurveState& state);
+    void addLadderFilterMagnitudes(const CurveState& state);
+    void rebuildPath(const CurveState& state);
+
+    /*
+     mirrors the area SimpleMBComp::SpectrumAnalyzer draws its FFT data into,
+     so the response curve lines up with the analyzer's frequency axis.
+     */
+    juce::Rectangle<int> getAnalysisArea() const;
+
+    Project13AudioProcessor& processor;
+    CurveState cachedState;
+
+    /*
+     per-pixel tables. These are only rebuilt when the width or sample rate changes.
+     every array is numPixels long.
+     */
+    juce::HeapBlock<float> frequencies, cosW, cos2W;
+    /*
+     scratch buffers for the batch evaluation
+     */
+    juce::HeapBlock<float> numerator, denominator, ratio;
+    juce::HeapBlock<float> magnitudesDb;
+    int numPixels = 0;
+
+    juce::Path responseCurve;
+
+    static constexpr float maxDecibels = 24.f;
+};
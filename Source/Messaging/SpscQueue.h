@@ -0,0 +1,79 @@
+/*
+  ==============================================================================
+
+    SpscQueue.h
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/*
+ A bounded single-producer / single-consumer queue.
+
+ The storage is a fixed array, so the capacity is known at compile time and nothing is ever allocated.
+ push() and pop() are wait-free: one atomic load and one atomic store each.
+ When the queue is full, push() drops the message and counts it, so a stalled consumer shows up
+    in getNumOverflows() instead of blocking the producer.
+
+ T should be trivially copyable. messages are copied in and out by value.
+ */
+template<typename T, size_t Capacity>
+struct SpscQueue
+{
+    static_assert(juce::isPowerOfTwo(Capacity), "Capacity must be a power of 2");
+    static_assert(std::is_trivially_copyable<T>::value, "messages are copied with plain assignment");
+
+    //producer thread only
+    bool push(const T& message) noexcept
+    {
+        auto write = writeIndex.load(std::memory_order_relaxed);
+        if( write - readIndex.load(std::memory_order_acquire) == Capacity )
+        {
+            overflows.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        slots[write & mask] = message;
+        writeIndex.store(write + 1, std::memory_order_release);
+        return true;
+    }
+
+    //consumer thread only
+    bool pop(T& message) noexcept
+    {
+        auto read = readIndex.load(std::memory_order_relaxed);
+        if( read == writeIndex.load(std::memory_order_acquire) )
+            return false;
+
+        message = slots[read & mask];
+        readIndex.store(read + 1, std::memory_order_release);
+        return true;
+    }
+
+    //producer thread only. exact for the producer: the consumer can only make room.
+    bool isFull() const noexcept
+    {
+        return writeIndex.load(std::memory_order_relaxed) - readIndex.load(std::memory_order_acquire) == Capacity;
+    }
+
+    //any thread. only an estimate while the other side is running.
+    size_t getNumReady() const noexcept
+    {
+        return writeIndex.load(std::memory_order_acquire) - readIndex.load(std::memory_order_acquire);
+    }
+
+    static constexpr size_t getCapacity() noexcept { return Capacity; }
+    juce::uint32 getNumOverflows() const noexcept { return overflows.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr size_t mask = Capacity - 1;
+
+    std::array<T, Capacity> slots {};
+    //free-running counters. only the low bits are used as an index.
+    std::atomic<size_t> writeIndex { 0 }, readIndex { 0 };
+    std::atomic<juce::uint32> overflows { 0 };
+};
@@ -1,206 +1,249 @@
-/*
-  ==============================================================================
-
-    This file contains the basic framework code for a JUCE plugin editor.
-
-  ==============================================================================
-*/
-
-#pragma once
-
-#include <JuceHeader.h>
-#include "PluginProcessor.h"
-#include <LookAndFeel.h>
-#include <CustomButtons.h> // for PowerButton
-#include <SpectrumAnalyzer.h>
-
-template<typename ParamsContainer>
-static juce::AudioParameterBool* findBypassParam(const ParamsContainer& params)
-{
-    for( auto p : params )
-    {
-        if( auto bypass = dynamic_cast<juce::AudioParameterBool*>(p))
-        {
-            if( bypass->name.containsIgnoreCase("bypass") )
-            {
-                return bypass;
-            }
-        }
-    }
-    return nullptr;
-}
-
-/*
- https://forum.juce.com/t/draggabletabbedcomponent/13265/5?u=matkatmusic
- "You can create a subclass of TabbedButtonBar which is also a DragAndDropTarget.
-     And you can create custom tab buttons which allow themselves to be dragged."
- */
-
-struct ExtendedTabbedButtonBar : juce::TabbedButtonBar, juce::DragAndDropTarget, juce::DragAndDropContainer
-{
-    ExtendedTabbedButtonBar();
-    bool isInterestedInDragSource (const SourceDetails& dragSourceDetails) override;
-    /*
-     Drag-to-reorder is accomplished by the TabbedButtonBar being a dragAndDrop Target and a DragAndDropContainer,
-     and by listening to mouse events on each TabBarButton.
-     
-     the sequence flow is:
-     mouse on a tab. this starts the DragAndDropContainer responding to mouseDrag events.
-     first, itemDragEnter is called when the first mouseEvent happens.
-     as the mouse is moved, itemDragMove() is called. the tabBarButtons are constrained to the bounds
-     of the ExtendedTabbedButtonBar, so they'll never be dragged outside of it.
-     
-     itemDragMove() checks the x coordinate of the item being dragged and compares it with its neighbors.
-     tab indexes are swapped if a tab crosses over the middle of another tab.
-     */
-    void itemDragEnter (const SourceDetails& dragSourceDetails) override;
-    void itemDragMove (const SourceDetails& dragSourceDetails) override;
-    void itemDragExit (const SourceDetails& dragSourceDetails) override;
-    void itemDropped (const SourceDetails& dragSourceDetails) override;
-    
-    void mouseDown(const juce::MouseEvent& e) override;
-    
-    juce::TabBarButton* createTabButton (const juce::String& tabName, int tabIndex) override;
-    
-    struct Listener
-    {
-        virtual ~Listener() = default;
-        virtual void tabOrderChanged( Project13AudioProcessor::DSP_Order newOrder ) = 0;
-        virtual void selectedTabChanged(int newCurrentTabIndex) = 0;
-    };
-    
-    void addListener(Listener* l);
-    void removeListener(Listener* l);
-    
-    void currentTabChanged (int newCurrentTabIndex,
-                            const juce::String& newCurrentTabName) override;
-    void setTabColours();
-    
-private:
-    juce::TabBarButton* findDraggedItem(const SourceDetails& dragSourceDetails);
-    int findDraggedItemIndex(const SourceDetails& dragSourceDetails);
-    juce::Array<juce::TabBarButton*> getTabs();
-    bool reorderTabsAfterDrop();
-    juce::ScaledImage dragImage;
-    juce::ListenerList<Listener> listeners;
-    juce::Array<juce::TabBarButton*> tabs;
-    juce::Point<int> previousDraggedTabCenterPosition;
-};
-
-struct HorizontalConstrainer : juce::ComponentBoundsConstrainer
-{
-    HorizontalConstrainer(std::function<juce::Rectangle<int>()> confinerBoundsGetter,
-                          std::function<juce::Rectangle<int>()> confineeBoundsGetter);
-    
-    void checkBounds (juce::Rectangle<int>& bounds,
-                      const juce::Rectangle<int>& previousBounds,
-                      const juce::Rectangle<int>& limits,
-                      bool isStretchingTop,
-                      bool isStretchingLeft,
-                      bool isStretchingBottom,
-                      bool isStretchingRight) override;
-    
-private:
-    std::function<juce::Rectangle<int>()> boundsToConfineToGetter;
-    std::function<juce::Rectangle<int>()> boundsOfConfineeGetter;
-};
-
-struct ExtendedTabBarButton : juce::TabBarButton
-{
-    ExtendedTabBarButton(const juce::String& name, juce::TabbedButtonBar& owner,
-                         Project13AudioProcessor::DSP_Option dspOption);
-    juce::ComponentDragger dragger;
-    std::unique_ptr<HorizontalConstrainer> constrainer;
-    
-    void mouseDown (const juce::MouseEvent& e) override;
-
-    void mouseDrag (const juce::MouseEvent& e) override;
-    Project13AudioProcessor::DSP_Option getOption() const { return option; }
-    
-    int getBestTabLength (int depth) override;
-private:
-    Project13AudioProcessor::DSP_Option option;
-};
-struct RotarySliderWithLabels;
-struct DSP_Gui : juce::Component
-{
-    DSP_Gui(Project13AudioProcessor& p);
-    
-    void resized() override;
-    void paint( juce::Graphics& g ) override;
-    
-    void rebuildInterface( std::vector< juce::RangedAudioParameter* > params );
-    void toggleSliderEnablement(bool enabled);
-    
-    Project13AudioProcessor& processor;
-    std::vector< std::unique_ptr<RotarySliderWithLabels> > sliders;
-    std::vector< std::unique_ptr<juce::ComboBox> > comboBoxes;
-    std::vector< std::unique_ptr<juce::Button> > buttons;
-    std::vector< std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> > sliderAttachments;
-    std::vector< std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> > comboBoxAttachments;
-    std::vector< std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> > buttonAttachments;
-    
-    std::vector< juce::RangedAudioParameter* > currentParams;
-    
-};
-//==============================================================================
-struct PowerButtonWithParam : PowerButton
-{
-    PowerButtonWithParam(juce::AudioParameterBool* p);
-    void changeAttachment(juce::AudioParameterBool* p);
-    juce::AudioParameterBool* getParam() const { return param; }
-private:
-    std::unique_ptr<juce::ButtonParameterAttachment> attachment;
-    juce::AudioParameterBool* param;
-};
-//==============================================================================
-/**
-*/
-class Project13AudioProcessorEditor  : public juce::AudioProcessorEditor,
-ExtendedTabbedButtonBar::Listener,
-juce::Timer
-{
-public:
-    Project13AudioProcessorEditor (Project13AudioProcessor&);
-    ~Project13AudioProcessorEditor() override;
-
-    //==============================================================================
-    void paint (juce::Graphics&) override;
-    void resized() override;
-    
-    void tabOrderChanged( Project13AudioProcessor::DSP_Order newOrder ) override;
-    void selectedTabChanged(int newCurrentTabIndex) override;
-    
-    void timerCallback() override;
-private:
-    // This reference is provided as a quick way for your editor to
-    // access the processor object that created it.
-    Project13AudioProcessor& audioProcessor;
-    LookAndFeel lookAndFeel;
-    DSP_Gui dspGUI { audioProcessor };
-    ExtendedTabbedButtonBar tabbedComponent;
-    
-    SimpleMBComp::SpectrumAnalyzer analyzer
-    {
-        audioProcessor,
-        audioProcessor.leftSCSF,
-        audioProcessor.rightSCSF
-    };
-    
-    static constexpr int meterWidth = 80;
-    static constexpr int fontHeight = 24;
-    static constexpr int tickIndent = 8;
-    static constexpr int meterChanWidth = 24;
-    static constexpr int ioControlSize = 100;
-    
-    std::unique_ptr<RotarySliderWithLabels> inGainControl, outGainControl;
-    std::unique_ptr<juce::SliderParameterAttachment> inGainAttachment, outGainAttachment;
-    
-    std::unique_ptr<juce::ParameterAttachment> selectedTabAttachment;
-    
-    void addTabsFromDSPOrder(Project13AudioProcessor::DSP_Order);
-    void rebuildInterface();
-    void refreshDSPGUIControlEnablement( PowerButtonWithParam* button );
-    
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Project13AudioProcessorEditor)
-};
+/*
+  ==============================================================================
+
+    This file contains the basic framework code for a JUCE plugin editor.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+#include <LookAndFeel.h>
+#include <CustomButtons.h> // for PowerButton
+#include <SpectrumAnalyzer.h>
+#include "GUI/ResponseCurveComponent.h"
+#include "GUI/PresetBar.h"
+
+//draws the processor's memory estimate over the analyzer
+#ifndef PROJECT13_SHOW_MEMORY
+#define PROJECT13_SHOW_MEMORY JUCE_DEBUG
+#endif
+
+template<typename ParamsContainer>
+static juce::AudioParameterBool* findBypassParam(const ParamsContainer& params)
+{
+    for( auto p : params )
+    {
+        if( auto bypass = dynamic_cast<juce::AudioParameterBool*>(p))
+        {
+            if( bypass->name.containsIgnoreCase("bypass") )
+            {
+                return bypass;
+            }
+        }
+    }
+    return nullptr;
+}
+
+/*
+ https://forum.juce.com/t/draggabletabbedcomponent/13265/5?u=matkatmusic
+ "You can create a subclass of TabbedButtonBar which is also a DragAndDropTarget.
+     And you can create custom tab buttons which allow themselves to be dragged."
+ */
+
+struct ExtendedTabBarButton;
+
+struct ExtendedTabbedButtonBar : juce::TabbedButtonBar, juce::DragAndDropTarget, juce::DragAndDropContainer
+{
+    ExtendedTabbedButtonBar();
+    bool isInterestedInDragSource (const SourceDetails& dragSourceDetails) override;
+    /*
+     Drag-to-reorder is accomplished by the TabbedButtonBar being a dragAndDrop Target and a DragAndDropContainer,
+     and by listening to mouse events on each TabBarButton.
+     
+     the sequence flow is:
+     mouse on a tab. this starts the DragAndDropContainer responding to mouseDrag events.
+     first, itemDragEnter is called when the first mouseEvent happens.
+     as the mouse is moved, itemDragMove() is called. the tabBarButtons are constrained to the bounds
+     of the ExtendedTabbedButtonBar, so they'll never be dragged outside of it.
+     
+     itemDragMove() checks the x coordinate of the item being dragged and compares it with its neighbors.
+     tab indexes are swapped if a tab crosses over the middle of another tab.
+     */
+    void itemDragEnter (const SourceDetails& dragSourceDetails) override;
+    void itemDragMove (const SourceDetails& dragSourceDetails) override;
+    void itemDragExit (const SourceDetails& dragSourceDetails) override;
+    void itemDropped (const SourceDetails& dragSourceDetails) override;
+    
+    /*
+     a right click opens a menu that adds a module instance to the chain, or removes the tab that was clicked.
+     the chain keeps between 1 and maxChainSlots modules, and each instance shows up at most once.
+     */
+    void mouseDown(const juce::MouseEvent& e) override;
+    
+    juce::TabBarButton* createTabButton (const juce::String& tabName, int tabIndex) override;
+    
+    struct Listener
+    {
+        virtual ~Listener() = default;
+        virtual void tabOrderChanged( Project13AudioProcessor::DSP_Order newOrder ) = 0;
+        virtual void selectedTabChanged(int newCurrentTabIndex) = 0;
+    };
+    
+    void addListener(Listener* l);
+    void removeListener(Listener* l);
+    
+    void currentTabChanged (int newCurrentTabIndex,
+                            const juce::String& newCurrentTabName) override;
+    void setTabColours();
+    
+private:
+    juce::TabBarButton* findDraggedItem(const SourceDetails& dragSourceDetails);
+    int findDraggedItemIndex(const SourceDetails& dragSourceDetails);
+    juce::Array<juce::TabBarButton*> getTabs();
+    bool reorderTabsAfterDrop();
+    Project13AudioProcessor::DSP_Order getOrderFromTabs();
+    void notifyTabOrderChanged();
+    void showTabMenu(ExtendedTabBarButton* clickedTab);
+    void addModuleTab(Project13AudioProcessor::DSP_Option option, int index);
+    void removeModuleTab(int index);
+    juce::ScaledImage dragImage;
+    juce::ListenerList<Listener> listeners;
+    juce::Array<juce::TabBarButton*> tabs;
+    juce::Point<int> previousDraggedTabCenterPosition;
+};
+
+struct HorizontalConstrainer : juce::ComponentBoundsConstrainer
+{
+    HorizontalConstrainer(std::function<juce::Rectangle<int>()> confinerBoundsGetter,
+                          std::function<juce::Rectangle<int>()> confineeBoundsGetter);
+    
+    void checkBounds (juce::Rectangle<int>& bounds,
+                      const juce::Rectangle<int>& previousBounds,
+                      const juce::Rectangle<int>& limits,
+                      bool isStretchingTop,
+                      bool isStretchingLeft,
+                      bool isStretchingBottom,
+                      bool isStretchingRight) override;
+    
+private:
+    std::function<juce::Rectangle<int>()> boundsToConfineToGetter;
+    std::function<juce::Rectangle<int>()> boundsOfConfineeGetter;
+};
+
+struct ExtendedTabBarButton : juce::TabBarButton
+{
+    ExtendedTabBarButton(const juce::String& name, juce::TabbedButtonBar& owner,
+                         Project13AudioProcessor::DSP_Option dspOption);
+    juce::ComponentDragger dragger;
+    std::unique_ptr<HorizontalConstrainer> constrainer;
+    
+    void mouseDown (const juce::MouseEvent& e) override;
+
+    void mouseDrag (const juce::MouseEvent& e) override;
+    Project13AudioProcessor::DSP_Option getOption() const { return option; }
+    
+    int getBestTabLength (int depth) override;
+    
+    //the module's CPU badge. the text is the average, the colour follows the peak.
+    void setCpuLoad(float average, float peak);
+    void paintButton (juce::Graphics& g, bool shouldDrawButtonAsHighlighted, bool shouldDrawButtonAsDown) override;
+private:
+    Project13AudioProcessor::DSP_Option option;
+    float cpuAverage = -1.f, cpuPeak = 0.f;
+};
+struct RotarySliderWithLabels;
+struct DSP_Gui : juce::Component
+{
+    DSP_Gui(Project13AudioProcessor& p);
+    
+    void resized() override;
+    void paint( juce::Graphics& g ) override;
+    
+    void rebuildInterface( std::vector< juce::RangedAudioParameter* > params );
+    void toggleSliderEnablement(bool enabled);
+    
+    Project13AudioProcessor& processor;
+    std::vector< std::unique_ptr<RotarySliderWithLabels> > sliders;
+    std::vector< std::unique_ptr<juce::ComboBox> > comboBoxes;
+    std::vector< std::unique_ptr<juce::Button> > buttons;
+    std::vector< std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> > sliderAttachments;
+    std::vector< std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> > comboBoxAttachments;
+    std::vector< std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> > buttonAttachments;
+    
+    std::vector< juce::RangedAudioParameter* > currentParams;
+    
+};
+//==============================================================================
+struct PowerButtonWithParam : PowerButton
+{
+    PowerButtonWithParam(juce::AudioParameterBool* p);
+    void changeAttachment(juce::AudioParameterBool* p);
+    juce::AudioParameterBool* getParam() const { return param; }
+private:
+    std::unique_ptr<juce::ButtonParameterAttachment> attachment;
+    juce::AudioParameterBool* param;
+};
+//==============================================================================
+/**
+*/
+class Project13AudioProcessorEditor  : public juce::AudioProcessorEditor,
+ExtendedTabbedButtonBar::Listener,
+juce::Timer
+{
+public:
+    Project13AudioProcessorEditor (Project13AudioProcessor&);
+    ~Project13AudioProcessorEditor() override;
+
+    //==============================================================================
+    void paint (juce::Graphics&) override;
+    void paintOverChildren (juce::Graphics&) override;
+    void resized() override;
+    
+    void tabOrderChanged( Project13AudioProcessor::DSP_Order newOrder ) override;
+    void selectedTabChanged(int newCurrentTabIndex) override;
+    
+    void timerCallback() override;
+private:
+    // This reference is provided as a quick way for your editor to
+    // access the processor object that created it.
+    Project13AudioProcessor& audioProcessor;
+    LookAndFeel lookAndFeel;
+    PresetBar presetBar { audioProcessor };
+    DSP_Gui dspGUI { audioProcessor };
+    ExtendedTabbedButtonBar tabbedComponent;
+    
+    //the processor only allocates the analyzer fifos while an editor holds them
+    Project13AudioProcessor::AnalyzerFifos& analyzerFifos { audioProcessor.openAnalyzer() };
+    
+    SimpleMBComp::SpectrumAnalyzer analyzer
+    {
+        audioProcessor,
+        analyzerFifos.left,
+        analyzerFifos.right
+    };
+    
+    ResponseCurveComponent responseCurve { audioProcessor };
+    
+    static constexpr int meterWidth = 80;
+    static constexpr int fontHeight = 24;
+    static constexpr int tickIndent = 8;
+    static constexpr int meterChanWidth = 24;
+    static constexpr int ioControlSize = 100;
+    static constexpr int presetBarHeight = 30;
+    
+    std::unique_ptr<RotarySliderWithLabels> inGainControl, outGainControl;
+    std::unique_ptr<juce::SliderParameterAttachment> inGainAttachment, outGainAttachment;
+    
+    std::unique_ptr<juce::ParameterAttachment> selectedTabAttachment;
+    
+    //the latest MeterFrame event from the audio thread
+    Project13AudioProcessor::MeterFrame meters;
+    //the latest CpuFrame. hasCpu is false until the first one arrives.
+    Project13AudioProcessor::CpuFrame cpu;
+    bool hasCpu = false;
+    //the eco mode tier from the latest Quality event. nothing is shown at Full.
+    QualityGovernor::Tier qualityTier = QualityGovernor::Tier::Full;
+    void updateCpuBadges();
+    //the order the tabs currently show
+    Project13AudioProcessor::DSP_Order displayedOrder {};
+    
+    void addTabsFromDSPOrder(Project13AudioProcessor::DSP_Order);
+    void addBypassButton(juce::TabBarButton& tab, Project13AudioProcessor::DSP_Option option);
+    void rebuildInterface();
+    void refreshDSPGUIControlEnablement( PowerButtonWithParam* button );
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Project13AudioProcessorEditor)
+};
@@ -1,1179 +1,3128 @@
-/*
-  ==============================================================================
-
-    This file contains the basic framework code for a JUCE plugin processor.
-
-  ==============================================================================
-*/
-
-#include "PluginProcessor.h"
-#include "PluginEditor.h"
-
-auto getPhaserRateName() { return juce::String("Phaser RateHz"); }
-auto getPhaserCenterFreqName() { return juce::String("Phaser Center FreqHz"); }
-auto getPhaserDepthName() { return juce::String("Phaser Depth %" ); }
-auto getPhaserFeedbackName() { return juce::String("Phaser Feedback %" ); }
-auto getPhaserMixName() { return juce::String("Phaser Mix %"); }
-auto getPhaserBypassName() { return juce::String("Phaser Bypass"); }
-
-auto getChorusRateName() { return juce::String("Chorus RateHz"); }
-auto getChorusDepthName() { return juce::String("Chorus Depth %" ); }
-auto getChorusCenterDelayName() { return juce::String("Chorus Center Delay Ms"); }
-auto getChorusFeedbackName() { return juce::String("Chorus Feedback %" ); }
-auto getChorusMixName() { return juce::String("Chorus Mix %"); }
-auto getChorusBypassName() { return juce::String("Chorus Bypass"); }
-
-auto getOverdriveSaturationName() { return juce::String("OverDrive Saturation"); }
-auto getOverdriveBypassName() { return juce::String("Overdrive Bypass"); }
-
-auto getLadderFilterModeName() { return juce::String("Ladder Filter Mode"); }
-auto getLadderFilterCutoffName() { return juce::String("Ladder Filter Cutoff Hz %" ); }
-auto getLadderFilterResonanceName() { return juce::String("Ladder Filter Resonance"); }
-auto getLadderFilterDriveName() { return juce::String("Ladder Filter Drive" ); }
-auto getLadderFilterBypassName() { return juce::String("Ladder Filter Bypass"); }
-
-auto getLadderFilterChoices()
-{
-    return juce::StringArray
-    {
-        "LPF12",  // low-pass  12 dB/octave
-        "HPF12",  // high-pass 12 dB/octave
-        "BPF12",  // band-pass 12 dB/octave
-        "LPF24",  // low-pass  24 dB/octave
-        "HPF24",  // high-pass 24 dB/octave
-        "BPF24"   // band-pass 24 dB/octave
-    };
-}
-
-auto getGeneralFilterChoices()
-{
-    return juce::StringArray
-    {
-        "Peak",
-        "Bandpass",
-        "Notch",
-        "Allpass",
-    };
-}
-
-auto getGeneralFilterModeName() { return juce::String("General Filter Mode"); }
-auto getGeneralFilterFreqName() { return juce::String("General Filter Freq hz"); }
-auto getGeneralFilterQualityName() { return juce::String("General Filter Quality"); }
-auto getGeneralFilterGainName() { return juce::String("General Filter Gain"); }
-auto getGeneralFilterBypassName() { return juce::String("General Filter Bypass"); }
-
-auto getSelectedTabName() { return juce::String("Selected Tab"); }
-
-auto getInputGainName() { return juce::String( "Input Gain dB" ); }
-auto getOutputGainName() { return juce::String( "Output Gain dB "); }
-//==============================================================================
-Project13AudioProcessor::Project13AudioProcessor()
-#ifndef JucePlugin_PreferredChannelConfigurations
-     : AudioProcessor (BusesProperties()
-                     #if ! JucePlugin_IsMidiEffect
-                      #if ! JucePlugin_IsSynth
-                       .withInput  ("Input",  juce::AudioChannelSet::stereo(), true)
-                      #endif
-                       .withOutput ("Output", juce::AudioChannelSet::stereo(), true)
-                     #endif
-                       )
-#endif
-{
-    for( size_t i = 0; i < static_cast<size_t>(DSP_Option::END_OF_LIST); ++i )
-    {
-        dspOrder[i] = static_cast<DSP_Option>(i);
-    }
-    
-    restoreDspOrderFifo.push(dspOrder);
-    
-    auto floatParams = std::array
-    {
-        &phaserRateHz,
-        &phaserCenterFreqHz,
-        &phaserDepthPercent,
-        &phaserFeedbackPercent,
-        &phaserMixPercent,
-        
-        &chorusRateHz,
-        &chorusDepthPercent,
-        &chorusCenterDelayMs,
-        &chorusFeedbackPercent,
-        &chorusMixPercent,
-        
-        &overdriveSaturation,
-        
-        &ladderFilterCutoffHz,
-        &ladderFilterResonance,
-        &ladderFilterDrive,
-        
-        &generalFilterFreqHz,
-        &generalFilterQuality,
-        &generalFilterGain,
-        
-        &inputGain,
-        &outputGain,
-        
-    };
-    
-    auto floatNameFuncs = std::array
-    {
-        &getPhaserRateName,
-        &getPhaserCenterFreqName,
-        &getPhaserDepthName,
-        &getPhaserFeedbackName,
-        &getPhaserMixName,
-        
-        &getChorusRateName,
-        &getChorusDepthName,
-        &getChorusCenterDelayName,
-        &getChorusFeedbackName,
-        &getChorusMixName,
-        
-        &getOverdriveSaturationName,
-        
-        &getLadderFilterCutoffName,
-        &getLadderFilterResonanceName,
-        &getLadderFilterDriveName,
-        
-        &getGeneralFilterFreqName,
-        &getGeneralFilterQualityName,
-        &getGeneralFilterGainName,
-        
-        &getInputGainName,
-        &getOutputGainName,
-    };
-    
-//    for( size_t i = 0; i < floatParams.size(); ++i )
-//    {
-//        auto ptrToParamPtr = floatParams[i];
-//        *ptrToParamPtr = dynamic_cast<juce::AudioParameterFloat*>(apvts.getParameter(
-//             floatNameFuncs[i]() ));
-//        jassert( *ptrToParamPtr != nullptr );
-//    }
-    
-    initCachedParams<juce::AudioParameterFloat*>(floatParams, floatNameFuncs);
-    
-    auto choiceParams = std::array
-    {
-        &ladderFilterMode,
-        &generalFilterMode,
-    };
-    
-    auto choiceNameFuncs = std::array
-    {
-        &getLadderFilterModeName,
-        &getGeneralFilterModeName,
-    };
-  
-//    for( size_t i = 0; i < choiceParams.size(); ++i )
-//    {
-//        auto ptrToParamPtr = choiceParams[i];
-//        *ptrToParamPtr = dynamic_cast<juce::AudioParameterChoice*>(apvts.getParameter(
-//             choiceNameFuncs[i]() ));
-//        jassert( *ptrToParamPtr != nullptr );
-//    }
-    
-    initCachedParams<juce::AudioParameterChoice*>(choiceParams, choiceNameFuncs);
-    
-    auto bypassParams = std::array
-    {
-        &phaserBypass,
-        &chorusBypass,
-        &overdriveBypass,
-        &ladderFilterBypass,
-        &generalFilterBypass,
-    };
-    
-    auto bypassNameFuncs = std::array
-    {
-        &getPhaserBypassName,
-        &getChorusBypassName,
-        &getOverdriveBypassName,
-        &getLadderFilterBypassName,
-        &getGeneralFilterBypassName,
-    };
-    
-//    for( size_t i = 0; i < bypassParams.size(); ++i )
-//    {
-//        auto ptrToParamPtr = bypassParams[i];
-//        *ptrToParamPtr =
-//        dynamic_cast<juce::AudioParameterBool*>(apvts.getParameter(bypassNameFuncs[i]()));
-//        jassert( *ptrToParamPtr != nullptr );
-//    }
-  
-    initCachedParams<juce::AudioParameterBool*>(bypassParams, bypassNameFuncs);
-    
-    auto intParams = std::array
-    {
-        &selectedTab
-    };
-    
-    auto intFuncs = std::array
-    {
-        &getSelectedTabName
-    };
-    
-    initCachedParams<juce::AudioParameterInt*>(intParams, intFuncs);
-    
-}
-
-Project13AudioProcessor::~Project13AudioProcessor()
-{
-}
-
-//==============================================================================
-const juce::String Project13AudioProcessor::getName() const
-{
-    return JucePlugin_Name;
-}
-
-bool Project13AudioProcessor::acceptsMidi() const
-{
-   #if JucePlugin_WantsMidiInput
-    return true;
-   #else
-    return false;
-   #endif
-}
-
-bool Project13AudioProcessor::producesMidi() const
-{
-   #if JucePlugin_ProducesMidiOutput
-    return true;
-   #else
-    return false;
-   #endif
-}
-
-bool Project13AudioProcessor::isMidiEffect() const
-{
-   #if JucePlugin_IsMidiEffect
-    return true;
-   #else
-    return false;
-   #endif
-}
-
-double Project13AudioProcessor::getTailLengthSeconds() const
-{
-    return 0.0;
-}
-
-int Project13AudioProcessor::getNumPrograms()
-{
-    return 1;   // NB: some hosts don't cope very well if you tell them there are 0 programs,
-                // so this should be at least 1, even if you're not really implementing programs.
-}
-
-int Project13AudioProcessor::getCurrentProgram()
-{
-    return 0;
-}
-
-void Project13AudioProcessor::setCurrentProgram (int index)
-{
-}
-
-const juce::String Project13AudioProcessor::getProgramName (int index)
-{
-    return {};
-}
-
-void Project13AudioProcessor::changeProgramName (int index, const juce::String& newName)
-{
-}
-
-//==============================================================================
-void Project13AudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
-{
-    // Use this method as the place to do any pre-playback
-    // initialisation that you need..
-    
-    juce::dsp::ProcessSpec spec;
-    spec.sampleRate = sampleRate;
-    spec.maximumBlockSize = samplesPerBlock;
-    spec.numChannels = 1;
-    
-    leftChannel.prepare(spec);
-    rightChannel.prepare(spec);
-    
-    for( auto smoother : getSmoothers() )
-    {
-        smoother->reset(sampleRate, 0.005);
-    }
-    
-    updateSmoothersFromParams(1, SmootherUpdateMode::initialize);
-    
-    spec.numChannels = getTotalNumInputChannels();
-    
-    inputGainDSP.prepare(spec);
-    outputGainDSP.prepare(spec);
-    
-    leftSCSF.prepare(samplesPerBlock);
-    rightSCSF.prepare(samplesPerBlock);
-}
-
-void Project13AudioProcessor::updateSmoothersFromParams(int numSamplesToSkip, SmootherUpdateMode init)
-{
-    auto paramsNeedingSmoothing = std::vector
-    {
-        phaserRateHz,
-        phaserCenterFreqHz,
-        phaserDepthPercent,
-        phaserFeedbackPercent,
-        phaserMixPercent,
-        chorusRateHz,
-        chorusDepthPercent,
-        chorusCenterDelayMs,
-        chorusFeedbackPercent,
-        chorusMixPercent,
-        overdriveSaturation,
-        ladderFilterCutoffHz,
-        ladderFilterResonance,
-        ladderFilterDrive,
-        generalFilterFreqHz,
-        generalFilterQuality,
-        generalFilterGain,
-        inputGain,
-        outputGain,
-    };
-    
-    auto smoothers = getSmoothers();
-    jassert( smoothers.size() == paramsNeedingSmoothing.size() );
-    // hitting this jassert means our lists are out of date.
-    
-    for( size_t i = 0; i < smoothers.size(); ++i )
-    {
-        auto smoother = smoothers[i];
-        auto param = paramsNeedingSmoothing[i];
-        
-        if( init == SmootherUpdateMode::initialize )
-            smoother->setCurrentAndTargetValue( param->get() );
-        else
-            smoother->setTargetValue(param->get() );
-        
-        smoother->skip(numSamplesToSkip);
-    }
-}
-
-std::vector<juce::SmoothedValue<float>*> Project13AudioProcessor::getSmoothers()
-{
-    auto smoothers = std::vector
-    {
-        &phaserRateHzSmoother,
-        &phaserCenterFreqHzSmoother,
-        &phaserDepthPercentSmoother,
-        &phaserFeedbackPercentSmoother,
-        &phaserMixPercentSmoother,
-        &chorusRateHzSmoother,
-        &chorusDepthPercentSmoother,
-        &chorusCenterDelayMsSmoother,
-        &chorusFeedbackPercentSmoother,
-        &chorusMixPercentSmoother,
-        &overdriveSaturationSmoother,
-        &ladderFilterCutoffHzSmoother,
-        &ladderFilterResonanceSmoother,
-        &ladderFilterDriveSmoother,
-        &generalFilterFreqHzSmoother,
-        &generalFilterQualitySmoother,
-        &generalFilterGainSmoother,
-        &inputGainSmoother,
-        &outputGainSmoother
-    };
-    
-    return smoothers;
-    
-}
-
-void Project13AudioProcessor::MonoChannelDSP::updateDSPFromParams()
-{
-    phaser.dsp.setRate( p.phaserRateHzSmoother.getCurrentValue() );
-    phaser.dsp.setCentreFrequency( p.phaserCenterFreqHzSmoother.getCurrentValue() );
-    phaser.dsp.setDepth( p.phaserDepthPercentSmoother.getCurrentValue() * 0.01f );
-    phaser.dsp.setFeedback( p.phaserFeedbackPercentSmoother.getCurrentValue() * 0.01f );
-    phaser.dsp.setMix( p.phaserMixPercentSmoother.getCurrentValue() * 0.01f );
-    
-    chorus.dsp.setRate( p.chorusRateHzSmoother.getCurrentValue() );
-    chorus.dsp.setDepth( p.chorusDepthPercentSmoother.getCurrentValue() * 0.01f );
-    chorus.dsp.setCentreDelay( p.chorusCenterDelayMsSmoother.getCurrentValue() );
-    chorus.dsp.setFeedback( p.chorusFeedbackPercentSmoother.getCurrentValue() * 0.01f );
-    chorus.dsp.setMix( p.chorusMixPercentSmoother.getCurrentValue() * 0.01f );
-    
-    overdrive.dsp.setDrive( p.overdriveSaturationSmoother.getCurrentValue() );
-    
-    ladderFilter.dsp.setMode( static_cast<juce::dsp::LadderFilterMode>( p.ladderFilterMode->getIndex()));
-    ladderFilter.dsp.setCutoffFrequencyHz( p.ladderFilterCutoffHzSmoother.getCurrentValue() );
-    ladderFilter.dsp.setResonance( p.ladderFilterResonanceSmoother.getCurrentValue() * 0.01f );
-    ladderFilter.dsp.setDrive( p.ladderFilterDriveSmoother.getCurrentValue() );
-    
-    //TODO: update general filter coefficients here
-    auto sampleRate = p.getSampleRate();
-    //update generalFilter Coefficients
-    //choices:: peak, bandpass, notch, allpass
-    auto genMode = p.generalFilterMode->getIndex();
-    auto genHz = p.generalFilterFreqHz->get();
-    auto genQ = p.generalFilterQuality->get();
-    auto genGain = p.generalFilterGain->get();
-    
-    bool filterChanged = false;
-    filterChanged |= (filterFreq != genHz);
-    filterChanged |= (filterQ != genQ);
-    filterChanged |= (filterGain != genGain);
-    
-    auto updatedMode = static_cast<GeneralFilterMode>(genMode);
-    filterChanged |= (filterMode != updatedMode);
-    
-    if( filterChanged )
-    {
-        filterMode = updatedMode;
-        filterFreq = genHz;
-        filterQ = genQ;
-        filterGain = genGain;
-        
-        juce::dsp::IIR::Coefficients<float>::Ptr coefficients;
-        switch(filterMode)
-        {
-            case GeneralFilterMode::Peak:
-            {
-                coefficients = juce::dsp::IIR::Coefficients<float>::makePeakFilter(sampleRate, filterFreq, filterQ, juce::Decibels::decibelsToGain(filterGain));
-                break;
-            }
-            case GeneralFilterMode::Bandpass:
-            {
-                coefficients = juce::dsp::IIR::Coefficients<float>::makeBandPass(sampleRate, filterFreq, filterQ);
-                
-                break;
-            }
-            case GeneralFilterMode::Notch:
-            {
-                coefficients = juce::dsp::IIR::Coefficients<float>::makeNotch(sampleRate, filterFreq, filterQ);
-                
-                break;
-            }
-            case GeneralFilterMode::Allpass:
-            {
-                coefficients = juce::dsp::IIR::Coefficients<float>::makeAllPass(sampleRate, filterFreq, filterQ);
-                
-                break;
-            }
-            case GeneralFilterMode::END_OF_LIST:
-            {
-                jassertfalse;
-                break;
-            }
-        }
-        
-        if( coefficients != nullptr )
-        {
-//            if( generalFilter.dsp.coefficients->coefficients.size() != coefficients->coefficients.size() )
-//            {
-//                jassertfalse;
-//            }
-            
-            *generalFilter.dsp.coefficients = *coefficients;
-            generalFilter.reset();
-        }
-    }
-}
-
-void Project13AudioProcessor::MonoChannelDSP::prepare(const juce::dsp::ProcessSpec &spec)
-{
-    jassert(spec.numChannels == 1);
-    std::vector<juce::dsp::ProcessorBase*> dsp
-    {
-        &phaser,
-        &chorus,
-        &overdrive,
-        &ladderFilter,
-        &generalFilter
-    };
-    
-    for( auto p : dsp )
-    {
-        p->prepare(spec);
-        p->reset();
-    }
-    
-    overdrive.dsp.setCutoffFrequencyHz(20000.f);
-}
-
-void Project13AudioProcessor::releaseResources()
-{
-    // When playback stops, you can use this as an opportunity to free up any
-    // spare memory, etc.
-}
-
-#ifndef JucePlugin_PreferredChannelConfigurations
-bool Project13AudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts) const
-{
-  #if JucePlugin_IsMidiEffect
-    juce::ignoreUnused (layouts);
-    return true;
-  #else
-    // This is the place where you check if the layout is supported.
-    // In this template code we only support mono or stereo.
-    // Some plugin hosts, such as certain GarageBand versions, will only
-    // load plugins that support stereo bus layouts.
-    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
-     && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
-        return false;
-
-    // This checks if the input layout matches the output layout
-   #if ! JucePlugin_IsSynth
-    if (layouts.getMainOutputChannelSet() != layouts.getMainInputChannelSet())
-        return false;
-   #endif
-
-    return true;
-  #endif
-}
-#endif
-
-juce::AudioProcessorValueTreeState::ParameterLayout
-    Project13AudioProcessor::createParameterLayout()
-{
-        juce::AudioProcessorValueTreeState::ParameterLayout layout;
-        
-//        name = nameFunction();
-//        layout.add( std::make_unique<juce::AudioParameterFloat>(
-//            juce::ParameterID { name, versionHint },
-//            name,
-//            parameterRange,
-//            defaultValue,
-//            unitSuffix
-//        );
-        
-    const int versionHint = 1;
-    /*
-     Phaser:
-     Rate: hz
-     Depth: 0 to 1
-     Center Freq: hz
-     Feedback: -1 to +1
-     Mix: 0 to 1
-    */
-    
-    auto name = getInputGainName();
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-            juce::ParameterID{name, versionHint},
-            name,
-            juce::NormalisableRange<float>(-18.f, 18.f, 0.1f, 1.f),
-            0.f,
-            "dB"));
-        
-    name = getOutputGainName();
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-            juce::ParameterID{name, versionHint},
-            name,
-            juce::NormalisableRange<float>(-18.f, 18.f, 0.1f, 1.f),
-            0.f,
-            "dB"));
-        
-    name = getPhaserRateName();
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-          juce::ParameterID{name, versionHint},
-          name,
-          juce::NormalisableRange<float>(0.01f, 2.f, 0.01f, 1.f),
-          0.2f,
-          "Hz"));
-        
-    //phaser depth: 0 - 100
-    name = getPhaserDepthName();
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-          juce::ParameterID{name, versionHint},
-          name,
-          juce::NormalisableRange<float>(0.0f, 100.f, 0.1f, 1.f),
-          5.f,
-          "%"));
-        
-    //phaser center freq: audio hz
-    name = getPhaserCenterFreqName();
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-          juce::ParameterID{name, versionHint},
-          name,
-          juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 1.f),
-          1000.f,
-          "Hz"));
-          
-    //phaser feedback: -1 to 1
-    name = getPhaserFeedbackName();
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-          juce::ParameterID{name, versionHint},
-          name,
-          juce::NormalisableRange<float>(-100.f, 100.f, 0.1f, 1.f),
-          0.0f,
-          "Hz"));
-        
-    //phaser mix: 0 - 1
-    name = getPhaserMixName();
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-          juce::ParameterID{name, versionHint},
-          name,
-          juce::NormalisableRange<float>(0.0f, 100.f, 0.1f, 1.f),
-          5.f,
-          "%"));
-    name = getPhaserBypassName();
-        layout.add(std::make_unique<juce::AudioParameterBool>(juce::ParameterID{name, versionHint},
-              name, false));
-        
-    /*
-     Chorus:
-     Rate: hz
-     Depth: 0 to 1
-     Center delay: ms (1 to 100)
-     Feedback: -1 to +1
-     Mix: 0 to 1
-    */
-        
-    //Rate: Hz
-    name = getChorusRateName();
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-          juce::ParameterID{name, versionHint},
-          name,
-          juce::NormalisableRange<float>(0.01f, 100.f, 0.01f, 1.f),
-          0.2f,
-          "Hz"));
-    
-    //Depth: 0 to 1
-    name = getChorusDepthName();
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-          juce::ParameterID{name, versionHint},
-          name,
-          juce::NormalisableRange<float>(0.0f, 100.f, 0.1f, 1.f),
-          5.f,
-          "%"));
-        
-    //Center Delay: milliseconds (1 to 100)
-    name = getChorusCenterDelayName();
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-          juce::ParameterID{name, versionHint},
-          name,
-          juce::NormalisableRange<float>(1.f, 100.f, 0.1f, 1.f),
-          7.f,
-          "ms"));
-        
-    //Feedback: -1 to 1
-    name = getChorusFeedbackName();
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-          juce::ParameterID{name, versionHint},
-          name,
-          juce::NormalisableRange<float>(-100.f, 100.f, 0.1f, 1.f),
-          0.0f,
-          "%"));
-        
-    //Mix: 0 to 1
-    name = getChorusMixName();
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-          juce::ParameterID{name, versionHint},
-          name,
-          juce::NormalisableRange<float>(0.0f, 100.f, 0.1f, 1.f),
-          5.f,
-          "%"));
-    name = getChorusBypassName();
-        layout.add(std::make_unique<juce::AudioParameterBool>(juce::ParameterID{name, versionHint},
-              name, false));
-        
-    /*
-     overdrive
-     uses the drive portion of the ladder filter class for now
-     drive: 1-100
-    */
-    //drive: 1-100
-    name = getOverdriveSaturationName();
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-          juce::ParameterID{name, versionHint},
-          name,
-          juce::NormalisableRange<float>(1.f, 100.f, 0.1f, 1.f),
-          1.f,
-          ""));
-    name = getOverdriveBypassName();
-        layout.add(std::make_unique<juce::AudioParameterBool>(juce::ParameterID{name, versionHint},
-              name, false));
-
-    /*
-     ladder filter
-     mode: LadderFilterMode enum (int)
-     cutoff: hz
-     resonance: 0 to 1
-     drive: 1 - 100
-     */
-        
-    name = getLadderFilterModeName();
-    auto choices = getLadderFilterChoices();
-    layout.add(std::make_unique<juce::AudioParameterChoice>(
-        juce::ParameterID{name, versionHint}, name, choices, 0));
-        
-    name = getLadderFilterCutoffName();
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-          juce::ParameterID{name, versionHint},
-          name,
-          juce::NormalisableRange<float>(20.f, 20000.f, 0.1f, 1.f),
-          20000.f,
-          "Hz"));
-        
-    name = getLadderFilterResonanceName();
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-          juce::ParameterID{name, versionHint},
-          name,
-          juce::NormalisableRange<float>(0.f, 100.f, 0.1f, 1.f),
-          0.f,
-          "%"));
-        
-    name = getLadderFilterDriveName();
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-          juce::ParameterID{name, versionHint},
-          name,
-          juce::NormalisableRange<float>(1.f, 100.f, 0.1f, 1.f),
-          1.f,
-          ""));
-    name = getLadderFilterBypassName();
-        layout.add(std::make_unique<juce::AudioParameterBool>(juce::ParameterID{name, versionHint},
-              name, false));
-        
-    /*
-     general filter: https://docs.juce.com/develop/sructdsp_1_1IIR_1_1Coefficients.html
-     Mode: Peak, Bandpass, Notch, Allpass,
-     Freq: 20hz - 20,000hz in 1hz steps
-     Q: 0.1 - 10 in 0.05 steps
-     Gain: -24db to +24db in 0.5db increments
-     */
-    //mode
-    name = getGeneralFilterModeName();
-    choices = getGeneralFilterChoices();
-    layout.add(std::make_unique<juce::AudioParameterChoice>(
-         juce::ParameterID{name, versionHint}, name, choices, 0));
-    //freq: 20 - 20Khz in 1hz steps
-    name = getGeneralFilterFreqName();
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-          juce::ParameterID{name, versionHint},
-          name,
-          juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 1.f),
-          750.f,
-          "Hz"));
-   //quality: 0.01 - 100 in 0.01 steps
-    name = getGeneralFilterQualityName();
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-          juce::ParameterID{name, versionHint},
-          name,
-          juce::NormalisableRange<float>(0.01f, 100.f, 0.01f, 1.f),
-          0.72f,
-          ""));
-    //gain: -24db to +24db in 0.5db increments
-    name = getGeneralFilterGainName();
-    layout.add(std::make_unique<juce::AudioParameterFloat>(
-          juce::ParameterID{name, versionHint},
-          name,
-          juce::NormalisableRange<float>(-24.f, 24.f, 0.5f, 1.f),
-          0.f,
-          "dB"));
-    name = getGeneralFilterBypassName();
-        layout.add(std::make_unique<juce::AudioParameterBool>(juce::ParameterID{name, versionHint},
-              name, false));
-        
-    name = getSelectedTabName();
-    layout.add(std::make_unique<juce::AudioParameterInt>(juce::ParameterID{name, versionHint},
-                                                         name,
-                                                         0,
-                                                         static_cast<int>(DSP_Option::END_OF_LIST) - 1,
-                                                         static_cast<int>(DSP_Option::Chorus)));
-        
-    return layout;
-}
-
-std::vector< juce::RangedAudioParameter* > Project13AudioProcessor::getParamsForOption(DSP_Option option)
-{
-    switch( option )
-    {
-        case DSP_Option::Phase:
-        {
-            return
-            {
-                phaserRateHz,
-                phaserCenterFreqHz,
-                phaserDepthPercent,
-                phaserFeedbackPercent,
-                phaserMixPercent,
-                phaserBypass,
-            };
-        }
-        case DSP_Option::Chorus:
-        {
-            return
-            {
-                chorusRateHz,
-                chorusDepthPercent,
-                chorusCenterDelayMs,
-                chorusFeedbackPercent,
-                chorusMixPercent,
-                chorusBypass,
-            };
-        }
-        case DSP_Option::Overdrive:
-        {
-            return
-            {
-                overdriveSaturation,
-                overdriveBypass,
-            };
-        }
-        case DSP_Option::LadderFilter:
-        {
-            return
-            {
-                ladderFilterMode,
-                ladderFilterCutoffHz,
-                ladderFilterResonance,
-                ladderFilterDrive,
-                ladderFilterBypass,
-            };
-        }
-        case DSP_Option::GeneralFilter:
-        {
-            return
-            {
-                generalFilterMode,
-                generalFilterFreqHz,
-                generalFilterQuality,
-                generalFilterGain,
-                generalFilterBypass,
-            };
-        }
-        case DSP_Option::END_OF_LIST:
-            break;
-    }
-    
-    jassertfalse;
-    return { };
-        
-}
-
-void Project13AudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
-    juce::MidiBuffer& midiMessages)
-{
-    juce::ScopedNoDenormals noDenormals;
-    auto totalNumInputChannels  = getTotalNumInputChannels();
-    auto totalNumOutputChannels = getTotalNumOutputChannels();
-    
-    // In case we have more outputs than inputs, this code clears any output
-    // channels that didn't contain input data, (because these aren't
-    // guaranteed to be empty - they may contain garbage).
-    // This is here to avoid people getting screaming feedback
-    // when they first compile a plugin, but obviously you don't need to keep
-    // this code if your algorithm always overwrites all the output channels.
-    
-    for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
-        buffer.clear (i, 0, buffer.getNumSamples());
-    
-    //[DONE]: add APVTS
-    //[DONE]: create audio parameters for all dsp choices
-    //[DONE]: update DSP here from audio parameters
-    //[DONE]: bypass params for each DSP element
-    //[DONE]: update general filter coefficients
-    //[DONE]: add smoothers for all param updates
-    //[DONE]: save/load settings
-    //[DONE]: save/load DSP order
-    //[DONE]: Bypass DSP
-    //[DONE]: filters are mono, not stereo.
-    //[DONE]: prepare all DSP
-    //[DONE]: Drag-To_Reorder GUI
-    //[DONE]: snap dropped tabs to the correct position
-    //[DONE]: hide dragged tab image or stop dragging the tab and constrain dragged image to x axis only
-    //[DONE]: restore tabs in GUI when loading settings
-    //[DONE]: replace vertical sliders with SimpleMBComp rotary Sliders
-    //[DONE]: replace bypass buttons with SimpleMBComp combobox
-    //[DONE]: restore tab order when window opens
-    //[DONE]: restore selected tab when window opens
-    //[DONE]: Restore tab order when window opens first time (after quit)
-    //[DONE]: Restore tabs when closing/opening window (no quit)
-    //[DONE]: Restore selected tab when closing/opening window (no quit)
-    //[DONE]: replace Comboboxes with SimpleMBComp combobox
-    //[DONE]: mouse-down on tab (during drag should change DSP_Gui
-    //[DONE]: make selected tab more obvious
-    //[DONE]: restore selected tab when window opens
-    //[DONE]: bypass button should toggle RotarySlider enablement
-    //[DONE]: fix graphic issue when dragging tab over bypass button
-    //[DONE]: i/o gain controls
-    //[DONE]: add bypass button to tabs
-    //[DONE]: Added Spectrum Analyzer from SimpleMBComp
-    //[DONE]: GUI design for each DSP instance?
-    //[DONE]: metering
-    //TODO: save/load presets [BONUS]
-    //TODO: wet/dry knob [BONUS]
-    //TODO: mono & stereo versions [mono is BONUS]
-    //TODO: modulators [BONUS]
-    //TODO: thread-safe filter updating [BONUS]
-    //TODO: pre/post filtering [BONUS]
-    //TODO: delay module [BONUS]
-    
-    
-    leftChannel.updateDSPFromParams();
-    rightChannel.updateDSPFromParams();
-    
-    //temp instance to pull into
-    auto newDSPOrder = DSP_Order();
-    
-    //try to pull
-    while( dspOrderFifo.pull(newDSPOrder) )
-    {
-#if VERIFY_BYPASS_FUNCTIONALITY
-        jassertfalse;
-#endif
-    }
-    
-    //if you pulled, replace dspOrder;
-    if( newDSPOrder != DSP_Order() )
-        dspOrder = newDSPOrder;
-    
-    /*
-     when the plugin is first loaded, if the gui os closed and reopened, the restoreDspOrderFifo is empty.
-     the restoreDspOrderFifo is only populated when setStateInformation is called.
-     an atomic flag is used by the editor to signal that it needs the latest dspOrder
-     here is where we check that flag and push a copy of dspOrder into the restoreDspOrderFifo for the GUI
-     to retrieve in its timer callback.
-     */
-    
-    if( guiNeedsLatestDspOrder.compareAndSetBool(false, true) )
-    {
-        restoreDspOrderFifo.push(dspOrder);
-    }
-   
-    // OLD CODE:
-    // auto block = juce::dsp::AudioBlock<float>(buffer);
-    // leftChannel.process(block.getSingleChannelBlock(0), dspOrder);
-    // rightChannel.process(block.getSingleChannelBlock(1), dspOrder);
-    
-    auto block = juce::dsp::AudioBlock<float>(buffer);
-    auto preCtx = juce::dsp::ProcessContextReplacing<float>(block);
-    
-    inputGainSmoother.setTargetValue( inputGain->get());
-    outputGainSmoother.setTargetValue( outputGain->get());
-    inputGainDSP.setGainDecibels(inputGainSmoother.getNextValue());
-    inputGainDSP.process(preCtx);
-    
-    /*
-     process max 64 samples at a time
-     */
-    const auto numSamples = buffer.getNumSamples(); // (1)
-    auto samplesRemaining = numSamples;
-    auto maxSamplesToProcess = juce::jmin(samplesRemaining, 64); // (2)
-    
-    leftPreRMS.set( buffer.getRMSLevel(0, 0, numSamples) );
-    rightPreRMS.set( buffer.getRMSLevel(1, 0, numSamples) );
-    
-    size_t startSample = 0; // (10)
-    while( samplesRemaining > 0 ) // (3)
-    {
-        /*
-         figure out how many samples to actually process.
-         i.e., you might have a buffer size of 72.
-         The first time through this loop samplesToProcess will be 64,
-             because maxSamplesToProcess is set to 64, and the samplesRemaining is 72.
-         the 2nd time this loop runs, samplesToProcess will be 8,
-             because the previous loop consumed 64 of the 72 samples.
-         */
-        
-        auto samplesToProcess = juce::jmin(samplesRemaining, maxSamplesToProcess); // (4)
-        //advance each smoother 'samplesToProcess' samples
-        updateSmoothersFromParams(samplesToProcess, SmootherUpdateMode::liveInRealtime); // (5)
-        
-        //update the DSP
-        leftChannel.updateDSPFromParams(); // (6)
-        rightChannel.updateDSPFromParams();
-        
-        //create a sub block from the buffer, and
-        auto subBlock = block.getSubBlock(startSample, samplesToProcess); // (7)
-        
-        //now process
-        leftChannel.process(subBlock.getSingleChannelBlock(0), dspOrder); // (8)
-        rightChannel.process(subBlock.getSingleChannelBlock(1), dspOrder);
-        
-        startSample += samplesToProcess; // (9)
-        samplesRemaining -= samplesToProcess;
-    }
-    
-    auto postCtx = juce::dsp::ProcessContextReplacing<float>(block);
-    outputGainDSP.setGainDecibels(outputGainSmoother.getNextValue());
-    outputGainDSP.process(postCtx);
-    
-    leftPostRMS.set( buffer.getRMSLevel(0, 0, numSamples) );
-    rightPostRMS.set( buffer.getRMSLevel(1, 0, numSamples) );
-    
-    leftSCSF.update(buffer);
-    rightSCSF.update(buffer);
-    
-}
-
-void Project13AudioProcessor::MonoChannelDSP::process(juce::dsp::AudioBlock<float> block, const DSP_Order &dspOrder)
-{
-    DSP_Pointers dspPointers;
-    dspPointers.fill({}); //this was previously dspPointers.fill(nullptr);
-    
-    for( size_t i = 0; i < dspPointers.size(); ++i )
-    {
-        switch (dspOrder[i])
-        {
-            case DSP_Option::Phase:
-                dspPointers[i].processor = &phaser;
-                dspPointers[i].bypassed = p.phaserBypass->get();
-                break;
-            case DSP_Option::Chorus:
-                dspPointers[i].processor = &chorus;
-                dspPointers[i].bypassed = p.chorusBypass->get();
-                break;
-            case DSP_Option::Overdrive:
-                dspPointers[i].processor = &overdrive;
-                dspPointers[i].bypassed = p.overdriveBypass->get();
-                break;
-            case DSP_Option::LadderFilter:
-                dspPointers[i].processor = &ladderFilter;
-                dspPointers[i].bypassed = p.ladderFilterBypass->get();
-                break;
-            case DSP_Option::GeneralFilter:
-                dspPointers[i].processor = &generalFilter;
-                dspPointers[i].bypassed = p.generalFilterBypass->get();
-                break;
-            case DSP_Option::END_OF_LIST:
-                jassertfalse;
-                break;
-        }
-    }
-    //now process:
-    //auto block = juce::dsp::AudioBlock<float>(buffer);
-    auto context = juce::dsp::ProcessContextReplacing<float>(block);
-    
-    for( size_t i = 0; i < dspPointers.size(); ++i )
-   {
-       if( dspPointers[i].processor != nullptr )
-       {
-           juce::ScopedValueSetter<bool> svs(context.isBypassed, dspPointers[i].bypassed);
-           
-#if VERIFY_BYPASS_FUNCTIONALITY
-           if( context.isBypassed )
-           {
-               jassertfalse;
-           }
-           
-           if( dspPointers[i].processor == &generalFilter )
-           {
-               continue;
-           }
-#endif
-           dspPointers[i].processor->process(context);
-       }
-   }
-}
-//==============================================================================
-bool Project13AudioProcessor::hasEditor() const
-{
-    return true; // (change this to false if you choose to not supply an editor)
-}
-
-juce::AudioProcessorEditor* Project13AudioProcessor::createEditor()
-{
-    return new Project13AudioProcessorEditor (*this);
-    //return new juce::GenericAudioProcessorEditor(*this);
-}
-
-//==============================================================================
-template<>
-struct juce::VariantConverter<Project13AudioProcessor::DSP_Order>
-{
-    static Project13AudioProcessor::DSP_Order fromVar( const juce::var& v)
-    {
-        using T = Project13AudioProcessor::DSP_Order;
-        T dspOrder;
-        
-        jassert(v.isBinaryData());
-        if( v.isBinaryData() == false )
-        {
-            dspOrder.fill(Project13AudioProcessor::DSP_Option::END_OF_LIST);
-        }
-        else
-        {
-            auto mb = *v.getBinaryData();
-            juce::MemoryInputStream mis(mb, false);
-            std::vector<int> arr;
-            while( !mis.isExhausted() )
-            {
-                arr.push_back( mis.readInt() );
-            }
-            
-            jassert( arr.size() == dspOrder.size() );
-            for( size_t i = 0; i < dspOrder.size(); ++i )
-            {
-                dspOrder[i] = static_cast<Project13AudioProcessor::DSP_Option>(arr[i]);
-            }
-        }
-        return dspOrder;
-    }
-    
-    static juce::var toVar(const Project13AudioProcessor::DSP_Order& t)
-    {
-        juce::MemoryBlock mb;
-        //juce MOS uses scoping to complete writing to the memory block correctly
-        {
-            juce::MemoryOutputStream mos(mb, false);
-            
-            for( const auto& v : t )
-            {
-                mos.writeInt( static_cast<int>(v) );
-            }
-        }
-        return mb;
-    }
-};
-
-void Project13AudioProcessor::getStateInformation (juce::MemoryBlock& destData)
-{
-    // You should use this method to store your parameters in the memory block.
-    // You could do that either as raw data, or use the XML or ValueTree classes
-    // as intermediaries to make it easy to save and load complex data.
-    
-    apvts.state.setProperty("dspOrder",
-                            juce::VariantConverter<Project13AudioProcessor::DSP_Order>::toVar(dspOrder),
-                            nullptr);
-    
-    juce::MemoryOutputStream mos(destData, false);
-    apvts.state.writeToStream(mos);
-}
-
-void Project13AudioProcessor::setStateInformation (const void* data, int sizeInBytes)
-{
-    // You should use this method to restore your parameters from this memory block,
-    // whose contents will have been created by the getStateInformation() call.
-    
-    auto tree = juce::ValueTree::readFromData(data, sizeInBytes);
-    if( tree.isValid() )
-    {
-        apvts.replaceState(tree);
-        
-        if( apvts.state.hasProperty("dspOrder"))
-        {
-            auto order =
-            juce::VariantConverter<Project13AudioProcessor::DSP_Order>::fromVar(apvts.state
-            .getProperty("dspOrder"));
-            dspOrderFifo.push(order);
-            restoreDspOrderFifo.push(order);
-        }
-        DBG( apvts.state.toXmlString() );
-        
-#if VERIFY_BYPASS_FUNCTIONALITY
-        juce::Timer::callAfterDelay(1000, [this]()
-        {
-            DSP_Order order;
-            order.fill(DSP_Option::LadderFilter);
-            order[0] = DSP_Option::Chorus;
-            
-            chorusBypass->setValueNotifyingHost(1.f);
-            dspOrderFifo.push(order);
-        });
-#endif
-    }
-}
-
-//==============================================================================
-// This creates new instances of the plugin..
-juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
-{
-    return new Project13AudioProcessor();
-}
+/*
+  ==============================================================================
+
+    This file contains the basic framework code for a JUCE plugin processor.
+
+  ==============================================================================
+*/
+
+#include "PluginProcessor.h"
+#include "PluginEditor.h"
+#include "State/StateCodec.h"
+#include "State/PresetLibrary.h"
+#include "State/UndoJournal.h"
+
+auto getPhaserRateName() { return juce::String("Phaser RateHz"); }
+auto getPhaserCenterFreqName() { return juce::String("Phaser Center FreqHz"); }
+auto getPhaserDepthName() { return juce::String("Phaser Depth %" ); }
+auto getPhaserFeedbackName() { return juce::String("Phaser Feedback %" ); }
+auto getPhaserMixName() { return juce::String("Phaser Mix %"); }
+auto getPhaserBypassName() { return juce::String("Phaser Bypass"); }
+
+auto getChorusRateName() { return juce::String("Chorus RateHz"); }
+auto getChorusDepthName() { return juce::String("Chorus Depth %" ); }
+auto getChorusCenterDelayName() { return juce::String("Chorus Center Delay Ms"); }
+auto getChorusFeedbackName() { return juce::String("Chorus Feedback %" ); }
+auto getChorusMixName() { return juce::String("Chorus Mix %"); }
+auto getChorusBypassName() { return juce::String("Chorus Bypass"); }
+
+auto getOverdriveSaturationName() { return juce::String("OverDrive Saturation"); }
+auto getOverdriveBypassName() { return juce::String("Overdrive Bypass"); }
+
+auto getLadderFilterModeName() { return juce::String("Ladder Filter Mode"); }
+auto getLadderFilterCutoffName() { return juce::String("Ladder Filter Cutoff Hz %" ); }
+auto getLadderFilterResonanceName() { return juce::String("Ladder Filter Resonance"); }
+auto getLadderFilterDriveName() { return juce::String("Ladder Filter Drive" ); }
+auto getLadderFilterBypassName() { return juce::String("Ladder Filter Bypass"); }
+
+auto getLadderFilterChoices()
+{
+    return juce::StringArray
+    {
+        "LPF12",  // low-pass  12 dB/octave
+        "HPF12",  // high-pass 12 dB/octave
+        "BPF12",  // band-pass 12 dB/octave
+        "LPF24",  // low-pass  24 dB/octave
+        "HPF24",  // high-pass 24 dB/octave
+        "BPF24"   // band-pass 24 dB/octave
+    };
+}
+
+auto getGeneralFilterChoices()
+{
+    return juce::StringArray
+    {
+        "Peak",
+        "Bandpass",
+        "Notch",
+        "Allpass",
+    };
+}
+
+auto getGeneralFilterModeName() { return juce::String("General Filter Mode"); }
+auto getGeneralFilterFreqName() { return juce::String("General Filter Freq hz"); }
+auto getGeneralFilterQualityName() { return juce::String("General Filter Quality"); }
+auto getGeneralFilterGainName() { return juce::String("General Filter Gain"); }
+auto getGeneralFilterBypassName() { return juce::String("General Filter Bypass"); }
+
+auto getSelectedTabName() { return juce::String("Selected Tab"); }
+
+auto getInputGainName() { return juce::String( "Input Gain dB" ); }
+auto getOutputGainName() { return juce::String( "Output Gain dB "); }
+
+auto getCrossfadeModeName() { return juce::String("Crossfade Mode"); }
+auto getCrossfadeTimeName() { return juce::String("Crossfade Time ms"); }
+
+auto getMorphName() { return juce::String("Morph %"); }
+auto getMorphEnabledName() { return juce::String("Morph Enabled"); }
+
+auto getMidSideModeName() { return juce::String("Mid Side Mode"); }
+auto getPhaserSideBypassName() { return juce::String("Phaser Side Bypass"); }
+auto getChorusSideBypassName() { return juce::String("Chorus Side Bypass"); }
+auto getOverdriveSideBypassName() { return juce::String("Overdrive Side Bypass"); }
+auto getLadderFilterSideBypassName() { return juce::String("Ladder Filter Side Bypass"); }
+auto getGeneralFilterSideBypassName() { return juce::String("General Filter Side Bypass"); }
+
+//the second module instances' copies of a parameter are told apart by the instance number
+juce::String getInstanceName(const juce::String& name, size_t instance)
+{
+    return instance == 0 ? name : name + " " + juce::String(instance + 1);
+}
+
+auto getFirstInstanceParamNames()
+{
+    /*
+     the position of each name is the parameter's stable ID in the compact state chunk.
+     it must line up with Project13AudioProcessor::StateParam. only ever append to this list.
+     */
+    return std::array
+    {
+        getInputGainName(),
+        getOutputGainName(),
+        getPhaserRateName(),
+        getPhaserDepthName(),
+        getPhaserCenterFreqName(),
+        getPhaserFeedbackName(),
+        getPhaserMixName(),
+        getPhaserBypassName(),
+        getChorusRateName(),
+        getChorusDepthName(),
+        getChorusCenterDelayName(),
+        getChorusFeedbackName(),
+        getChorusMixName(),
+        getChorusBypassName(),
+        getOverdriveSaturationName(),
+        getOverdriveBypassName(),
+        getLadderFilterModeName(),
+        getLadderFilterCutoffName(),
+        getLadderFilterResonanceName(),
+        getLadderFilterDriveName(),
+        getLadderFilterBypassName(),
+        getGeneralFilterModeName(),
+        getGeneralFilterFreqName(),
+        getGeneralFilterQualityName(),
+        getGeneralFilterGainName(),
+        getGeneralFilterBypassName(),
+        getSelectedTabName(),
+        getCrossfadeModeName(),
+        getCrossfadeTimeName(),
+        getMorphName(),
+        getMorphEnabledName(),
+        getMidSideModeName(),
+        getPhaserSideBypassName(),
+        getChorusSideBypassName(),
+        getOverdriveSideBypassName(),
+        getLadderFilterSideBypassName(),
+        getGeneralFilterSideBypassName(),
+    };
+}
+
+auto getStateParamNames()
+{
+    using P = Project13AudioProcessor;
+    
+    //the names of every instance after the first follow, in the order StateParam appends them
+    std::array<juce::String, P::numStateParams> names;
+    auto firstNames = getFirstInstanceParamNames();
+    static_assert(std::tuple_size<decltype(firstNames)>::value == static_cast<size_t>(P::StateParam::Phaser2Rate),
+                  "getFirstInstanceParamNames() and StateParam are out of sync");
+    std::copy(firstNames.begin(), firstNames.end(), names.begin());
+    
+    auto next = firstNames.size();
+    for( size_t instance = 1; instance < P::numModuleInstances; ++instance )
+    {
+        for( auto param : P::moduleParams )
+            names[next++] = getInstanceName(firstNames[static_cast<size_t>(param)], instance);
+    }
+    
+    jassert( next == names.size() );
+    return names;
+}
+//==============================================================================
+Project13AudioProcessor::Project13AudioProcessor()
+#ifndef JucePlugin_PreferredChannelConfigurations
+     : AudioProcessor (BusesProperties()
+                     #if ! JucePlugin_IsMidiEffect
+                      #if ! JucePlugin_IsSynth
+                       .withInput  ("Input",  juce::AudioChannelSet::stereo(), true)
+                       //off until the host connects something to it. see ModMatrix::EnvelopeInput.
+                       .withInput  ("Sidechain", juce::AudioChannelSet::stereo(), false)
+                      #endif
+                       .withOutput ("Output", juce::AudioChannelSet::stereo(), true)
+                     #endif
+                       )
+#endif
+{
+    dspOrder = getDefaultOrder();
+    requestedOrder = dspOrder;
+    
+    /*
+     the audio thread isn't running yet, so the constructor can stand in as the event producer.
+     this gives the editor its tabs even if the host never calls processBlock().
+     */
+    Event initialOrder;
+    initialOrder.type = Event::Type::OrderChanged;
+    initialOrder.order = dspOrder;
+    eventQueue.push(initialOrder);
+    lastReportedOrder = dspOrder;
+    
+    auto floatParams = std::array
+    {
+        &phaserRateHz,
+        &phaserCenterFreqHz,
+        &phaserDepthPercent,
+        &phaserFeedbackPercent,
+        &phaserMixPercent,
+        
+        &chorusRateHz,
+        &chorusDepthPercent,
+        &chorusCenterDelayMs,
+        &chorusFeedbackPercent,
+        &chorusMixPercent,
+        
+        &overdriveSaturation,
+        
+        &ladderFilterCutoffHz,
+        &ladderFilterResonance,
+        &ladderFilterDrive,
+        
+        &generalFilterFreqHz,
+        &generalFilterQuality,
+        &generalFilterGain,
+        
+        &inputGain,
+        &outputGain,
+        
+        &crossfadeTimeMs,
+        &morph,
+    };
+    
+    auto floatNameFuncs = std::array
+    {
+        &getPhaserRateName,
+        &getPhaserCenterFreqName,
+        &getPhaserDepthName,
+        &getPhaserFeedbackName,
+        &getPhaserMixName,
+        
+        &getChorusRateName,
+        &getChorusDepthName,
+        &getChorusCenterDelayName,
+        &getChorusFeedbackName,
+        &getChorusMixName,
+        
+        &getOverdriveSaturationName,
+        
+        &getLadderFilterCutoffName,
+        &getLadderFilterResonanceName,
+        &getLadderFilterDriveName,
+        
+        &getGeneralFilterFreqName,
+        &getGeneralFilterQualityName,
+        &getGeneralFilterGainName,
+        
+        &getInputGainName,
+        &getOutputGainName,
+        
+        &getCrossfadeTimeName,
+        &getMorphName,
+    };
+    
+//    for( size_t i = 0; i < floatParams.size(); ++i )
+//    {
+//        auto ptrToParamPtr = floatParams[i];
+//        *ptrToParamPtr = dynamic_cast<juce::AudioParameterFloat*>(apvts.getParameter(
+//             floatNameFuncs[i]() ));
+//        jassert( *ptrToParamPtr != nullptr );
+//    }
+    
+    initCachedParams<juce::AudioParameterFloat*>(floatParams, floatNameFuncs);
+    
+    auto choiceParams = std::array
+    {
+        &ladderFilterMode,
+        &generalFilterMode,
+    };
+    
+    auto choiceNameFuncs = std::array
+    {
+        &getLadderFilterModeName,
+        &getGeneralFilterModeName,
+    };
+  
+//    for( size_t i = 0; i < choiceParams.size(); ++i )
+//    {
+//        auto ptrToParamPtr = choiceParams[i];
+//        *ptrToParamPtr = dynamic_cast<juce::AudioParameterChoice*>(apvts.getParameter(
+//             choiceNameFuncs[i]() ));
+//        jassert( *ptrToParamPtr != nullptr );
+//    }
+    
+    initCachedParams<juce::AudioParameterChoice*>(choiceParams, choiceNameFuncs);
+    
+    auto bypassParams = std::array
+    {
+        &phaserBypass,
+        &chorusBypass,
+        &overdriveBypass,
+        &ladderFilterBypass,
+        &generalFilterBypass,
+        
+        &crossfadeMode,
+        &morphEnabled,
+        
+        &midSideMode,
+        &phaserSideBypass,
+        &chorusSideBypass,
+        &overdriveSideBypass,
+        &ladderFilterSideBypass,
+        &generalFilterSideBypass,
+    };
+    
+    auto bypassNameFuncs = std::array
+    {
+        &getPhaserBypassName,
+        &getChorusBypassName,
+        &getOverdriveBypassName,
+        &getLadderFilterBypassName,
+        &getGeneralFilterBypassName,
+        
+        &getCrossfadeModeName,
+        &getMorphEnabledName,
+        
+        &getMidSideModeName,
+        &getPhaserSideBypassName,
+        &getChorusSideBypassName,
+        &getOverdriveSideBypassName,
+        &getLadderFilterSideBypassName,
+        &getGeneralFilterSideBypassName,
+    };
+    
+//    for( size_t i = 0; i < bypassParams.size(); ++i )
+//    {
+//        auto ptrToParamPtr = bypassParams[i];
+//        *ptrToParamPtr =
+//        dynamic_cast<juce::AudioParameterBool*>(apvts.getParameter(bypassNameFuncs[i]()));
+//        jassert( *ptrToParamPtr != nullptr );
+//    }
+  
+    initCachedParams<juce::AudioParameterBool*>(bypassParams, bypassNameFuncs);
+    
+    auto intParams = std::array
+    {
+        &selectedTab
+    };
+    
+    auto intFuncs = std::array
+    {
+        &getSelectedTabName
+    };
+    
+    initCachedParams<juce::AudioParameterInt*>(intParams, intFuncs);
+    
+    auto stateParamNames = getStateParamNames();
+    static_assert(std::tuple_size<decltype(stateParamNames)>::value == numStateParams,
+                  "getStateParamNames() and StateParam are out of sync");
+    for( size_t i = 0; i < stateParamNames.size(); ++i )
+    {
+        stateParams[i] = apvts.getParameter(stateParamNames[i]);
+        jassert( stateParams[i] != nullptr );
+        
+        auto& source = liveParamSources[i];
+        source.floatParam = dynamic_cast<juce::AudioParameterFloat*>(stateParams[i]);
+        source.choiceParam = dynamic_cast<juce::AudioParameterChoice*>(stateParams[i]);
+        source.boolParam = dynamic_cast<juce::AudioParameterBool*>(stateParams[i]);
+        source.intParam = dynamic_cast<juce::AudioParameterInt*>(stateParams[i]);
+        
+        if( source.floatParam != nullptr )
+            morphKinds[i] = MorphKind::Interpolate;
+        else if( source.choiceParam != nullptr || source.boolParam != nullptr )
+            morphKinds[i] = MorphKind::SwitchAtMidpoint;
+        else
+            morphKinds[i] = MorphKind::Fixed;
+    }
+    
+    //the morph controls and the crossfade switch must not morph themselves
+    for( auto p : { StateParam::Morph, StateParam::MorphEnabled, StateParam::CrossfadeMode, StateParam::SelectedTab } )
+        morphKinds[static_cast<size_t>(p)] = MorphKind::Fixed;
+    
+    //changes start a control tick. see parameterValueChanged().
+    for( auto* param : stateParams )
+        param->addListener(this);
+    
+    refreshLiveParams();
+    
+    presetLibrary = std::make_unique<PresetLibrary>(*this);
+    undoJournal = std::make_unique<UndoJournal>(*this);
+    undoJournalRef = undoJournal.get();
+    
+#if PROJECT13_PROFILE_DSP
+    if( auto logFile = DeadlineTelemetry::getLogFileFromEnvironment() )
+        startTelemetryLog(*logFile);
+#endif
+    
+    governor.setMode(QualityGovernor::getModeFromEnvironment());
+    
+    //reclaims states and analyzer fifos the audio thread has retired
+    startTimerHz(10);
+}
+
+Project13AudioProcessor::~Project13AudioProcessor()
+{
+    //stop the preset loader thread before the fifo it pushes into goes away
+    presetLibrary.reset();
+    telemetryLogger.reset();
+    undoJournal.reset();
+    
+    for( auto* param : stateParams )
+        param->removeListener(this);
+    
+    stopTimer();
+    delete pendingState.exchange(nullptr);
+    delete adoptedState;
+    reclaimRetiredState();
+}
+
+//==============================================================================
+const juce::String Project13AudioProcessor::getName() const
+{
+    return JucePlugin_Name;
+}
+
+bool Project13AudioProcessor::acceptsMidi() const
+{
+   #if JucePlugin_WantsMidiInput
+    return true;
+   #else
+    return false;
+   #endif
+}
+
+bool Project13AudioProcessor::producesMidi() const
+{
+   #if JucePlugin_ProducesMidiOutput
+    return true;
+   #else
+    return false;
+   #endif
+}
+
+bool Project13AudioProcessor::isMidiEffect() const
+{
+   #if JucePlugin_IsMidiEffect
+    return true;
+   #else
+    return false;
+   #endif
+}
+
+double Project13AudioProcessor::getTailLengthSeconds() const
+{
+    return 0.0;
+}
+
+int Project13AudioProcessor::getNumPrograms()
+{
+    // NB: some hosts don't cope very well if you tell them there are 0 programs,
+    // so this should be at least 1, even if you're not really implementing programs.
+    return juce::jmax(1, presetLibrary->getNumPresets());
+}
+
+int Project13AudioProcessor::getCurrentProgram()
+{
+    return juce::jmax(0, presetLibrary->getCurrentPreset());
+}
+
+void Project13AudioProcessor::setCurrentProgram (int index)
+{
+    presetLibrary->loadPresetAsync(index);
+}
+
+const juce::String Project13AudioProcessor::getProgramName (int index)
+{
+    return presetLibrary->getPresetName(index);
+}
+
+void Project13AudioProcessor::changeProgramName (int index, const juce::String& newName)
+{
+}
+
+//==============================================================================
+void Project13AudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
+{
+    // Use this method as the place to do any pre-playback
+    // initialisation that you need..
+    
+    juce::dsp::ProcessSpec spec;
+    spec.sampleRate = sampleRate;
+    spec.maximumBlockSize = samplesPerBlock;
+    spec.numChannels = 1;
+    
+    //a transition that was running when playback stopped is completed instantly
+    dspOrder = getLatestOrder();
+    crossfade = ChainCrossfade();
+    
+    /*
+     a state restored before playback starts (a session load, or an offline render) is adopted here,
+        so it is in place from the first sample instead of fading or gliding in.
+     processBlock() isn't running, so this thread can stand in for the audio thread.
+     */
+    reclaimRetiredState();
+    if( adoptPublishedState() && isValidOrder(adoptedState->snapshot.order) )
+        dspOrder = adoptedState->snapshot.order;
+    crossfadeBuffer.setSize(2, QualityGovernor::maxControlInterval);
+    
+    //every prepare starts over at full quality
+    governor.reset();
+    qualityTier = QualityGovernor::Tier::Full;
+    
+    //the first block starts with a control tick
+    samplesUntilControlTick = 0;
+    incomingChainStale = false;
+    meterWindow = MeterWindow();
+    
+    for( auto smoother : getSmoothers() )
+    {
+        smoother->reset(sampleRate, 0.005);
+    }
+    
+    refreshLiveParams();
+    updateSmoothersFromParams(1, SmootherUpdateMode::initialize);
+    //the smoothers and chains already start from the morphed values
+    morphSwitched = false;
+    
+    //the LFOs start over from phase 0
+    modMatrix.prepare(sampleRate);
+    updateControlValues();
+    
+    /*
+     an offline render prepares every module, so none is ever skipped.
+     in realtime, only the modules in the order are prepared, bypassed or not, along with any an order that is
+        still on its way asked for. processBlock() isn't running, so the others give their memory back,
+        and these are prepared again for the new spec.
+     */
+    {
+        const juce::ScopedLock sl(moduleLock);
+        moduleSpec = spec;
+        //hosts switch to offline before they prepare for a bounce
+        renderHighQuality = isNonRealtime();
+        
+        for( auto* chain : { &leftChannel, &rightChannel, &leftFadeChannel, &rightFadeChannel } )
+            chain->prepareRender(spec, renderHighQuality);
+        
+        //the incoming pair gets its padding when a crossfade starts it
+        activeChain.setPaddingForOrder(dspOrder);
+        
+        //realtime doesn't pay for the oversamplers it doesn't run. see getRenderLatency().
+        setLatencySamples(renderHighQuality ? getRenderLatency() : 0);
+        
+        auto inUse = getModulesInOrder(dspOrder);
+        for( size_t i = 0; i < numDSPOptions; ++i )
+            inUse[i] = inUse[i] || modulesRequested[i] || renderHighQuality;
+        modulesRequested = {};
+        
+        for( size_t i = 0; i < numDSPOptions; ++i )
+        {
+            if( inUse[i] == false && modulePrepared[i].load() )
+            {
+                for( auto* chain : { &leftChannel, &rightChannel, &leftFadeChannel, &rightFadeChannel } )
+                    chain->releaseModule(static_cast<DSP_Option>(i));
+            }
+            
+            modulePrepared[i].store(false);
+        }
+        
+        prepareModules(inUse);
+    }
+    
+    refreshModulesReady();
+    
+    spec.numChannels = getTotalNumInputChannels();
+    
+    //runControlTick() sets new gains once per interval. they ramp there over the shortest one.
+    for( auto* gain : { &inputGainDSP, &outputGainDSP } )
+    {
+        gain->prepare(sampleRate);
+        gain->setRampDurationSeconds(QualityGovernor::getControlInterval(QualityGovernor::Tier::Full) / sampleRate);
+    }
+    
+    //the chains were just reset, so the mode can switch without a crossfade
+    midSideActive = liveBool(StateParam::MidSideMode);
+    activeChain.midSide = midSideActive;
+    
+    {
+        //the analyzer's fifos only exist while an editor is open
+        const juce::ScopedLock sl(analyzerLock);
+        if( openFifos != nullptr )
+        {
+            openFifos->left.prepare(samplesPerBlock);
+            openFifos->right.prepare(samplesPerBlock);
+        }
+    }
+}
+
+void Project13AudioProcessor::updateSmoothersFromParams(int numSamplesToSkip, SmootherUpdateMode init)
+{
+    //runs on the audio thread, so these are arrays, not vectors
+    auto smoothers = getSmoothers();
+    
+    for( size_t i = 0; i < smoothers.size(); ++i )
+    {
+        auto smoother = smoothers[i];
+        auto param = smoothedParams[i];
+        
+        if( init == SmootherUpdateMode::initialize )
+            smoother->setCurrentAndTargetValue( live(param) );
+        else
+            smoother->setTargetValue( live(param) );
+        
+        smoother->skip(numSamplesToSkip);
+    }
+}
+
+Project13AudioProcessor::SmootherList Project13AudioProcessor::getSmoothers()
+{
+    auto smoothers = SmootherList
+    {
+        &phaserRateHzSmoother,
+        &phaserCenterFreqHzSmoother,
+        &phaserDepthPercentSmoother,
+        &phaserFeedbackPercentSmoother,
+        &phaserMixPercentSmoother,
+        &chorusRateHzSmoother,
+        &chorusDepthPercentSmoother,
+        &chorusCenterDelayMsSmoother,
+        &chorusFeedbackPercentSmoother,
+        &chorusMixPercentSmoother,
+        &overdriveSaturationSmoother,
+        &ladderFilterCutoffHzSmoother,
+        &ladderFilterResonanceSmoother,
+        &ladderFilterDriveSmoother,
+        &generalFilterFreqHzSmoother,
+        &generalFilterQualitySmoother,
+        &generalFilterGainSmoother,
+        &inputGainSmoother,
+        &outputGainSmoother,
+        &phaser2RateHzSmoother,
+        &phaser2CenterFreqHzSmoother,
+        &phaser2DepthPercentSmoother,
+        &phaser2FeedbackPercentSmoother,
+        &phaser2MixPercentSmoother,
+        &chorus2RateHzSmoother,
+        &chorus2DepthPercentSmoother,
+        &chorus2CenterDelayMsSmoother,
+        &chorus2FeedbackPercentSmoother,
+        &chorus2MixPercentSmoother,
+        &overdrive2SaturationSmoother,
+        &ladderFilter2CutoffHzSmoother,
+        &ladderFilter2ResonanceSmoother,
+        &ladderFilter2DriveSmoother,
+        &generalFilter2FreqHzSmoother,
+        &generalFilter2QualitySmoother,
+        &generalFilter2GainSmoother
+    };
+    
+    return smoothers;
+    
+}
+
+void Project13AudioProcessor::updateControlValues()
+{
+    //the parameters without a smoother are used as they are
+    controlValues = liveParams;
+    
+    const auto modulating = modMatrix.isActive();
+    const auto* offsets = modMatrix.getOffsets();
+    auto smoothers = getSmoothers();
+    
+    for( size_t i = 0; i < smoothers.size(); ++i )
+    {
+        auto index = static_cast<size_t>(smoothedParams[i]);
+        auto value = smoothers[i]->getCurrentValue();
+        
+        //mod target i is smoothedParams[i]. the offsets are in normalized units, so a route sweeps a skewed range the way its knob does
+        if( modulating && modMatrix.isTargeted(i) )
+        {
+            const auto& range = stateParams[index]->getNormalisableRange();
+            value = range.convertFrom0to1(juce::jlimit(0.f, 1.f, range.convertTo0to1(value) + offsets[i]));
+        }
+        
+        controlValues[index] = value;
+    }
+}
+
+std::optional<size_t> Project13AudioProcessor::getModTarget(StateParam param)
+{
+    auto it = std::find(smoothedParams.begin(), smoothedParams.end(), param);
+    if( it == smoothedParams.end() )
+        return std::nullopt;
+    
+    return static_cast<size_t>(it - smoothedParams.begin());
+}
+
+void Project13AudioProcessor::setModRouting(const ModMatrix::Routing& routing)
+{
+    //the command queue has a single producer
+    JUCE_ASSERT_MESSAGE_THREAD
+    
+    const juce::ScopedLock sl(morphLock);
+    modRouting = routing;
+    
+    //only the smoothed parameters can be modulated, and they are the first numModTargets targets
+    for( size_t t = numModTargets; t < ModMatrix::maxTargets; ++t )
+    {
+        for( auto& row : modRouting.depths )
+            row[t] = 0.f;
+    }
+    
+    modRoutingUnsent = ! sendCommand(Command::setModRouting(modRouting));
+}
+
+ModMatrix::Routing Project13AudioProcessor::getModRouting() const
+{
+    const juce::ScopedLock sl(morphLock);
+    return modRouting;
+}
+
+float Project13AudioProcessor::LiveParamSource::read() const
+{
+    if( floatParam != nullptr )
+        return floatParam->get();
+    if( choiceParam != nullptr )
+        return static_cast<float>(choiceParam->getIndex());
+    if( boolParam != nullptr )
+        return boolParam->get() ? 1.f : 0.f;
+    if( intParam != nullptr )
+        return static_cast<float>(intParam->get());
+    
+    jassertfalse;
+    return 0.f;
+}
+
+void Project13AudioProcessor::refreshLiveParams()
+{
+    /*
+     a preset has reached the audio thread but the message thread hasn't written its values into the
+        parameters yet. keep using the preset's values until it has.
+     */
+    if( adoptedState != nullptr && adoptedState->generation > landedStateGeneration.load() )
+    {
+        liveParams = adoptedState->snapshot.values;
+    }
+    else
+    {
+        for( size_t i = 0; i < numStateParams; ++i )
+        {
+            liveParams[i] = liveParamSources[i].read();
+        }
+    }
+    
+    applyMorph();
+}
+
+void Project13AudioProcessor::applyMorph()
+{
+    auto side = MorphSide::Off;
+    if( liveMorph.valid && liveBool(StateParam::MorphEnabled) )
+    {
+        auto amount = juce::jlimit(0.f, 1.f, live(StateParam::Morph) * 0.01f);
+        side = amount < 0.5f ? MorphSide::A : MorphSide::B;
+        const auto& switched = side == MorphSide::A ? liveMorph.a : liveMorph.b;
+        
+        for( size_t i = 0; i < numStateParams; ++i )
+        {
+            switch( morphKinds[i] )
+            {
+                case MorphKind::Interpolate:
+                    liveParams[i] = liveMorph.a[i] + (liveMorph.b[i] - liveMorph.a[i]) * amount;
+                    break;
+                case MorphKind::SwitchAtMidpoint:
+                    liveParams[i] = switched[i];
+                    break;
+                case MorphKind::Fixed:
+                    break;
+            }
+        }
+    }
+    
+    /*
+     a choice or bypass jumped, because the morph crossed the midpoint or was switched on/off.
+     processBlock() crossfades to it.
+     */
+    if( side != morphSide )
+    {
+        morphSwitched = true;
+        morphSide = side;
+    }
+}
+
+void Project13AudioProcessor::storeMorphSnapshot(MorphSlot slot)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+    
+    auto current = captureState().values;
+    
+    const juce::ScopedLock sl(morphLock);
+    if( morphSnapshots.valid == false )
+    {
+        morphSnapshots.a = current;
+        morphSnapshots.b = current;
+        morphSnapshots.valid = true;
+    }
+    
+    (slot == MorphSlot::A ? morphSnapshots.a : morphSnapshots.b) = current;
+    morphSnapshotsUnsent = ! sendCommand(Command::setMorphSnapshots(morphSnapshots));
+}
+
+bool Project13AudioProcessor::hasMorphSnapshots() const
+{
+    const juce::ScopedLock sl(morphLock);
+    return morphSnapshots.valid;
+}
+
+bool Project13AudioProcessor::adoptPublishedState()
+{
+    /*
+     the state being replaced can only be handed back if the retire ring has room.
+     until then the audio thread keeps using the complete state it already has.
+     */
+    if( adoptedState != nullptr && retiredStates.isFull() )
+        return false;
+    
+    auto* published = pendingState.exchange(nullptr);
+    if( published == nullptr )
+        return false;
+    
+    if( adoptedState != nullptr )
+    {
+        auto handedBack = retiredStates.push(adoptedState);
+        jassert( handedBack );
+        juce::ignoreUnused(handedBack);
+    }
+    
+    adoptedState = published;
+    liveMorph = adoptedState->snapshot.morph;
+    modMatrix.setRouting(adoptedState->snapshot.modulation);
+    return true;
+}
+
+void Project13AudioProcessor::reclaimRetiredState()
+{
+    const juce::ScopedLock sl(retireLock);
+    
+    PublishedState* retired = nullptr;
+    while( retiredStates.pop(retired) )
+        delete retired;
+}
+
+bool Project13AudioProcessor::sendCommand(const Command& command)
+{
+    reclaimRetiredState();
+    
+    const auto isNewOrder = command.type == Command::Type::SetOrder && isValidOrder(command.order);
+    if( isNewOrder )
+        prepareModulesAhead(getModulesInOrder(command.order));
+    
+    if( commandQueue.push(command) == false )
+        return false;
+    
+    if( isNewOrder )
+    {
+        const juce::ScopedLock sl(morphLock);
+        requestedOrder = command.order;
+    }
+    
+    return true;
+}
+
+Project13AudioProcessor::AnalyzerFifos& Project13AudioProcessor::openAnalyzer()
+{
+    const juce::ScopedLock sl(analyzerLock);
+    jassert( openFifos == nullptr ); //only one editor at a time
+    
+    if( openFifos == nullptr )
+    {
+        openFifos = std::make_unique<AnalyzerFifos>();
+        
+        //an editor opened before the first prepareToPlay() gets a guess. prepareToPlay() prepares them again.
+        const auto blockSize = getBlockSize() > 0 ? getBlockSize() : 512;
+        openFifos->left.prepare(blockSize);
+        openFifos->right.prepare(blockSize);
+        
+        sendCommand(Command::configureAnalyzer(openFifos.get(), ++analyzerGeneration));
+    }
+    
+    return *openFifos;
+}
+
+void Project13AudioProcessor::closeAnalyzer()
+{
+    const juce::ScopedLock sl(analyzerLock);
+    if( openFifos == nullptr )
+        return;
+    
+    /*
+     the audio thread may still be feeding them, so they are kept until it acknowledges this generation,
+        or a later one if this command doesn't fit in the queue.
+     */
+    sendCommand(Command::configureAnalyzer(nullptr, ++analyzerGeneration));
+    retiredFifos.push_back({ std::move(openFifos), analyzerGeneration });
+}
+
+void Project13AudioProcessor::reclaimAnalyzerFifos()
+{
+    const juce::ScopedLock sl(analyzerLock);
+    const auto seen = analyzerGenerationSeen.load(std::memory_order_acquire);
+    std::erase_if(retiredFifos, [seen](const RetiredFifos& r) { return r.generation <= seen; });
+}
+
+void Project13AudioProcessor::refreshModulesReady()
+{
+    for( size_t i = 0; i < numDSPOptions; ++i )
+        modulesReady[i] = modulePrepared[i].load(std::memory_order_acquire);
+}
+
+void Project13AudioProcessor::prepareModules(const ModuleSet& modules)
+{
+    //nothing can be prepared before the first prepareToPlay()
+    if( moduleSpec.sampleRate <= 0.0 )
+        return;
+    
+    for( size_t i = 0; i < numDSPOptions; ++i )
+    {
+        if( modules[i] == false || modulePrepared[i].load() )
+            continue;
+        
+        //the audio thread doesn't touch the module until the flag is set
+        const auto option = static_cast<DSP_Option>(i);
+        for( auto* chain : { &leftChannel, &rightChannel, &leftFadeChannel, &rightFadeChannel } )
+            chain->prepareModule(option, getModuleSpec(option));
+        
+        modulePrepared[i].store(true, std::memory_order_release);
+        //an idle audio thread wouldn't pick the module up otherwise
+        controlChanges.fetch_add(1, std::memory_order_release);
+    }
+}
+
+bool Project13AudioProcessor::isOversampledOffline(DSP_Option option)
+{
+    //every instance of a module is oversampled alike
+    option = option == DSP_Option::END_OF_LIST ? option : getModuleKind(option);
+    return option == DSP_Option::Chorus || option == DSP_Option::Overdrive || option == DSP_Option::LadderFilter;
+}
+
+int Project13AudioProcessor::getOversamplingLatency()
+{
+    //with integer latency on, the oversampler rounds its latency up with a fractional delay of its own
+    static const int latency = []
+    {
+        juce::dsp::Oversampling<float> oversampler(1, oversamplingOrder, juce::dsp::Oversampling<float>::filterHalfBandFIREquiripple, true, true);
+        oversampler.initProcessing(1);
+        return static_cast<int>(std::ceil(oversampler.getLatencyInSamples()));
+    }();
+    
+    return latency;
+}
+
+int Project13AudioProcessor::getRenderLatency()
+{
+    int numOversampled = 0;
+    for( size_t i = 0; i < numDSPOptions; ++i )
+    {
+        if( isOversampledOffline(static_cast<DSP_Option>(i)) )
+            ++numOversampled;
+    }
+    
+    return numOversampled * getOversamplingLatency();
+}
+
+juce::dsp::ProcessSpec Project13AudioProcessor::getModuleSpec(DSP_Option option) const
+{
+    auto spec = moduleSpec;
+    if( renderHighQuality && isOversampledOffline(option) )
+    {
+        spec.sampleRate *= static_cast<double>(1 << oversamplingOrder);
+        spec.maximumBlockSize <<= oversamplingOrder;
+    }
+    
+    return spec;
+}
+
+Project13AudioProcessor::ModuleSet Project13AudioProcessor::getModulesInOrder(const DSP_Order& order)
+{
+    ModuleSet inOrder {};
+    for( auto option : order )
+    {
+        if( static_cast<size_t>(option) < numDSPOptions )
+            inOrder[static_cast<size_t>(option)] = true;
+    }
+    
+    return inOrder;
+}
+
+void Project13AudioProcessor::prepareModulesAhead(const ModuleSet& modules)
+{
+    const juce::ScopedLock sl(moduleLock);
+    for( size_t i = 0; i < numDSPOptions; ++i )
+        modulesRequested[i] = modulesRequested[i] || modules[i];
+    
+    prepareModules(modules);
+}
+
+void Project13AudioProcessor::parameterValueChanged(int, float)
+{
+    //any thread. the value is already stored, so the tick this starts reads it.
+    controlChanges.fetch_add(1, std::memory_order_release);
+}
+
+size_t Project13AudioProcessor::MemoryUsage::getTotalBytes() const
+{
+    return std::accumulate(moduleBytes.begin(), moduleBytes.end(), analyzerBytes);
+}
+
+Project13AudioProcessor::MemoryUsage Project13AudioProcessor::getMemoryUsage() const
+{
+    MemoryUsage usage;
+    
+    {
+        const juce::ScopedLock sl(analyzerLock);
+        //each fifo holds 30 single-channel buffers, plus the one being filled
+        auto getBytes = [](const AnalyzerFifos& f)
+        {
+            return static_cast<size_t>(31 * (f.left.getSize() + f.right.getSize())) * sizeof(float);
+        };
+        
+        if( openFifos != nullptr )
+            usage.analyzerBytes += getBytes(*openFifos);
+        
+        for( const auto& retired : retiredFifos )
+            usage.analyzerBytes += getBytes(*retired.fifos);
+    }
+    
+    const juce::ScopedLock sl(moduleLock);
+    const auto blockBytes = static_cast<size_t>(moduleSpec.maximumBlockSize) * sizeof(float);
+    for( size_t i = 0; i < numDSPOptions; ++i )
+    {
+        if( modulePrepared[i].load() == false )
+            continue;
+        
+        size_t bytes = 0;
+        //every instance of a module holds the same
+        switch( getModuleKind(static_cast<DSP_Option>(i)) )
+        {
+            case DSP_Option::Phase:
+                //the dry/wet mixer's dry copy and the modulation buffer
+                bytes = 2 * blockBytes;
+                break;
+            case DSP_Option::Chorus:
+            {
+                //the same two buffers, and a delay line for the longest delay plus the deepest modulation: 110 ms
+                auto delaySamples = static_cast<size_t>(std::ceil(0.11 * moduleSpec.sampleRate)) + 1;
+                bytes = 2 * blockBytes + delaySamples * sizeof(float);
+                break;
+            }
+            case DSP_Option::Overdrive:
+            case DSP_Option::LadderFilter:
+                //the filter stages' state
+                bytes = 5 * sizeof(float);
+                break;
+            case DSP_Option::GeneralFilter:
+                //the biquad's coefficients and state
+                bytes = 9 * sizeof(float);
+                break;
+            case DSP_Option::Phase2:
+            case DSP_Option::Chorus2:
+            case DSP_Option::Overdrive2:
+            case DSP_Option::LadderFilter2:
+            case DSP_Option::GeneralFilter2:
+            case DSP_Option::END_OF_LIST:
+                jassertfalse;
+                break;
+        }
+        
+        //left, right, and both crossfade chains
+        usage.moduleBytes[i] = 4 * bytes;
+    }
+    
+    return usage;
+}
+
+void Project13AudioProcessor::timerCallback()
+{
+    reclaimRetiredState();
+    reclaimAnalyzerFifos();
+    resendUnsentCommands();
+    notifyEventChangedParams();
+}
+
+void Project13AudioProcessor::resendUnsentCommands()
+{
+    if( morphSnapshotsUnsent == false && modRoutingUnsent == false )
+        return;
+    
+    //the latest copies, which may be newer than the ones that didn't fit
+    const juce::ScopedLock sl(morphLock);
+    if( morphSnapshotsUnsent )
+        morphSnapshotsUnsent = ! sendCommand(Command::setMorphSnapshots(morphSnapshots));
+    if( modRoutingUnsent )
+        modRoutingUnsent = ! sendCommand(Command::setModRouting(modRouting));
+}
+
+juce::uint32 Project13AudioProcessor::publishState(const StateSnapshot& snapshot)
+{
+    //make room for the state this publish will eventually replace, and the ones before it
+    reclaimRetiredState();
+    //the modules of the state's order are prepared before the audio thread sees it
+    if( isValidOrder(snapshot.order) )
+        prepareModulesAhead(getModulesInOrder(snapshot.order));
+    
+    auto published = std::make_unique<PublishedState>();
+    published->snapshot = snapshot;
+    published->generation = ++stateGeneration;
+    auto generation = published->generation;
+    
+    //a getState() from here on saves this order, even before the audio thread has switched to it
+    if( isValidOrder(snapshot.order) )
+    {
+        const juce::ScopedLock sl(morphLock);
+        requestedOrder = snapshot.order;
+    }
+    
+    //the audio thread never saw a state that is replaced here, so it can be deleted right away
+    delete pendingState.exchange(published.release());
+    
+    return generation;
+}
+
+void Project13AudioProcessor::landState(const StateSnapshot& snapshot, juce::uint32 generation)
+{
+    /*
+     hosts may call setStateInformation() from a thread other than the message thread.
+     setValueNotifyingHost() is what the APVTS used to do from there too.
+     */
+    for( size_t i = 0; i < numStateParams; ++i )
+    {
+        auto* param = stateParams[i];
+        param->setValueNotifyingHost(param->convertTo0to1(snapshot.values[i]));
+    }
+    
+    /*
+     the audio thread takes the order and the morph snapshots from the published state,
+        and reports the new order to the editor itself.
+     */
+    /*
+     hosts can restore state before the journal exists. the journal lives on the message thread,
+        so from any other thread the order is noted there, unless the journal has gone by then.
+     */
+    auto journal = undoJournalRef;
+    if( isValidOrder(snapshot.order) && journal != nullptr )
+    {
+        if( juce::MessageManager::existsAndIsCurrentThread() )
+            journal->noteCurrentOrder(snapshot.order);
+        else
+        {
+            juce::MessageManager::callAsync([journal, order = snapshot.order]()
+            {
+                if( journal != nullptr )
+                    journal->noteCurrentOrder(order);
+            });
+        }
+    }
+    
+    {
+        const juce::ScopedLock sl(morphLock);
+        morphSnapshots = snapshot.morph;
+        modRouting = snapshot.modulation;
+    }
+    
+    //the parameters now hold the published values. the audio thread can go back to reading them.
+    auto landed = landedStateGeneration.load();
+    while( landed < generation && ! landedStateGeneration.compare_exchange_weak(landed, generation) )
+    {
+    }
+}
+
+void Project13AudioProcessor::MonoChannelDSP::updateDSPFromParams(bool midSide)
+{
+    for( size_t i = 0; i < bypassed.size(); ++i )
+        bypassed[i] = p.isModuleBypassed(static_cast<DSP_Option>(i), isRight && midSide);
+    
+    for( size_t instance = 0; instance < numModuleInstances; ++instance )
+    {
+        //this instance's copy of a parameter
+        auto control = [this, instance](StateParam param) { return p.control(getInstanceParam(param, instance)); };
+        //modules that aren't prepared yet are left alone. the message thread may be preparing them right now.
+        auto ready = [this, instance](DSP_Option kind) { return isReady(getModuleInstance(kind, instance)); };
+        
+        if( ready(DSP_Option::Phase) )
+        {
+            auto& phaser = phasers[instance];
+            phaser.dsp.setRate( control(StateParam::PhaserRate) );
+            phaser.dsp.setCentreFrequency( control(StateParam::PhaserCenterFreq) );
+            phaser.dsp.setDepth( control(StateParam::PhaserDepth) * 0.01f );
+            phaser.dsp.setFeedback( control(StateParam::PhaserFeedback) * 0.01f );
+            phaser.dsp.setMix( control(StateParam::PhaserMix) * 0.01f );
+        }
+        
+        if( ready(DSP_Option::Chorus) )
+        {
+            auto& chorus = choruses[instance];
+            chorus.dsp.setRate( control(StateParam::ChorusRate) );
+            chorus.dsp.setDepth( control(StateParam::ChorusDepth) * 0.01f );
+            chorus.dsp.setCentreDelay( control(StateParam::ChorusCenterDelay) );
+            chorus.dsp.setFeedback( control(StateParam::ChorusFeedback) * 0.01f );
+            chorus.dsp.setMix( control(StateParam::ChorusMix) * 0.01f );
+        }
+        
+        if( ready(DSP_Option::Overdrive) )
+            overdrives[instance].dsp.setDrive( control(StateParam::OverdriveSaturation) );
+        
+        if( ready(DSP_Option::LadderFilter) )
+        {
+            auto& ladderFilter = ladderFilters[instance];
+            ladderFilter.dsp.setMode( static_cast<juce::dsp::LadderFilterMode>( static_cast<int>(control(StateParam::LadderFilterMode))));
+            ladderFilter.dsp.setCutoffFrequencyHz( control(StateParam::LadderFilterCutoff) );
+            ladderFilter.dsp.setResonance( control(StateParam::LadderFilterResonance) * 0.01f );
+            ladderFilter.dsp.setDrive( control(StateParam::LadderFilterDrive) );
+        }
+        
+        if( ready(DSP_Option::GeneralFilter) )
+            updateGeneralFilter(instance);
+    }
+}
+
+void Project13AudioProcessor::MonoChannelDSP::updateGeneralFilter(size_t instance)
+{
+    auto control = [this, instance](StateParam param) { return p.control(getInstanceParam(param, instance)); };
+    auto& generalFilter = generalFilters[instance];
+    auto& [filterMode, filterFreq, filterQ, filterGain] = filterSettings[instance];
+    
+    //TODO: update general filter coefficients here
+    auto sampleRate = p.getSampleRate();
+    //update generalFilter Coefficients
+    //choices:: peak, bandpass, notch, allpass
+    auto genMode = static_cast<int>(control(StateParam::GeneralFilterMode));
+    auto genHz = control(StateParam::GeneralFilterFreq);
+    auto genQ = control(StateParam::GeneralFilterQuality);
+    auto genGain = control(StateParam::GeneralFilterGain);
+    
+    bool filterChanged = false;
+    filterChanged |= (filterFreq != genHz);
+    filterChanged |= (filterQ != genQ);
+    filterChanged |= (filterGain != genGain);
+    
+    auto updatedMode = static_cast<GeneralFilterMode>(genMode);
+    const auto modeChanged = filterMode != updatedMode;
+    filterChanged |= modeChanged;
+    
+    if( filterChanged )
+    {
+        filterMode = updatedMode;
+        filterFreq = genHz;
+        filterQ = genQ;
+        filterGain = genGain;
+        
+        //the ArrayCoefficients functions return a std::array, where the Coefficients ones allocate a new object
+        std::optional<std::array<float, 6>> coefficients;
+        switch(filterMode)
+        {
+            case GeneralFilterMode::Peak:
+            {
+                coefficients = juce::dsp::IIR::ArrayCoefficients<float>::makePeakFilter(sampleRate, filterFreq, filterQ, juce::Decibels::decibelsToGain(filterGain));
+                break;
+            }
+            case GeneralFilterMode::Bandpass:
+            {
+                coefficients = juce::dsp::IIR::ArrayCoefficients<float>::makeBandPass(sampleRate, filterFreq, filterQ);
+                
+                break;
+            }
+            case GeneralFilterMode::Notch:
+            {
+                coefficients = juce::dsp::IIR::ArrayCoefficients<float>::makeNotch(sampleRate, filterFreq, filterQ);
+                
+                break;
+            }
+            case GeneralFilterMode::Allpass:
+            {
+                coefficients = juce::dsp::IIR::ArrayCoefficients<float>::makeAllPass(sampleRate, filterFreq, filterQ);
+                
+                break;
+            }
+            case GeneralFilterMode::END_OF_LIST:
+            {
+                jassertfalse;
+                break;
+            }
+        }
+        
+        if( coefficients.has_value() )
+        {
+            /*
+             every mode is a biquad, so this overwrites the existing coefficients in place.
+             prepare() made them a biquad, so neither this nor reset() allocates.
+             the state carries over a glide or a modulated frequency, so a tick doesn't click.
+                it is only cleared for a new mode, whose state means something else.
+             */
+            *generalFilter.dsp.coefficients = *coefficients;
+            if( modeChanged )
+                generalFilter.reset();
+        }
+    }
+}
+
+void Project13AudioProcessor::MonoChannelDSP::prepareModule(DSP_Option option, const juce::dsp::ProcessSpec &spec)
+{
+    jassert(spec.numChannels == 1);
+    
+    const auto instance = getInstanceIndex(option);
+    const auto kind = getModuleKind(option);
+    
+    if( kind == DSP_Option::GeneralFilter )
+    {
+        /*
+         the filter's default coefficients are first order. making them a biquad here sizes the coefficient
+            and state storage once, so updateDSPFromParams() never allocates on the audio thread.
+         the mode forces the real coefficients to be computed on the first block.
+         */
+        *generalFilters[instance].dsp.coefficients = juce::dsp::IIR::ArrayCoefficients<float>::makeAllPass(spec.sampleRate, 1000.f, 0.7f);
+        filterSettings[instance].mode = GeneralFilterMode::END_OF_LIST;
+    }
+    
+    auto* processor = getProcessor(option);
+    processor->prepare(spec);
+    processor->reset();
+    
+    if( kind == DSP_Option::Overdrive )
+        overdrives[instance].dsp.setCutoffFrequencyHz(20000.f);
+}
+
+void Project13AudioProcessor::MonoChannelDSP::prepareRender(const juce::dsp::ProcessSpec& spec, bool highQuality)
+{
+    this->highQuality = highQuality;
+    
+    for( size_t i = 0; i < oversamplers.size(); ++i )
+    {
+        auto& oversampler = oversamplers[i];
+        if( highQuality == false || isOversampledOffline(static_cast<DSP_Option>(i)) == false )
+        {
+            oversampler.reset();
+            continue;
+        }
+        
+        if( oversampler == nullptr )
+        {
+            oversampler = std::make_unique<juce::dsp::Oversampling<float>>(1,
+                                                                           oversamplingOrder,
+                                                                           juce::dsp::Oversampling<float>::filterHalfBandFIREquiripple,
+                                                                           true,
+                                                                           true);
+        }
+        
+        oversampler->initProcessing(spec.maximumBlockSize);
+        oversampler->reset();
+    }
+    
+    //setPaddingForOrder() sets the delay for the order the chain plays
+    latencyDelaySamples = 0;
+    latencyDelay.prepare(spec);
+    latencyDelay.setMaximumDelayInSamples(highQuality ? juce::jmax(1, getRenderLatency()) : 1);
+    latencyDelay.setDelay(static_cast<float>(latencyDelaySamples));
+    latencyDelay.reset();
+}
+
+juce::dsp::Oversampling<float>* Project13AudioProcessor::MonoChannelDSP::getOversampler(DSP_Option option)
+{
+    auto idx = static_cast<size_t>(option);
+    return idx < oversamplers.size() ? oversamplers[idx].get() : nullptr;
+}
+
+void Project13AudioProcessor::MonoChannelDSP::releaseModule(DSP_Option option)
+{
+    if( option == DSP_Option::END_OF_LIST )
+    {
+        jassertfalse;
+        return;
+    }
+    
+    const auto instance = getInstanceIndex(option);
+    switch( getModuleKind(option) )
+    {
+        case DSP_Option::Phase: phasers[instance].release(); break;
+        case DSP_Option::Chorus: choruses[instance].release(); break;
+        case DSP_Option::Overdrive: overdrives[instance].release(); break;
+        case DSP_Option::LadderFilter: ladderFilters[instance].release(); break;
+        case DSP_Option::GeneralFilter: generalFilters[instance].release(); break;
+        //getModuleKind() only returns first instances
+        case DSP_Option::Phase2:
+        case DSP_Option::Chorus2:
+        case DSP_Option::Overdrive2:
+        case DSP_Option::LadderFilter2:
+        case DSP_Option::GeneralFilter2:
+        case DSP_Option::END_OF_LIST:
+            jassertfalse;
+            break;
+    }
+}
+
+bool Project13AudioProcessor::MonoChannelDSP::isReady(DSP_Option option) const
+{
+    auto idx = static_cast<size_t>(option);
+    return idx < p.modulesReady.size() && p.modulesReady[idx];
+}
+
+void Project13AudioProcessor::MonoChannelDSP::reset()
+{
+    delay.reset();
+    latencyDelay.reset();
+    
+    for( auto& oversampler : oversamplers )
+    {
+        if( oversampler != nullptr )
+            oversampler->reset();
+    }
+    
+    for( size_t i = 0; i < numDSPOptions; ++i )
+    {
+        auto option = static_cast<DSP_Option>(i);
+        if( isReady(option) )
+            getProcessor(option)->reset();
+    }
+    
+    for( auto& settings : filterSettings )
+        settings.mode = GeneralFilterMode::END_OF_LIST;
+}
+
+void Project13AudioProcessor::releaseResources()
+{
+    // When playback stops, you can use this as an opportunity to free up any
+    // spare memory, etc.
+    
+    //a stopped instance doesn't count towards the global load
+    governor.reset();
+}
+
+#ifndef JucePlugin_PreferredChannelConfigurations
+bool Project13AudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts) const
+{
+  #if JucePlugin_IsMidiEffect
+    juce::ignoreUnused (layouts);
+    return true;
+  #else
+    // This is the place where you check if the layout is supported.
+    // In this template code we only support mono or stereo.
+    // Some plugin hosts, such as certain GarageBand versions, will only
+    // load plugins that support stereo bus layouts.
+    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
+     && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
+        return false;
+
+    // This checks if the input layout matches the output layout
+   #if ! JucePlugin_IsSynth
+    if (layouts.getMainOutputChannelSet() != layouts.getMainInputChannelSet())
+        return false;
+    
+    //the sidechain is optional, and only ever measured, so mono or stereo both work
+    if( layouts.inputBuses.size() > 1 )
+    {
+        const auto sidechain = layouts.getChannelSet(true, 1);
+        if( sidechain.isDisabled() == false
+           && sidechain != juce::AudioChannelSet::mono()
+           && sidechain != juce::AudioChannelSet::stereo() )
+            return false;
+    }
+   #endif
+
+    return true;
+  #endif
+}
+#endif
+
+juce::AudioProcessorValueTreeState::ParameterLayout
+    Project13AudioProcessor::createParameterLayout()
+{
+        juce::AudioProcessorValueTreeState::ParameterLayout layout;
+        
+//        name = nameFunction();
+//        layout.add( std::make_unique<juce::AudioParameterFloat>(
+//            juce::ParameterID { name, versionHint },
+//            name,
+//            parameterRange,
+//            defaultValue,
+//            unitSuffix
+//        );
+        
+    const int versionHint = 1;
+    
+    //the second module instances copy the first instances' parameters, so they are kept track of as they are added
+    std::map<juce::String, juce::RangedAudioParameter*> added;
+    auto add = [&layout, &added](std::unique_ptr<juce::RangedAudioParameter> param)
+    {
+        added[param->paramID] = param.get();
+        layout.add(std::move(param));
+    };
+    /*
+     Phaser:
+     Rate: hz
+     Depth: 0 to 1
+     Center Freq: hz
+     Feedback: -1 to +1
+     Mix: 0 to 1
+    */
+    
+    auto name = getInputGainName();
+    add(std::make_unique<juce::AudioParameterFloat>(
+            juce::ParameterID{name, versionHint},
+            name,
+            juce::NormalisableRange<float>(-18.f, 18.f, 0.1f, 1.f),
+            0.f,
+            "dB"));
+        
+    name = getOutputGainName();
+    add(std::make_unique<juce::AudioParameterFloat>(
+            juce::ParameterID{name, versionHint},
+            name,
+            juce::NormalisableRange<float>(-18.f, 18.f, 0.1f, 1.f),
+            0.f,
+            "dB"));
+        
+    name = getPhaserRateName();
+    add(std::make_unique<juce::AudioParameterFloat>(
+          juce::ParameterID{name, versionHint},
+          name,
+          juce::NormalisableRange<float>(0.01f, 2.f, 0.01f, 1.f),
+          0.2f,
+          "Hz"));
+        
+    //phaser depth: 0 - 100
+    name = getPhaserDepthName();
+    add(std::make_unique<juce::AudioParameterFloat>(
+          juce::ParameterID{name, versionHint},
+          name,
+          juce::NormalisableRange<float>(0.0f, 100.f, 0.1f, 1.f),
+          5.f,
+          "%"));
+        
+    //phaser center freq: audio hz
+    name = getPhaserCenterFreqName();
+    add(std::make_unique<juce::AudioParameterFloat>(
+          juce::ParameterID{name, versionHint},
+          name,
+          juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 1.f),
+          1000.f,
+          "Hz"));
+          
+    //phaser feedback: -1 to 1
+    name = getPhaserFeedbackName();
+    add(std::make_unique<juce::AudioParameterFloat>(
+          juce::ParameterID{name, versionHint},
+          name,
+          juce::NormalisableRange<float>(-100.f, 100.f, 0.1f, 1.f),
+          0.0f,
+          "Hz"));
+        
+    //phaser mix: 0 - 1
+    name = getPhaserMixName();
+    add(std::make_unique<juce::AudioParameterFloat>(
+          juce::ParameterID{name, versionHint},
+          name,
+          juce::NormalisableRange<float>(0.0f, 100.f, 0.1f, 1.f),
+          5.f,
+          "%"));
+    name = getPhaserBypassName();
+        add(std::make_unique<juce::AudioParameterBool>(juce::ParameterID{name, versionHint},
+              name, false));
+        
+    /*
+     Chorus:
+     Rate: hz
+     Depth: 0 to 1
+     Center delay: ms (1 to 100)
+     Feedback: -1 to +1
+     Mix: 0 to 1
+    */
+        
+    //Rate: Hz
+    name = getChorusRateName();
+    add(std::make_unique<juce::AudioParameterFloat>(
+          juce::ParameterID{name, versionHint},
+          name,
+          juce::NormalisableRange<float>(0.01f, 100.f, 0.01f, 1.f),
+          0.2f,
+          "Hz"));
+    
+    //Depth: 0 to 1
+    name = getChorusDepthName();
+    add(std::make_unique<juce::AudioParameterFloat>(
+          juce::ParameterID{name, versionHint},
+          name,
+          juce::NormalisableRange<float>(0.0f, 100.f, 0.1f, 1.f),
+          5.f,
+          "%"));
+        
+    //Center Delay: milliseconds (1 to 100)
+    name = getChorusCenterDelayName();
+    add(std::make_unique<juce::AudioParameterFloat>(
+          juce::ParameterID{name, versionHint},
+          name,
+          juce::NormalisableRange<float>(1.f, 100.f, 0.1f, 1.f),
+          7.f,
+          "ms"));
+        
+    //Feedback: -1 to 1
+    name = getChorusFeedbackName();
+    add(std::make_unique<juce::AudioParameterFloat>(
+          juce::ParameterID{name, versionHint},
+          name,
+          juce::NormalisableRange<float>(-100.f, 100.f, 0.1f, 1.f),
+          0.0f,
+          "%"));
+        
+    //Mix: 0 to 1
+    name = getChorusMixName();
+    add(std::make_unique<juce::AudioParameterFloat>(
+          juce::ParameterID{name, versionHint},
+          name,
+          juce::NormalisableRange<float>(0.0f, 100.f, 0.1f, 1.f),
+          5.f,
+          "%"));
+    name = getChorusBypassName();
+        add(std::make_unique<juce::AudioParameterBool>(juce::ParameterID{name, versionHint},
+              name, false));
+        
+    /*
+     overdrive
+     uses the drive portion of the ladder filter class for now
+     drive: 1-100
+    */
+    //drive: 1-100
+    name = getOverdriveSaturationName();
+    add(std::make_unique<juce::AudioParameterFloat>(
+          juce::ParameterID{name, versionHint},
+          name,
+          juce::NormalisableRange<float>(1.f, 100.f, 0.1f, 1.f),
+          1.f,
+          ""));
+    name = getOverdriveBypassName();
+        add(std::make_unique<juce::AudioParameterBool>(juce::ParameterID{name, versionHint},
+              name, false));
+
+    /*
+     ladder filter
+     mode: LadderFilterMode enum (int)
+     cutoff: hz
+     resonance: 0 to 1
+     drive: 1 - 100
+     */
+        
+    name = getLadderFilterModeName();
+    auto choices = getLadderFilterChoices();
+    add(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID{name, versionHint}, name, choices, 0));
+        
+    name = getLadderFilterCutoffName();
+    add(std::make_unique<juce::AudioParameterFloat>(
+          juce::ParameterID{name, versionHint},
+          name,
+          juce::NormalisableRange<float>(20.f, 20000.f, 0.1f, 1.f),
+          20000.f,
+          "Hz"));
+        
+    name = getLadderFilterResonanceName();
+    add(std::make_unique<juce::AudioParameterFloat>(
+          juce::ParameterID{name, versionHint},
+          name,
+          juce::NormalisableRange<float>(0.f, 100.f, 0.1f, 1.f),
+          0.f,
+          "%"));
+        
+    name = getLadderFilterDriveName();
+    add(std::make_unique<juce::AudioParameterFloat>(
+          juce::ParameterID{name, versionHint},
+          name,
+          juce::NormalisableRange<float>(1.f, 100.f, 0.1f, 1.f),
+          1.f,
+          ""));
+    name = getLadderFilterBypassName();
+        add(std::make_unique<juce::AudioParameterBool>(juce::ParameterID{name, versionHint},
+              name, false));
+        
+    /*
+     general filter: https://docs.juce.com/develop/sructdsp_1_1IIR_1_1Coefficients.html
+     Mode: Peak, Bandpass, Notch, Allpass,
+     Freq: 20hz - 20,000hz in 1hz steps
+     Q: 0.1 - 10 in 0.05 steps
+     Gain: -24db to +24db in 0.5db increments
+     */
+    //mode
+    name = getGeneralFilterModeName();
+    choices = getGeneralFilterChoices();
+    add(std::make_unique<juce::AudioParameterChoice>(
+         juce::ParameterID{name, versionHint}, name, choices, 0));
+    //freq: 20 - 20Khz in 1hz steps
+    name = getGeneralFilterFreqName();
+    add(std::make_unique<juce::AudioParameterFloat>(
+          juce::ParameterID{name, versionHint},
+          name,
+          juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 1.f),
+          750.f,
+          "Hz"));
+   //quality: 0.01 - 100 in 0.01 steps
+    name = getGeneralFilterQualityName();
+    add(std::make_unique<juce::AudioParameterFloat>(
+          juce::ParameterID{name, versionHint},
+          name,
+          juce::NormalisableRange<float>(0.01f, 100.f, 0.01f, 1.f),
+          0.72f,
+          ""));
+    //gain: -24db to +24db in 0.5db increments
+    name = getGeneralFilterGainName();
+    add(std::make_unique<juce::AudioParameterFloat>(
+          juce::ParameterID{name, versionHint},
+          name,
+          juce::NormalisableRange<float>(-24.f, 24.f, 0.5f, 1.f),
+          0.f,
+          "dB"));
+    name = getGeneralFilterBypassName();
+        add(std::make_unique<juce::AudioParameterBool>(juce::ParameterID{name, versionHint},
+              name, false));
+        
+    /*
+     crossfade mode: fades between two chains when the DSP order, a preset or the state changes.
+     time: 5ms - 500ms
+     */
+    name = getCrossfadeModeName();
+    add(std::make_unique<juce::AudioParameterBool>(juce::ParameterID{name, versionHint},
+                                                          name, false));
+    name = getCrossfadeTimeName();
+    add(std::make_unique<juce::AudioParameterFloat>(
+          juce::ParameterID{name, versionHint},
+          name,
+          juce::NormalisableRange<float>(5.f, 500.f, 1.f, 1.f),
+          50.f,
+          "ms"));
+        
+    /*
+     morph: 0% - 100%, blends between morph snapshots A and B
+     */
+    name = getMorphName();
+    add(std::make_unique<juce::AudioParameterFloat>(
+          juce::ParameterID{name, versionHint},
+          name,
+          juce::NormalisableRange<float>(0.f, 100.f, 0.1f, 1.f),
+          0.f,
+          "%"));
+    name = getMorphEnabledName();
+    add(std::make_unique<juce::AudioParameterBool>(juce::ParameterID{name, versionHint},
+                                                          name, false));
+        
+    name = getSelectedTabName();
+    add(std::make_unique<juce::AudioParameterInt>(juce::ParameterID{name, versionHint},
+                                                         name,
+                                                         0,
+                                                         static_cast<int>(maxChainSlots) - 1,
+                                                         static_cast<int>(DSP_Option::Chorus)));
+    
+    /*
+     Mid/side mode: the chain processes mid on the left and side on the right.
+     the module bypasses then apply to mid, and each module has a side bypass of its own.
+     the side bypasses do nothing in stereo mode.
+     these come last so the host's indexes of the older parameters don't move.
+     */
+    name = getMidSideModeName();
+    add(std::make_unique<juce::AudioParameterBool>(juce::ParameterID{name, versionHint},
+                                                          name, false));
+    
+    for( const auto& sideBypassName : { getPhaserSideBypassName(),
+                                        getChorusSideBypassName(),
+                                        getOverdriveSideBypassName(),
+                                        getLadderFilterSideBypassName(),
+                                        getGeneralFilterSideBypassName() } )
+    {
+        add(std::make_unique<juce::AudioParameterBool>(juce::ParameterID{sideBypassName, versionHint},
+                                                              sideBypassName, false));
+    }
+    
+    /*
+     the second module instances: a copy of each of moduleParams, with the instance number on the end of the name.
+     they start out bypassed, so a session that doesn't use them doesn't prepare them.
+     these come last for the same reason.
+     */
+    auto firstNames = getFirstInstanceParamNames();
+    for( size_t instance = 1; instance < numModuleInstances; ++instance )
+    {
+        for( auto stateParam : moduleParams )
+        {
+            auto* first = added[firstNames[static_cast<size_t>(stateParam)]];
+            jassert( first != nullptr );
+            name = getInstanceName(first->paramID, instance);
+            
+            if( auto* floatParam = dynamic_cast<juce::AudioParameterFloat*>(first) )
+            {
+                add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID{name, versionHint},
+                                                                name,
+                                                                floatParam->range,
+                                                                floatParam->convertFrom0to1(floatParam->getDefaultValue()),
+                                                                floatParam->getLabel()));
+            }
+            else if( auto* choiceParam = dynamic_cast<juce::AudioParameterChoice*>(first) )
+            {
+                add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID{name, versionHint},
+                                                                 name,
+                                                                 choiceParam->choices,
+                                                                 static_cast<int>(choiceParam->convertFrom0to1(choiceParam->getDefaultValue()))));
+            }
+            else if( dynamic_cast<juce::AudioParameterBool*>(first) != nullptr )
+            {
+                //the bypasses and the side bypasses
+                add(std::make_unique<juce::AudioParameterBool>(juce::ParameterID{name, versionHint},
+                                                               name, true));
+            }
+            else
+            {
+                jassertfalse;
+            }
+        }
+    }
+        
+    return layout;
+}
+
+std::vector< juce::RangedAudioParameter* > Project13AudioProcessor::getParamsForOption(DSP_Option option)
+{
+    if( option != DSP_Option::END_OF_LIST && getInstanceIndex(option) > 0 )
+    {
+        //the first instance's parameters, in the same order, swapped for this instance's copies
+        auto params = getParamsForOption(getModuleKind(option));
+        for( auto& param : params )
+        {
+            auto index = static_cast<size_t>(std::find(stateParams.begin(), stateParams.end(), param) - stateParams.begin());
+            jassert( index < numStateParams );
+            param = stateParams[static_cast<size_t>(getInstanceParam(static_cast<StateParam>(index), getInstanceIndex(option)))];
+        }
+        
+        return params;
+    }
+    
+    switch( option )
+    {
+        case DSP_Option::Phase:
+        {
+            return
+            {
+                phaserRateHz,
+                phaserCenterFreqHz,
+                phaserDepthPercent,
+                phaserFeedbackPercent,
+                phaserMixPercent,
+                phaserBypass,
+                phaserSideBypass,
+            };
+        }
+        case DSP_Option::Chorus:
+        {
+            return
+            {
+                chorusRateHz,
+                chorusDepthPercent,
+                chorusCenterDelayMs,
+                chorusFeedbackPercent,
+                chorusMixPercent,
+                chorusBypass,
+                chorusSideBypass,
+            };
+        }
+        case DSP_Option::Overdrive:
+        {
+            return
+            {
+                overdriveSaturation,
+                overdriveBypass,
+                overdriveSideBypass,
+            };
+        }
+        case DSP_Option::LadderFilter:
+        {
+            return
+            {
+                ladderFilterMode,
+                ladderFilterCutoffHz,
+                ladderFilterResonance,
+                ladderFilterDrive,
+                ladderFilterBypass,
+                ladderFilterSideBypass,
+            };
+        }
+        case DSP_Option::GeneralFilter:
+        {
+            return
+            {
+                generalFilterMode,
+                generalFilterFreqHz,
+                generalFilterQuality,
+                generalFilterGain,
+                generalFilterBypass,
+                generalFilterSideBypass,
+            };
+        }
+        //handled above
+        case DSP_Option::Phase2:
+        case DSP_Option::Chorus2:
+        case DSP_Option::Overdrive2:
+        case DSP_Option::LadderFilter2:
+        case DSP_Option::GeneralFilter2:
+        case DSP_Option::END_OF_LIST:
+            break;
+    }
+    
+    jassertfalse;
+    return { };
+        
+}
+
+void Project13AudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
+    juce::MidiBuffer& midiMessages)
+{
+    processBlockWithParameterEvents(buffer, midiMessages, {});
+}
+
+void Project13AudioProcessor::processBlockWithParameterEvents(juce::AudioBuffer<float>& buffer,
+                                                              juce::MidiBuffer& midiMessages,
+                                                              std::span<const ParameterEvent> events)
+{
+    juce::ScopedNoDenormals noDenormals;
+    const auto callStart = beginProfileBlock();
+    auto totalNumInputChannels  = getTotalNumInputChannels();
+    auto totalNumOutputChannels = getTotalNumOutputChannels();
+    
+    // In case we have more outputs than inputs, this code clears any output
+    // channels that didn't contain input data, (because these aren't
+    // guaranteed to be empty - they may contain garbage).
+    // This is here to avoid people getting screaming feedback
+    // when they first compile a plugin, but obviously you don't need to keep
+    // this code if your algorithm always overwrites all the output channels.
+    
+    for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
+        buffer.clear (i, 0, buffer.getNumSamples());
+    
+    //[DONE]: add APVTS
+    //[DONE]: create audio parameters for all dsp choices
+    //[DONE]: update DSP here from audio parameters
+    //[DONE]: bypass params for each DSP element
+    //[DONE]: update general filter coefficients
+    //[DONE]: add smoothers for all param updates
+    //[DONE]: save/load settings
+    //[DONE]: save/load DSP order
+    //[DONE]: Bypass DSP
+    //[DONE]: filters are mono, not stereo.
+    //[DONE]: prepare all DSP
+    //[DONE]: Drag-To_Reorder GUI
+    //[DONE]: snap dropped tabs to the correct position
+    //[DONE]: hide dragged tab image or stop dragging the tab and constrain dragged image to x axis only
+    //[DONE]: restore tabs in GUI when loading settings
+    //[DONE]: replace vertical sliders with SimpleMBComp rotary Sliders
+    //[DONE]: replace bypass buttons with SimpleMBComp combobox
+    //[DONE]: restore tab order when window opens
+    //[DONE]: restore selected tab when window opens
+    //[DONE]: Restore tab order when window opens first time (after quit)
+    //[DONE]: Restore tabs when closing/opening window (no quit)
+    //[DONE]: Restore selected tab when closing/opening window (no quit)
+    //[DONE]: replace Comboboxes with SimpleMBComp combobox
+    //[DONE]: mouse-down on tab (during drag should change DSP_Gui
+    //[DONE]: make selected tab more obvious
+    //[DONE]: restore selected tab when window opens
+    //[DONE]: bypass button should toggle RotarySlider enablement
+    //[DONE]: fix graphic issue when dragging tab over bypass button
+    //[DONE]: i/o gain controls
+    //[DONE]: add bypass button to tabs
+    //[DONE]: Added Spectrum Analyzer from SimpleMBComp
+    //[DONE]: GUI design for each DSP instance?
+    //[DONE]: metering
+    //[DONE]: save/load presets [BONUS]
+    //TODO: wet/dry knob [BONUS]
+    //TODO: mono & stereo versions [mono is BONUS]
+    //[DONE]: modulators [BONUS]
+    //TODO: thread-safe filter updating [BONUS]
+    //TODO: pre/post filtering [BONUS]
+    //TODO: delay module [BONUS]
+    
+    
+    /*
+     Fixed-quantum scheduling.
+     The control work runs once per control interval, counted across host calls: commands, state adoption,
+        parameter reads, smoothing and DSP updates. see runControlTick().
+     The host's block is cut wherever an interval ends or a parameter event happens, and everything in between
+        is audio work only, so a 16-sample host block pays for a quarter of a tick, and the output doesn't
+        depend on the host's block size.
+     While nothing changes and nothing is smoothing, there are no ticks at all.
+     */
+    const auto numSamples = buffer.getNumSamples();
+    /*
+     the sidechain's channels come after the main bus's in the buffer.
+     the chain only processes the main bus. the sidechain is only measured, by the envelope followers.
+     */
+    const auto numMainChannels = juce::jmin(buffer.getNumChannels(), getMainBusNumOutputChannels());
+    auto block = juce::dsp::AudioBlock<float>(buffer).getSubsetChannelBlock(0, static_cast<size_t>(numMainChannels));
+    auto sidechain = getSidechainBlock(buffer);
+    
+    //the host changed something before this call, so it applies from the first sample
+    if( isControlWorkPending() )
+        samplesUntilControlTick = 0;
+    
+    int startSample = 0;
+    size_t nextEvent = 0;
+    while( startSample < numSamples )
+    {
+        //the events for this sample are applied first, and the tick picks them up
+        auto eventDue = false;
+        while( nextEvent < events.size() && events[nextEvent].sampleOffset <= startSample )
+        {
+            applyParameterEvent(events[nextEvent++]);
+            eventDue = true;
+        }
+        
+        if( eventDue || samplesUntilControlTick <= 0 )
+            runControlTick();
+        
+        /*
+         figure out how many samples to actually process.
+         i.e., with a 64-sample interval and a host buffer size of 72, the first segment is 64 samples,
+             then a tick runs and the second segment is the remaining 8.
+         the tick after that comes 56 samples into the next host block.
+         an event in between cuts the segment short.
+         */
+        auto samplesToProcess = juce::jmin(numSamples - startSample, samplesUntilControlTick);
+        if( nextEvent < events.size() )
+            samplesToProcess = juce::jmin(samplesToProcess, events[nextEvent].sampleOffset - startSample);
+        
+        //a crossfade runs the incoming chain in crossfadeBuffer, which only holds the longest interval
+        if( crossfade.active )
+            samplesToProcess = juce::jmin(samplesToProcess, crossfadeBuffer.getNumSamples());
+        
+        const auto start = static_cast<size_t>(startSample);
+        const auto length = static_cast<size_t>(samplesToProcess);
+        processSegment(block.getSubBlock(start, length),
+                       sidechain.getNumChannels() > 0 ? sidechain.getSubBlock(start, length) : sidechain);
+        
+        startSample += samplesToProcess;
+        samplesUntilControlTick -= samplesToProcess;
+    }
+    
+    /*
+     meter and CPU frames are only sent while an editor is listening, at roughly its frame rate.
+     the meters show the RMS level since the last frame.
+     */
+    samplesUntilMeterFrame -= numSamples;
+    const auto frameDue = samplesUntilMeterFrame <= 0;
+    if( frameDue )
+        samplesUntilMeterFrame = static_cast<int>(getSampleRate() / 60.0);
+    
+    {
+        ScopedStageTimer timer(*this, ProfileStage::Metering);
+        if( analyzerEnabled && frameDue && meterWindow.numSamples > 0 )
+        {
+            auto rms = [this](size_t i) { return static_cast<float>(std::sqrt(meterWindow.squares[i] / meterWindow.numSamples)); };
+            
+            Event event;
+            event.type = Event::Type::Meters;
+            event.meters.leftPre = rms(0);
+            event.meters.rightPre = rms(1);
+            event.meters.leftPost = rms(2);
+            event.meters.rightPost = rms(3);
+            eventQueue.push(event);
+            
+            meterWindow = MeterWindow();
+        }
+        
+        if( analyzerEnabled && QualityGovernor::isAnalyzerFed(qualityTier) )
+        {
+            liveAnalyzerFifos->left.update(buffer);
+            liveAnalyzerFifos->right.update(buffer);
+        }
+    }
+    
+    finishProfileBlock(numSamples, frameDue, callStart);
+}
+
+bool Project13AudioProcessor::isControlWorkPending() const
+{
+    return controlChanges.load(std::memory_order_acquire) != seenControlChanges
+        || resetRequested.load(std::memory_order_relaxed)
+        || commandQueue.getNumReady() > 0
+        || pendingState.load(std::memory_order_relaxed) != nullptr
+        || getLatestOrder() != lastReportedOrder
+        || qualityTier != reportedQualityTier;
+}
+
+void Project13AudioProcessor::applyParameterEvent(const ParameterEvent& event)
+{
+    auto index = static_cast<size_t>(event.param);
+    if( index >= stateParams.size() )
+    {
+        jassertfalse;
+        return;
+    }
+    
+    /*
+     telling the listeners would take a lock on the audio thread, so setValue() doesn't notify anyone.
+     the parameter is marked instead, and the timer notifies its listeners on the message thread,
+        so the APVTS state and the editor catch up within a timer interval.
+     */
+    auto* param = stateParams[index];
+    param->setValue(param->convertTo0to1(event.value));
+    eventChangedParams[index].store(true, std::memory_order_release);
+    //the tick this event is due at reads it, and the control state counts as changed, like after a listener callback
+    controlChanges.fetch_add(1, std::memory_order_release);
+}
+
+void Project13AudioProcessor::notifyEventChangedParams()
+{
+    for( size_t i = 0; i < numStateParams; ++i )
+    {
+        if( eventChangedParams[i].exchange(false, std::memory_order_acq_rel) )
+        {
+            //the latest value, if more events changed it since
+            auto* param = stateParams[i];
+            param->sendValueChangedMessageToListeners(param->getValue());
+        }
+    }
+}
+
+void Project13AudioProcessor::runControlTick()
+{
+    //every change made up to here is read by this tick
+    seenControlChanges = controlChanges.load(std::memory_order_acquire);
+    
+    //modules the message thread finished preparing since the last tick join in from here
+    refreshModulesReady();
+    
+    //temp instance to pull into
+    auto newDSPOrder = DSP_Order();
+    auto snapshotRequested = false;
+    
+    //a reset goes before the commands, so an order sent after it isn't cut short
+    if( resetRequested.exchange(false, std::memory_order_acq_rel) )
+        resetChains();
+    
+    //commands go first, so a state published after them wins
+    handleCommands(newDSPOrder, snapshotRequested);
+    
+    auto stateArrived = adoptPublishedState();
+    refreshLiveParams();
+    
+    //if you pulled, or the state changed, switch to the new order.  This crossfades if Crossfade Mode is on.
+    //a newly adopted state brings its own order, which wins over a tab drag from the same block
+    if( stateArrived && isValidOrder(adoptedState->snapshot.order) )
+        newDSPOrder = adoptedState->snapshot.order;
+    
+    if( newDSPOrder != DSP_Order() || stateArrived )
+        changeOrder(newDSPOrder != DSP_Order() ? newDSPOrder : getLatestOrder(), stateArrived);
+    
+    if( std::exchange(morphSwitched, false) )
+        changeOrder(getLatestOrder(), true, true);
+    
+    /*
+     the chains' delay lines and filters hold the other mode's signal after a switch,
+        so the chains crossfade into the new mode from a reset chain.
+        the pair that starts next, now or when the current fade ends, takes the new mode.
+     */
+    if( liveBool(StateParam::MidSideMode) != midSideActive )
+    {
+        midSideActive = ! midSideActive;
+        changeOrder(getLatestOrder(), true, true);
+    }
+    
+    /*
+     the editor builds its tabs from OrderChanged events.
+     one is sent whenever the order changes, and when a newly opened editor asks for a snapshot.
+     */
+    reportOrder(snapshotRequested);
+    reportQuality(snapshotRequested);
+    
+    /*
+     the interval is the quantum at full quality, longer when the quality governor has stepped down,
+        and a single sample in an offline render while a parameter is moving.
+     */
+    auto smoothers = getSmoothers();
+    auto isSmoothing = [&smoothers]()
+    {
+        return std::any_of(smoothers.begin(), smoothers.end(), [](auto* s) { return s->isSmoothing(); });
+    };
+    
+    auto interval = QualityGovernor::getControlInterval(qualityTier);
+    if( isNonRealtime() )
+    {
+        //the targets are set first, so a new one counts right away
+        updateSmoothersFromParams(0, SmootherUpdateMode::liveInRealtime);
+        if( isSmoothing() )
+            interval = 1;
+    }
+    
+    //advance each smoother, and the modulators, to the end of the interval
+    updateSmoothersFromParams(interval, SmootherUpdateMode::liveInRealtime);
+    modMatrix.advance(interval);
+    updateControlValues();
+    
+    //the gain stages ramp to the new values over the interval
+    inputGainDSP.setGainDecibels(control(StateParam::InputGain));
+    outputGainDSP.setGainDecibels(control(StateParam::OutputGain));
+    
+    //the outgoing chain of a crossfade is frozen on its old settings, so a preset change doesn't audibly jump
+    if( crossfade.active )
+        updateIncomingChain();
+    else
+    {
+        activeChain.left->updateDSPFromParams(activeChain.midSide);
+        activeChain.right->updateDSPFromParams(activeChain.midSide);
+    }
+    
+    //once the smoothers have arrived, the DSP is up to date until something changes. modulation never arrives.
+    samplesUntilControlTick = isSmoothing() || modMatrix.isActive() ? interval : noControlTickScheduled;
+}
+
+void Project13AudioProcessor::MeterWindow::accumulate(const juce::dsp::AudioBlock<float>& block, size_t first)
+{
+    for( size_t ch = 0; ch < juce::jmin<size_t>(2, block.getNumChannels()); ++ch )
+    {
+        const auto* samples = block.getChannelPointer(ch);
+        double sum = 0.0;
+        for( size_t i = 0; i < block.getNumSamples(); ++i )
+            sum += static_cast<double>(samples[i]) * samples[i];
+        
+        squares[first + ch] += sum;
+    }
+}
+
+void Project13AudioProcessor::updateIncomingChain()
+{
+    incomingChain.left->updateDSPFromParams(incomingChain.midSide);
+    incomingChain.right->updateDSPFromParams(incomingChain.midSide);
+    incomingChainStale = false;
+}
+
+juce::dsp::AudioBlock<float> Project13AudioProcessor::getSidechainBlock(juce::AudioBuffer<float>& buffer)
+{
+    auto* bus = getBus(true, 1);
+    if( bus == nullptr || bus->isEnabled() == false )
+        return {};
+    
+    const auto first = bus->getChannelIndexInProcessBlockBuffer(0);
+    const auto count = bus->getNumberOfChannels();
+    //some hosts pass fewer channels than the layout says while the sidechain isn't connected
+    if( count == 0 || first + count > buffer.getNumChannels() )
+        return {};
+    
+    return juce::dsp::AudioBlock<float>(buffer).getSubsetChannelBlock(static_cast<size_t>(first), static_cast<size_t>(count));
+}
+
+void Project13AudioProcessor::processSegment(juce::dsp::AudioBlock<float> segment, juce::dsp::AudioBlock<float> sidechainSegment)
+{
+    /*
+     while one pair of chains is in mid/side mode and the other isn't, the gain stages stay in left/right
+        and each pair encodes and decodes its own signal.
+     decided up front, because a crossfade that ends in processChains() swaps the pairs.
+     */
+    const auto matrixPerChain = crossfade.active && activeChain.midSide != incomingChain.midSide;
+    const auto midSide = matrixPerChain == false && activeChain.midSide;
+    
+    {
+        ScopedStageTimer timer(*this, ProfileStage::InputGain);
+        inputGainDSP.process(segment, midSide ? GainStage::Matrix::EncodeMidSide : GainStage::Matrix::None);
+    }
+    
+    //in mid/side mode the input meters and the envelope followers on the main input see mid and side
+    
+    if( analyzerEnabled )
+    {
+        ScopedStageTimer timer(*this, ProfileStage::Metering);
+        meterWindow.accumulate(segment, 0);
+    }
+    
+    //the envelope followers hear what the chain hears, or the sidechain. the next tick picks up their levels.
+    modMatrix.follow(segment, sidechainSegment);
+    
+    processChains(segment, matrixPerChain);
+    
+    {
+        ScopedStageTimer timer(*this, ProfileStage::OutputGain);
+        outputGainDSP.process(segment, midSide ? GainStage::Matrix::DecodeMidSide : GainStage::Matrix::None);
+    }
+    
+    if( analyzerEnabled )
+    {
+        ScopedStageTimer timer(*this, ProfileStage::Metering);
+        meterWindow.accumulate(segment, 2);
+        meterWindow.numSamples += static_cast<int>(segment.getNumSamples());
+    }
+}
+
+std::chrono::steady_clock::time_point Project13AudioProcessor::beginProfileBlock()
+{
+    telemetryRunning = PROJECT13_PROFILE_DSP && telemetry.isEnabled();
+    stageTimingEnabled = PROJECT13_PROFILE_DSP && (profilingEnabled || telemetryRunning);
+    
+    //offline renders have no deadline, so they always get full quality
+    governorRunning = isNonRealtime() == false;
+    qualityTier = governorRunning ? governor.getTier() : QualityGovernor::Tier::Full;
+    
+    return telemetryRunning || governorRunning ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+}
+
+void Project13AudioProcessor::finishProfileBlock(int numSamples, bool frameDue, std::chrono::steady_clock::time_point callStart)
+{
+    if( telemetryRunning || governorRunning )
+    {
+        auto callNs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - callStart).count();
+        
+        if( telemetryRunning )
+        {
+            auto startNs = std::chrono::duration_cast<std::chrono::nanoseconds>(callStart.time_since_epoch()).count();
+            telemetry.record(numSamples, getSampleRate(), startNs, callNs, getSlowestStage(callNs));
+        }
+        
+        //the new tier applies from the next block
+        if( governorRunning )
+            governor.update(numSamples, getSampleRate(), callNs);
+    }
+    
+    if( stageTimingEnabled == false )
+        return;
+    
+    //ConfigureProfiling can turn the CpuFrames off in the middle of a timed block
+    if( profilingEnabled == false )
+    {
+        blockStageNs.fill(0);
+        return;
+    }
+    
+    const auto audioNs = static_cast<double>(numSamples) / getSampleRate() * 1.0e9;
+    for( size_t i = 0; i < numProfileStages; ++i )
+    {
+        windowStageNs[i] += blockStageNs[i];
+        windowStagePeak[i] = juce::jmax(windowStagePeak[i], static_cast<float>(static_cast<double>(blockStageNs[i]) / audioNs));
+        blockStageNs[i] = 0;
+    }
+    
+    windowAudioNs += audioNs;
+    if( frameDue == false )
+        return;
+    
+    Event event;
+    event.type = Event::Type::Cpu;
+    event.cpu = CpuFrame();
+    for( size_t i = 0; i < numProfileStages; ++i )
+    {
+        event.cpu.average[i] = static_cast<float>(static_cast<double>(windowStageNs[i]) / windowAudioNs);
+        event.cpu.peak[i] = windowStagePeak[i];
+    }
+    
+    //a frame that doesn't fit is dropped. the next one covers its time as well.
+    if( eventQueue.push(event) )
+        clearProfile();
+}
+
+size_t Project13AudioProcessor::getSlowestStage(juce::int64 callNs) const
+{
+    auto slowest = numProfileStages;
+    auto untimedNs = callNs;
+    juce::int64 slowestNs = 0;
+    for( size_t i = 0; i < numProfileStages; ++i )
+    {
+        untimedNs -= blockStageNs[i];
+        if( blockStageNs[i] > slowestNs )
+        {
+            slowestNs = blockStageNs[i];
+            slowest = i;
+        }
+    }
+    
+    return untimedNs > slowestNs ? numProfileStages : slowest;
+}
+
+juce::String Project13AudioProcessor::getProfileStageName(ProfileStage stage)
+{
+    switch( stage )
+    {
+        case ProfileStage::Phase: return "phaser";
+        case ProfileStage::Chorus: return "chorus";
+        case ProfileStage::Overdrive: return "overdrive";
+        case ProfileStage::LadderFilter: return "ladder filter";
+        case ProfileStage::GeneralFilter: return "general filter";
+        case ProfileStage::Phase2: return "phaser 2";
+        case ProfileStage::Chorus2: return "chorus 2";
+        case ProfileStage::Overdrive2: return "overdrive 2";
+        case ProfileStage::LadderFilter2: return "ladder filter 2";
+        case ProfileStage::GeneralFilter2: return "general filter 2";
+        case ProfileStage::InputGain: return "input gain";
+        case ProfileStage::OutputGain: return "output gain";
+        case ProfileStage::Metering: return "metering";
+        case ProfileStage::END_OF_LIST: break;
+    }
+    
+    jassertfalse;
+    return {};
+}
+
+juce::StringArray Project13AudioProcessor::getTelemetryStageNames()
+{
+    juce::StringArray names;
+    for( size_t i = 0; i < numProfileStages; ++i )
+        names.add(getProfileStageName(static_cast<ProfileStage>(i)));
+    
+    //everything outside the timed stages: commands, state changes, smoothers, crossfades
+    names.add("other");
+    return names;
+}
+
+void Project13AudioProcessor::startTelemetryLog(const juce::File& file, int intervalSeconds)
+{
+    telemetryLogger.reset();
+    telemetryLogger = std::make_unique<DeadlineTelemetry::Logger>(telemetry, file, intervalSeconds);
+}
+
+void Project13AudioProcessor::clearProfile()
+{
+    blockStageNs.fill(0);
+    windowStageNs.fill(0);
+    windowStagePeak.fill(0.f);
+    windowAudioNs = 0.0;
+}
+
+void Project13AudioProcessor::handleCommands(DSP_Order& newDSPOrder, bool& snapshotRequested)
+{
+    Command command;
+    while( commandQueue.pop(command) )
+    {
+        switch( command.type )
+        {
+            case Command::Type::SetOrder:
+#if VERIFY_BYPASS_FUNCTIONALITY
+                jassertfalse;
+#endif
+                if( isValidOrder(command.order) )
+                    newDSPOrder = command.order;
+                break;
+            case Command::Type::ConfigureAnalyzer:
+                liveAnalyzerFifos = command.analyzer.fifos;
+                analyzerEnabled = liveAnalyzerFifos != nullptr;
+                //the fifos this replaced aren't touched anymore, so the message thread can free them
+                analyzerGenerationSeen.store(command.analyzer.generation, std::memory_order_release);
+                break;
+            case Command::Type::RequestSnapshot:
+                snapshotRequested = true;
+                break;
+            case Command::Type::SetMorphSnapshots:
+                liveMorph = command.morph;
+                break;
+            case Command::Type::SetModRouting:
+                modMatrix.setRouting(command.modulation);
+                break;
+            case Command::Type::ConfigureProfiling:
+                profilingEnabled = PROJECT13_PROFILE_DSP && command.profilingEnabled;
+                clearProfile();
+                break;
+        }
+    }
+}
+
+void Project13AudioProcessor::reportOrder(bool snapshotRequested)
+{
+    const auto& latest = getLatestOrder();
+    if( snapshotRequested == false && latest == lastReportedOrder )
+        return;
+    
+    Event event;
+    event.type = Event::Type::OrderChanged;
+    event.order = latest;
+    //if the queue is full, this is retried on the next block
+    if( eventQueue.push(event) )
+        lastReportedOrder = latest;
+}
+
+void Project13AudioProcessor::reportQuality(bool snapshotRequested)
+{
+    if( snapshotRequested == false && qualityTier == reportedQualityTier )
+        return;
+    
+    Event event;
+    event.type = Event::Type::Quality;
+    event.quality = qualityTier;
+    //if the queue is full, this is retried on the next block
+    if( eventQueue.push(event) )
+        reportedQualityTier = qualityTier;
+}
+
+void Project13AudioProcessor::resetChains()
+{
+    //a transition in progress is completed instantly
+    dspOrder = getLatestOrder();
+    crossfade = ChainCrossfade();
+    
+    for( auto* chain : { &leftChannel, &rightChannel, &leftFadeChannel, &rightFadeChannel } )
+        chain->reset();
+    
+    //a cleared pair can take on a mode it was switching to without a fade
+    activeChain.midSide = midSideActive;
+    activeChain.setPaddingForOrder(dspOrder);
+    
+    inputGainDSP.reset();
+    outputGainDSP.reset();
+    
+    //the LFOs restart with the transport, so a bounce starts on the same phase every time
+    modMatrix.reset();
+}
+
+void Project13AudioProcessor::reset()
+{
+    /*
+     hosts call this from the message thread, the audio thread, or a thread of their own.
+     the chains are only ever cleared by the audio thread, at the start of the next block.
+     */
+    resetRequested.store(true, std::memory_order_release);
+}
+
+const Project13AudioProcessor::DSP_Order& Project13AudioProcessor::getLatestOrder() const
+{
+    if( crossfade.queued )
+        return crossfade.queuedOrder;
+    
+    if( crossfade.active )
+        return crossfade.incomingOrder;
+    
+    return dspOrder;
+}
+
+void Project13AudioProcessor::changeOrder(const DSP_Order& newOrder, bool stateChanged, bool forceCrossfade)
+{
+    if( stateChanged == false && newOrder == getLatestOrder() )
+        return;
+    
+    //a pair can't change its mid/side mode while it is playing, so a switch into the other mode always fades
+    const auto& survivingPair = crossfade.active ? incomingChain : activeChain;
+    const auto modeKept = survivingPair.midSide == midSideActive;
+    
+    if( forceCrossfade == false && liveBool(StateParam::CrossfadeMode) == false && modeKept )
+    {
+        //instant switching.  any fade in progress is cut short, and whatever was queued behind it is dropped.
+        crossfade.queued = false;
+        if( crossfade.active )
+            finishCrossfade();
+        
+        dspOrder = newOrder;
+        activeChain.setPaddingForOrder(dspOrder);
+        return;
+    }
+    
+    if( crossfade.active )
+    {
+        /*
+         only 2 chains are ever running.
+         the latest change waits for the current fade to finish.
+         */
+        crossfade.queued = true;
+        crossfade.queuedOrder = newOrder;
+        return;
+    }
+    
+    /*
+     the incoming chain starts from silence so the delay lines of the phaser and chorus don't
+        carry over audio from the last time it was used.
+     */
+    incomingChain.left->reset();
+    incomingChain.right->reset();
+    incomingChain.midSide = midSideActive;
+    incomingChain.setPaddingForOrder(newOrder);
+    incomingChainStale = true;
+    
+    crossfade.active = true;
+    crossfade.incomingOrder = newOrder;
+    crossfade.samplesDone = 0;
+    crossfade.totalSamples = juce::jmax(1, juce::roundToInt(live(StateParam::CrossfadeTime) * 0.001 * getSampleRate()));
+}
+
+void Project13AudioProcessor::finishCrossfade()
+{
+    std::swap(activeChain, incomingChain);
+    dspOrder = crossfade.incomingOrder;
+    crossfade.active = false;
+    
+    if( crossfade.queued )
+    {
+        crossfade.queued = false;
+        changeOrder(crossfade.queuedOrder, true);
+    }
+}
+
+void Project13AudioProcessor::processChains(juce::dsp::AudioBlock<float> subBlock, bool matrixPerChain)
+{
+    //the DSP was updated by runControlTick()
+    if( crossfade.active == false )
+    {
+        activeChain.left->process(subBlock.getSingleChannelBlock(0), dspOrder);
+        activeChain.right->process(subBlock.getSingleChannelBlock(1), dspOrder);
+        return;
+    }
+    
+    const auto numSamples = static_cast<int>(subBlock.getNumSamples());
+    jassert(numSamples <= crossfadeBuffer.getNumSamples());
+    
+    auto fadeBlock = juce::dsp::AudioBlock<float>(crossfadeBuffer).getSubBlock(0, subBlock.getNumSamples());
+    fadeBlock.copyFrom(subBlock);
+    
+    //the pair in mid/side mode gets mid and side, and gives back left and right for the fade
+    auto& midSideBlock = activeChain.midSide ? subBlock : fadeBlock;
+    if( matrixPerChain )
+        GainStage::applyMatrix(midSideBlock, GainStage::Matrix::EncodeMidSide);
+    
+    /*
+     the outgoing chain is frozen on its old settings, so a preset change doesn't audibly jump.
+     the incoming chain follows the parameters as usual.
+     */
+    activeChain.left->process(subBlock.getSingleChannelBlock(0), dspOrder);
+    activeChain.right->process(subBlock.getSingleChannelBlock(1), dspOrder);
+    
+    //a queued crossfade that started after the last tick hasn't been updated yet
+    if( incomingChainStale )
+        updateIncomingChain();
+    
+    incomingChain.left->process(fadeBlock.getSingleChannelBlock(0), crossfade.incomingOrder);
+    incomingChain.right->process(fadeBlock.getSingleChannelBlock(1), crossfade.incomingOrder);
+    
+    if( matrixPerChain )
+        GainStage::applyMatrix(midSideBlock, GainStage::Matrix::DecodeMidSide);
+    
+    //equal-power: cos^2 + sin^2 = 1, so uncorrelated chains keep a constant level through the fade
+    const auto* tables = sharedTables.get();
+    for( size_t ch = 0; ch < juce::jmin(subBlock.getNumChannels(), fadeBlock.getNumChannels()); ++ch )
+    {
+        auto* out = subBlock.getChannelPointer(ch);
+        auto* in = fadeBlock.getChannelPointer(ch);
+        
+        for( int i = 0; i < numSamples; ++i )
+        {
+            auto position = juce::jmin(1.f, static_cast<float>(crossfade.samplesDone + i) / static_cast<float>(crossfade.totalSamples));
+            if( tables != nullptr )
+            {
+                out[i] = out[i] * tables->fadeOutGain(position) + in[i] * tables->fadeInGain(position);
+            }
+            else
+            {
+                //the tables aren't built yet
+                auto angle = position * juce::MathConstants<float>::halfPi;
+                out[i] = out[i] * std::cos(angle) + in[i] * std::sin(angle);
+            }
+        }
+    }
+    
+    crossfade.samplesDone += numSamples;
+    if( crossfade.samplesDone >= crossfade.totalSamples )
+        finishCrossfade();
+}
+
+void Project13AudioProcessor::MonoChannelDSP::process(juce::dsp::AudioBlock<float> block, const DSP_Order &dspOrder)
+{
+    DSP_Pointers dspPointers;
+    dspPointers.fill({}); //this was previously dspPointers.fill(nullptr);
+    
+    const auto numSlots = dspOrder.size();
+    for( size_t i = 0; i < numSlots; ++i )
+    {
+        //a module that isn't prepared yet is skipped. an offline render has them all prepared.
+        jassert( highQuality == false || isReady(dspOrder[i]) );
+        dspPointers[i].processor = isReady(dspOrder[i]) ? getProcessor(dspOrder[i]) : nullptr;
+        if( dspPointers[i].processor != nullptr )
+            dspPointers[i].bypassed = bypassed[static_cast<size_t>(dspOrder[i])];
+    }
+    //now process:
+    //auto block = juce::dsp::AudioBlock<float>(buffer);
+    
+    for( size_t i = 0; i < numSlots; ++i )
+   {
+       ScopedStageTimer timer(p, getProfileStage(dspOrder[i]));
+       
+       //in a high quality render the signal goes through the oversampler even if the module doesn't run, so the latency never changes
+       auto* oversampler = getOversampler(dspOrder[i]);
+       auto moduleBlock = oversampler != nullptr ? oversampler->processSamplesUp(block) : block;
+       auto context = juce::dsp::ProcessContextReplacing<float>(moduleBlock);
+       
+       if( dspPointers[i].processor != nullptr )
+       {
+           context.isBypassed = dspPointers[i].bypassed;
+           
+#if VERIFY_BYPASS_FUNCTIONALITY
+           if( context.isBypassed )
+           {
+               jassertfalse;
+           }
+           
+           if( getModuleKind(dspOrder[i]) != DSP_Option::GeneralFilter )
+#endif
+           dspPointers[i].processor->process(context);
+       }
+       
+       if( oversampler != nullptr )
+           oversampler->processSamplesDown(block);
+   }
+    
+    //the oversamplers of the instances that aren't in the order are made up for by latencyDelay
+    if( latencyDelaySamples > 0 )
+        latencyDelay.process(juce::dsp::ProcessContextReplacing<float>(block));
+}
+
+void Project13AudioProcessor::MonoChannelDSP::setPaddingForOrder(const DSP_Order& dspOrder)
+{
+    int oversampledSlots = 0;
+    for( size_t i = 0; i < dspOrder.size(); ++i )
+    {
+        if( getOversampler(dspOrder[i]) != nullptr )
+            ++oversampledSlots;
+    }
+    
+    //a high quality render of any order is delayed as much as a render through every oversampler
+    auto padding = highQuality ? getRenderLatency() - oversampledSlots * getOversamplingLatency() : 0;
+    if( padding != latencyDelaySamples )
+    {
+        latencyDelaySamples = padding;
+        latencyDelay.setDelay(static_cast<float>(latencyDelaySamples));
+    }
+}
+juce::dsp::ProcessorBase* Project13AudioProcessor::MonoChannelDSP::getProcessor(DSP_Option option)
+{
+    if( option == DSP_Option::END_OF_LIST )
+    {
+        jassertfalse;
+        return nullptr;
+    }
+    
+    const auto instance = getInstanceIndex(option);
+    switch (getModuleKind(option))
+    {
+        case DSP_Option::Phase:
+            return &phasers[instance];
+        case DSP_Option::Chorus:
+            return &choruses[instance];
+        case DSP_Option::Overdrive:
+            return &overdrives[instance];
+        case DSP_Option::LadderFilter:
+            return &ladderFilters[instance];
+        case DSP_Option::GeneralFilter:
+            return &generalFilters[instance];
+        //getModuleKind() only returns first instances
+        case DSP_Option::Phase2:
+        case DSP_Option::Chorus2:
+        case DSP_Option::Overdrive2:
+        case DSP_Option::LadderFilter2:
+        case DSP_Option::GeneralFilter2:
+        case DSP_Option::END_OF_LIST:
+            break;
+    }
+    
+    jassertfalse;
+    return nullptr;
+}
+
+Project13AudioProcessor::StateParam Project13AudioProcessor::getBypassParam(DSP_Option option)
+{
+    if( option == DSP_Option::END_OF_LIST )
+    {
+        jassertfalse;
+        return StateParam::END_OF_LIST;
+    }
+    
+    //the first instance's parameter, or its copy for this instance
+    auto instanceParam = [instance = getInstanceIndex(option)](StateParam param) { return getInstanceParam(param, instance); };
+    switch (getModuleKind(option))
+    {
+        case DSP_Option::Phase:
+            return instanceParam(StateParam::PhaserBypass);
+        case DSP_Option::Chorus:
+            return instanceParam(StateParam::ChorusBypass);
+        case DSP_Option::Overdrive:
+            return instanceParam(StateParam::OverdriveBypass);
+        case DSP_Option::LadderFilter:
+            return instanceParam(StateParam::LadderFilterBypass);
+        case DSP_Option::GeneralFilter:
+            return instanceParam(StateParam::GeneralFilterBypass);
+        case DSP_Option::Phase2:
+        case DSP_Option::Chorus2:
+        case DSP_Option::Overdrive2:
+        case DSP_Option::LadderFilter2:
+        case DSP_Option::GeneralFilter2:
+        case DSP_Option::END_OF_LIST:
+            break;
+    }
+    
+    jassertfalse;
+    return StateParam::END_OF_LIST;
+}
+
+Project13AudioProcessor::StateParam Project13AudioProcessor::getSideBypassParam(DSP_Option option)
+{
+    if( option == DSP_Option::END_OF_LIST )
+    {
+        jassertfalse;
+        return StateParam::END_OF_LIST;
+    }
+    
+    //the first instance's parameter, or its copy for this instance
+    auto instanceParam = [instance = getInstanceIndex(option)](StateParam param) { return getInstanceParam(param, instance); };
+    switch (getModuleKind(option))
+    {
+        case DSP_Option::Phase:
+            return instanceParam(StateParam::PhaserSideBypass);
+        case DSP_Option::Chorus:
+            return instanceParam(StateParam::ChorusSideBypass);
+        case DSP_Option::Overdrive:
+            return instanceParam(StateParam::OverdriveSideBypass);
+        case DSP_Option::LadderFilter:
+            return instanceParam(StateParam::LadderFilterSideBypass);
+        case DSP_Option::GeneralFilter:
+            return instanceParam(StateParam::GeneralFilterSideBypass);
+        case DSP_Option::Phase2:
+        case DSP_Option::Chorus2:
+        case DSP_Option::Overdrive2:
+        case DSP_Option::LadderFilter2:
+        case DSP_Option::GeneralFilter2:
+        case DSP_Option::END_OF_LIST:
+            break;
+    }
+    
+    jassertfalse;
+    return StateParam::END_OF_LIST;
+}
+
+bool Project13AudioProcessor::isModuleBypassed(DSP_Option option, bool sideChannel) const
+{
+    return liveBool(sideChannel ? getSideBypassParam(option) : getBypassParam(option));
+}
+
+void Project13AudioProcessor::prepareBenchmarkBlock(int numSamples, const ModuleSet& modules)
+{
+    refreshModulesReady();
+    for( size_t i = 0; i < numDSPOptions; ++i )
+    {
+        if( modules[i] && modulesReady[i] == false )
+        {
+            prepareModulesAhead(modules);
+            refreshModulesReady();
+            break;
+        }
+    }
+    
+    refreshLiveParams();
+    updateSmoothersFromParams(numSamples, SmootherUpdateMode::liveInRealtime);
+    modMatrix.advance(numSamples);
+    updateControlValues();
+    
+    activeChain.left->updateDSPFromParams(activeChain.midSide);
+    activeChain.right->updateDSPFromParams(activeChain.midSide);
+}
+
+void Project13AudioProcessor::benchmarkModule(juce::dsp::AudioBlock<float> block, DSP_Option option)
+{
+    ModuleSet module {};
+    module[static_cast<size_t>(option)] = true;
+    prepareBenchmarkBlock(static_cast<int>(block.getNumSamples()), module);
+    
+    if( modulesReady[static_cast<size_t>(option)] == false )
+        return;
+    
+    for( auto* chain : { activeChain.left, activeChain.right } )
+    {
+        auto channelBlock = block.getSingleChannelBlock(chain == activeChain.left ? 0 : 1);
+        auto context = juce::dsp::ProcessContextReplacing<float>(channelBlock);
+        context.isBypassed = isModuleBypassed(option, chain == activeChain.right && activeChain.midSide);
+        chain->getProcessor(option)->process(context);
+    }
+}
+
+void Project13AudioProcessor::benchmarkChain(juce::dsp::AudioBlock<float> block, const DSP_Order& order)
+{
+    jassert(isValidOrder(order));
+    prepareBenchmarkBlock(static_cast<int>(block.getNumSamples()), getModulesInOrder(order));
+    activeChain.setPaddingForOrder(order);
+    
+    activeChain.left->process(block.getSingleChannelBlock(0), order);
+    activeChain.right->process(block.getSingleChannelBlock(1), order);
+}
+//==============================================================================
+bool Project13AudioProcessor::hasEditor() const
+{
+    return true; // (change this to false if you choose to not supply an editor)
+}
+
+juce::AudioProcessorEditor* Project13AudioProcessor::createEditor()
+{
+    return new Project13AudioProcessorEditor (*this);
+    //return new juce::GenericAudioProcessorEditor(*this);
+}
+
+//==============================================================================
+template<>
+struct juce::VariantConverter<Project13AudioProcessor::DSP_Order>
+{
+    static Project13AudioProcessor::DSP_Order fromVar( const juce::var& v)
+    {
+        using T = Project13AudioProcessor::DSP_Order;
+        T dspOrder;
+        
+        //anything that doesn't decode stays an empty order, which isValidOrder() turns down
+        jassert(v.isBinaryData());
+        if( v.isBinaryData() )
+        {
+            auto mb = *v.getBinaryData();
+            juce::MemoryInputStream mis(mb, false);
+            std::vector<int> arr;
+            while( !mis.isExhausted() )
+            {
+                arr.push_back( mis.readInt() );
+            }
+            
+            //sessions from before the slot pool always hold the 5 modules
+            jassert( arr.size() >= 1 && arr.size() <= Project13AudioProcessor::maxChainSlots );
+            if( arr.size() <= Project13AudioProcessor::maxChainSlots )
+            {
+                for( auto option : arr )
+                    dspOrder.add(static_cast<Project13AudioProcessor::DSP_Option>(option));
+            }
+        }
+        return dspOrder;
+    }
+    
+    static juce::var toVar(const Project13AudioProcessor::DSP_Order& t)
+    {
+        juce::MemoryBlock mb;
+        //juce MOS uses scoping to complete writing to the memory block correctly
+        {
+            juce::MemoryOutputStream mos(mb, false);
+            
+            for( const auto& v : t )
+            {
+                mos.writeInt( static_cast<int>(v) );
+            }
+        }
+        return mb;
+    }
+};
+
+bool Project13AudioProcessor::isValidOrder(const DSP_Order& order)
+{
+    if( order.empty() )
+        return false;
+    
+    //every instance may appear at most once
+    std::array<bool, static_cast<size_t>(DSP_Option::END_OF_LIST)> seen {};
+    for( auto option : order )
+    {
+        auto idx = static_cast<size_t>(option);
+        if( idx >= seen.size() || seen[idx] )
+            return false;
+        
+        seen[idx] = true;
+    }
+    return true;
+}
+
+Project13AudioProcessor::DSP_Order Project13AudioProcessor::getDefaultOrder()
+{
+    DSP_Order order;
+    for( size_t i = 0; i < numModuleKinds; ++i )
+        order.add(static_cast<DSP_Option>(i));
+    
+    return order;
+}
+
+int Project13AudioProcessor::DSP_Order::indexOf(DSP_Option option) const
+{
+    auto it = std::find(begin(), end(), option);
+    return it == end() ? -1 : static_cast<int>(it - begin());
+}
+
+void Project13AudioProcessor::DSP_Order::insert(size_t index, DSP_Option option)
+{
+    jassert( isFull() == false && index <= numSlots );
+    if( isFull() || index > numSlots )
+        return;
+    
+    std::move_backward(slots.begin() + static_cast<std::ptrdiff_t>(index),
+                       slots.begin() + static_cast<std::ptrdiff_t>(numSlots),
+                       slots.begin() + static_cast<std::ptrdiff_t>(numSlots + 1));
+    slots[index] = option;
+    ++numSlots;
+}
+
+void Project13AudioProcessor::DSP_Order::remove(size_t index)
+{
+    jassert( index < numSlots );
+    if( index >= numSlots )
+        return;
+    
+    std::move(slots.begin() + static_cast<std::ptrdiff_t>(index + 1),
+              slots.begin() + static_cast<std::ptrdiff_t>(numSlots),
+              slots.begin() + static_cast<std::ptrdiff_t>(index));
+    --numSlots;
+    //the unused slots stay END_OF_LIST, so orders compare equal slot for slot
+    slots[numSlots] = DSP_Option::END_OF_LIST;
+}
+
+Project13AudioProcessor::StateSnapshot Project13AudioProcessor::getDefaultState() const
+{
+    StateSnapshot snapshot;
+    for( size_t i = 0; i < numStateParams; ++i )
+    {
+        auto* param = stateParams[i];
+        snapshot.values[i] = param->convertFrom0to1(param->getDefaultValue());
+    }
+    return snapshot;
+}
+
+Project13AudioProcessor::StateSnapshot Project13AudioProcessor::captureState() const
+{
+    StateSnapshot snapshot;
+    for( size_t i = 0; i < numStateParams; ++i )
+    {
+        auto* param = stateParams[i];
+        snapshot.values[i] = param->convertFrom0to1(param->getValue());
+    }
+    
+    const juce::ScopedLock sl(morphLock);
+    snapshot.order = requestedOrder;
+    snapshot.morph = morphSnapshots;
+    snapshot.modulation = modRouting;
+    return snapshot;
+}
+
+void Project13AudioProcessor::applyState(const StateSnapshot& snapshot)
+{
+    landState(snapshot, publishState(snapshot));
+}
+
+Project13AudioProcessor::StateSnapshot Project13AudioProcessor::stateFromValueTree(const juce::ValueTree& tree) const
+{
+    /*
+     the APVTS stores each parameter as a PARAM child with 'id' and 'value' (the denormalized value) properties.
+     */
+    auto snapshot = getDefaultState();
+    for( size_t i = 0; i < numStateParams; ++i )
+    {
+        auto child = tree.getChildWithProperty("id", stateParams[i]->paramID);
+        if( child.isValid() && child.hasProperty("value") )
+            snapshot.values[i] = static_cast<float>(child.getProperty("value"));
+    }
+    
+    if( tree.hasProperty("dspOrder") )
+    {
+        snapshot.order = juce::VariantConverter<Project13AudioProcessor::DSP_Order>::fromVar(tree.getProperty("dspOrder"));
+    }
+    
+    return snapshot;
+}
+
+void Project13AudioProcessor::getLegacyStateInformation(juce::MemoryBlock& destData)
+{
+    apvts.state.setProperty("dspOrder",
+                            juce::VariantConverter<Project13AudioProcessor::DSP_Order>::toVar(captureState().order),
+                            nullptr);
+    
+    juce::MemoryOutputStream mos(destData, false);
+    apvts.state.writeToStream(mos);
+}
+
+void Project13AudioProcessor::setLegacyStateInformation(const void* data, int sizeInBytes)
+{
+    auto tree = juce::ValueTree::readFromData(data, sizeInBytes);
+    if( tree.isValid() == false )
+        return;
+    
+    apvts.replaceState(tree);
+    
+    //the order went into a fifo for the next block, which costs next to nothing. decoding it is the part that counts.
+    if( apvts.state.hasProperty("dspOrder") )
+    {
+        auto order = juce::VariantConverter<Project13AudioProcessor::DSP_Order>::fromVar(apvts.state.getProperty("dspOrder"));
+        juce::ignoreUnused(order);
+    }
+    
+    DBG( apvts.state.toXmlString() );
+}
+
+void Project13AudioProcessor::getStateInformation (juce::MemoryBlock& destData)
+{
+    // You should use this method to store your parameters in the memory block.
+    // You could do that either as raw data, or use the XML or ValueTree classes
+    // as intermediaries to make it easy to save and load complex data.
+    
+    /*
+     hosts call this constantly (undo, autosave), so the state is written in the compact format
+        described in StateCodec.h instead of serializing the whole apvts.state ValueTree.
+     */
+    StateCodec::write(captureState(), destData);
+}
+
+void Project13AudioProcessor::setStateInformation (const void* data, int sizeInBytes)
+{
+    // You should use this method to restore your parameters from this memory block,
+    // whose contents will have been created by the getStateInformation() call.
+    
+    auto snapshot = getDefaultState();
+    
+    if( StateCodec::isCompactState(data, sizeInBytes) )
+    {
+        if( StateCodec::read(data, sizeInBytes, snapshot) == false )
+        {
+            //corrupt or from a newer, incompatible version. leave the current state alone.
+            jassertfalse;
+            return;
+        }
+    }
+    else
+    {
+        //sessions saved before the compact format existed contain the apvts ValueTree.
+        auto tree = juce::ValueTree::readFromData(data, sizeInBytes);
+        if( tree.isValid() == false )
+            return;
+        
+        snapshot = stateFromValueTree(tree);
+    }
+    
+    applyState(snapshot);
+        
+#if VERIFY_BYPASS_FUNCTIONALITY
+    juce::Timer::callAfterDelay(1000, [this]()
+    {
+        DSP_Order order;
+        order.add(DSP_Option::Chorus);
+        order.add(DSP_Option::LadderFilter);
+        
+        chorusBypass->setValueNotifyingHost(1.f);
+        sendCommand(Command::setOrder(order));
+    });
+#endif
+}
+
+//==============================================================================
+// This creates new instances of the plugin..
+juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
+{
+    return new Project13AudioProcessor();
+}
@@ -1,234 +1,1289 @@
-/*
-  ==============================================================================
-
-    This file contains the basic framework code for a JUCE plugin processor.
-
-  ==============================================================================
-*/
-
-#pragma once
-
-#include <JuceHeader.h>
-#include <Fifo.h>
-#include <SingleChannelSampleFifo.h>
-
-static constexpr int NEGATIVE_INFINITY = -72;
-static constexpr int MAX_DECIBELS = 12;
-
-enum class GeneralFilterMode
-{
-    Peak,
-    Bandpass,
-    Notch,
-    Allpass,
-    END_OF_LIST
-};
-//==============================================================================
-/**
-*/
-class Project13AudioProcessor  : public juce::AudioProcessor
-                            #if JucePlugin_Enable_ARA
-                             , public juce::AudioProcessorARAExtension
-                            #endif
-{
-public:
-    //==============================================================================
-    Project13AudioProcessor();
-    ~Project13AudioProcessor() override;
-
-    //==============================================================================
-    void prepareToPlay (double sampleRate, int samplesPerBlock) override;
-    void releaseResources() override;
-
-   #ifndef JucePlugin_PreferredChannelConfigurations
-    bool isBusesLayoutSupported (const BusesLayout& layouts) const override;
-   #endif
-
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
-
-    //==============================================================================
-    juce::AudioProcessorEditor* createEditor() override;
-    bool hasEditor() const override;
-
-    //==============================================================================
-    const juce::String getName() const override;
-
-    bool acceptsMidi() const override;
-    bool producesMidi() const override;
-    bool isMidiEffect() const override;
-    double getTailLengthSeconds() const override;
-
-    //==============================================================================
-    int getNumPrograms() override;
-    int getCurrentProgram() override;
-    void setCurrentProgram (int index) override;
-    const juce::String getProgramName (int index) override;
-    void changeProgramName (int index, const juce::String& newName) override;
-
-    //==============================================================================
-    void getStateInformation (juce::MemoryBlock& destData) override;
-    void setStateInformation (const void* data, int sizeInBytes) override;
-
-    enum class DSP_Option
-    {
-        Phase,
-        Chorus,
-        Overdrive,
-        LadderFilter,
-        GeneralFilter,
-        END_OF_LIST
-    };
-    
-    static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
-    juce::AudioProcessorValueTreeState apvts{ *this, nullptr, "Settings", createParameterLayout()};
-    
-    using DSP_Order = std::array<DSP_Option, static_cast<size_t>(DSP_Option::END_OF_LIST)>;
-    SimpleMBComp::Fifo<DSP_Order> dspOrderFifo, restoreDspOrderFifo;
-    
-    juce::AudioParameterFloat* phaserRateHz = nullptr;
-    juce::AudioParameterFloat* phaserCenterFreqHz = nullptr;
-    juce::AudioParameterFloat* phaserDepthPercent = nullptr;
-    juce::AudioParameterFloat* phaserFeedbackPercent = nullptr;
-    juce::AudioParameterFloat* phaserMixPercent = nullptr;
-    juce::AudioParameterBool* phaserBypass = nullptr;
-    
-    juce::AudioParameterFloat* chorusRateHz = nullptr;
-    juce::AudioParameterFloat* chorusDepthPercent = nullptr;
-    juce::AudioParameterFloat* chorusCenterDelayMs = nullptr;
-    juce::AudioParameterFloat* chorusFeedbackPercent = nullptr;
-    juce::AudioParameterFloat* chorusMixPercent = nullptr;
-    juce::AudioParameterBool* chorusBypass = nullptr;
-    
-    juce::AudioParameterFloat* overdriveSaturation = nullptr;
-    juce::AudioParameterBool* overdriveBypass = nullptr;
-    
-    juce::AudioParameterChoice* ladderFilterMode = nullptr;
-    juce::AudioParameterFloat* ladderFilterCutoffHz = nullptr;
-    juce::AudioParameterFloat* ladderFilterResonance = nullptr;
-    juce::AudioParameterFloat* ladderFilterDrive = nullptr;
-    juce::AudioParameterBool* ladderFilterBypass = nullptr;
-    
-    juce::AudioParameterChoice* generalFilterMode = nullptr;
-    juce::AudioParameterFloat* generalFilterFreqHz = nullptr;
-    juce::AudioParameterFloat* generalFilterQuality = nullptr;
-    juce::AudioParameterFloat* generalFilterGain = nullptr;
-    juce::AudioParameterBool* generalFilterBypass = nullptr;
-    
-    juce::AudioParameterInt* selectedTab = nullptr;
-    
-    juce::AudioParameterFloat* inputGain = nullptr;
-    juce::AudioParameterFloat* outputGain = nullptr;
-    
-    juce::SmoothedValue<float>
-    phaserRateHzSmoother,
-    phaserCenterFreqHzSmoother,
-    phaserDepthPercentSmoother,
-    phaserFeedbackPercentSmoother,
-    phaserMixPercentSmoother,
-    chorusRateHzSmoother,
-    chorusDepthPercentSmoother,
-    chorusCenterDelayMsSmoother,
-    chorusFeedbackPercentSmoother,
-    chorusMixPercentSmoother,
-    overdriveSaturationSmoother,
-    ladderFilterCutoffHzSmoother,
-    ladderFilterResonanceSmoother,
-    ladderFilterDriveSmoother,
-    generalFilterFreqHzSmoother,
-    generalFilterQualitySmoother,
-    generalFilterGainSmoother,
-    inputGainSmoother,
-    outputGainSmoother;
-    
-    juce::Atomic<bool> guiNeedsLatestDspOrder { false };
-    juce::Atomic<float> leftPreRMS, rightPreRMS, leftPostRMS, rightPostRMS;
-    
-    SimpleMBComp::SingleChannelSampleFifo<juce::AudioBuffer<float>> leftSCSF { SimpleMBComp::Channel::Left
-    }, rightSCSF { SimpleMBComp::Channel::Right };
-    
-    std::vector< juce::RangedAudioParameter* > getParamsForOption(DSP_Option option);
-    
-private:
-    DSP_Order dspOrder;
-    
-    juce::dsp::Gain<float> inputGainDSP, outputGainDSP;
-    
-    template<typename DSP>
-    struct DSP_Choice : juce::dsp::ProcessorBase
-    {
-        void prepare (const juce::dsp::ProcessSpec& spec) override
-        {
-            dsp.prepare(spec);
-        }
-        void process (const juce::dsp::ProcessContextReplacing<float>& context) override
-        {
-            dsp.process(context);
-        }
-        void reset() override
-        {
-            dsp.reset();
-        }
-        
-        DSP dsp;
-    };
-    
-    struct MonoChannelDSP
-    {
-        MonoChannelDSP(Project13AudioProcessor& proc) : p(proc) {}
-        DSP_Choice<juce::dsp::DelayLine<float>> delay;
-        DSP_Choice<juce::dsp::Phaser<float>> phaser;
-        DSP_Choice<juce::dsp::Chorus<float>> chorus;
-        DSP_Choice<juce::dsp::LadderFilter<float>> overdrive, ladderFilter;
-        DSP_Choice<juce::dsp::IIR::Filter<float>> generalFilter;
-     
-        void prepare(const juce::dsp::ProcessSpec& spec);
-        
-        void updateDSPFromParams();
-        
-        void process(juce::dsp::AudioBlock<float> block, const DSP_Order& dspOrder);
-        
-    private:
-        Project13AudioProcessor& p;
-        
-        GeneralFilterMode filterMode = GeneralFilterMode::END_OF_LIST;
-        float filterFreq = 0.f, filterQ = 0.f, filterGain = -100.f;
-    };
-    
-    MonoChannelDSP leftChannel { *this };
-    MonoChannelDSP rightChannel { *this };
-    
-    struct ProcessState
-    {
-        juce::dsp::ProcessorBase* processor = nullptr;
-        bool bypassed = false;
-    };
-    
-    using DSP_Pointers = std::array<ProcessState,
-        static_cast<size_t>(DSP_Option::END_OF_LIST)>;
-    
-#define VERIFY_BYPASS_FUNCTIONALITY false
-    
-    template<typename ParamType, typename Params, typename Funcs>
-    void initCachedParams(Params paramsArray, Funcs funcsArray)
-    {
-        for( size_t i = 0; i < paramsArray.size(); ++i )
-        {
-            auto ptrToParamPtr = paramsArray[i];
-            *ptrToParamPtr = dynamic_cast<ParamType>(apvts.getParameter(
-                 funcsArray[i]() ));
-            jassert( *ptrToParamPtr != nullptr );
-        }
-    }
-    
-    std::vector<juce::SmoothedValue<float>*> getSmoothers();
-    
-    enum class SmootherUpdateMode
-    {
-        initialize,
-        liveInRealtime
-    };
-    
-    void updateSmoothersFromParams(int numSamplesToSkip, SmootherUpdateMode init);
-    //==============================================================================
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Project13AudioProcessor)
-};
+/*
+  ==============================================================================
+
+    This file contains the basic framework code for a JUCE plugin processor.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <chrono>
+#include <span>
+#include <Fifo.h>
+#include <SingleChannelSampleFifo.h>
+#include "Messaging/SpscQueue.h"
+#include "Telemetry/DeadlineTelemetry.h"
+#include "Telemetry/QualityGovernor.h"
+#include "DSP/SharedTables.h"
+#include "DSP/ModMatrix.h"
+#include "DSP/GainStage.h"
+
+struct PresetLibrary;
+struct UndoJournal;
+
+/*
+ set to 0 to compile the per-stage CPU timers and the deadline telemetry out entirely.
+ when compiled in, the timers only run while an editor has turned them on with a ConfigureProfiling command,
+    or while the deadline telemetry is enabled.
+ */
+#ifndef PROJECT13_PROFILE_DSP
+ #define PROJECT13_PROFILE_DSP 1
+#endif
+
+static constexpr int NEGATIVE_INFINITY = -72;
+static constexpr int MAX_DECIBELS = 12;
+
+enum class GeneralFilterMode
+{
+    Peak,
+    Bandpass,
+    Notch,
+    Allpass,
+    END_OF_LIST
+};
+//==============================================================================
+/**
+*/
+class Project13AudioProcessor  : public juce::AudioProcessor
+                            #if JucePlugin_Enable_ARA
+                             , public juce::AudioProcessorARAExtension
+                            #endif
+                             , private juce::Timer
+                             , private juce::AudioProcessorParameter::Listener
+{
+public:
+    //==============================================================================
+    Project13AudioProcessor();
+    ~Project13AudioProcessor() override;
+
+    //==============================================================================
+    void prepareToPlay (double sampleRate, int samplesPerBlock) override;
+    void releaseResources() override;
+
+   #ifndef JucePlugin_PreferredChannelConfigurations
+    bool isBusesLayoutSupported (const BusesLayout& layouts) const override;
+   #endif
+
+    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+
+    //==============================================================================
+    juce::AudioProcessorEditor* createEditor() override;
+    bool hasEditor() const override;
+
+    //==============================================================================
+    const juce::String getName() const override;
+
+    bool acceptsMidi() const override;
+    bool producesMidi() const override;
+    bool isMidiEffect() const override;
+    double getTailLengthSeconds() const override;
+
+    //==============================================================================
+    int getNumPrograms() override;
+    int getCurrentProgram() override;
+    void setCurrentProgram (int index) override;
+    const juce::String getProgramName (int index) override;
+    void changeProgramName (int index, const juce::String& newName) override;
+
+    //==============================================================================
+    void getStateInformation (juce::MemoryBlock& destData) override;
+    void setStateInformation (const void* data, int sizeInBytes) override;
+
+    /*
+     The module pool: every module instance the chain can use. each one has its own parameters.
+     There are numModuleInstances of each module. the first instances come first, then the second ones
+        in the same order, so the values older builds saved keep their meaning.
+     a module's kind is its first instance. see getModuleKind().
+     */
+    enum class DSP_Option
+    {
+        Phase,
+        Chorus,
+        Overdrive,
+        LadderFilter,
+        GeneralFilter,
+        Phase2,
+        Chorus2,
+        Overdrive2,
+        LadderFilter2,
+        GeneralFilter2,
+        END_OF_LIST
+    };
+    
+    static constexpr size_t numModuleKinds = 5;
+    static constexpr size_t numModuleInstances = 2;
+    static_assert(numModuleKinds * numModuleInstances == static_cast<size_t>(DSP_Option::END_OF_LIST),
+                  "every module needs the same number of instances");
+    
+    static DSP_Option getModuleKind(DSP_Option option) { return getModuleInstance(option, 0); }
+    static size_t getInstanceIndex(DSP_Option option) { return static_cast<size_t>(option) / numModuleKinds; }
+    //the given instance of the same module as option
+    static DSP_Option getModuleInstance(DSP_Option option, size_t instance)
+    {
+        jassert( option != DSP_Option::END_OF_LIST && instance < numModuleInstances );
+        return static_cast<DSP_Option>(static_cast<size_t>(option) % numModuleKinds + instance * numModuleKinds);
+    }
+    
+    static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
+    juce::AudioProcessorValueTreeState apvts{ *this, nullptr, "Settings", createParameterLayout()};
+    
+    static constexpr size_t maxChainSlots = 8;
+    
+    /*
+     The chain: the module instances the signal runs through, first to last.
+     A valid order has between 1 and maxChainSlots slots, and uses each instance at most once.
+        so a module can be in the chain as many times as it has instances.
+     it is a fixed array and a count, so orders are copied through the queues and on the audio thread without allocating.
+     a default DSP_Order is empty, which isn't valid. it stands for 'no order' wherever one is optional.
+     */
+    struct DSP_Order
+    {
+        DSP_Order() { slots.fill(DSP_Option::END_OF_LIST); }
+        
+        size_t size() const { return numSlots; }
+        bool empty() const { return numSlots == 0; }
+        bool isFull() const { return numSlots == slots.size(); }
+        
+        DSP_Option operator[](size_t index) const { return slots[index]; }
+        const DSP_Option* begin() const { return slots.data(); }
+        const DSP_Option* end() const { return slots.data() + numSlots; }
+        
+        bool contains(DSP_Option option) const { return std::find(begin(), end(), option) != end(); }
+        int indexOf(DSP_Option option) const;
+        
+        //add and insert do nothing if the order is full
+        void add(DSP_Option option) { insert(numSlots, option); }
+        void insert(size_t index, DSP_Option option);
+        void remove(size_t index);
+        
+        bool operator==(const DSP_Order&) const = default;
+        
+    private:
+        //the slots past numSlots are always END_OF_LIST, so == can compare the whole array
+        std::array<DSP_Option, maxChainSlots> slots;
+        size_t numSlots = 0;
+    };
+
+    static bool isValidOrder(const DSP_Order& order);
+    //the first instance of every module, in DSP_Option order
+    static DSP_Order getDefaultOrder();
+
+    /*
+     Stable IDs for every parameter that is saved in the plugin state.
+     The compact state chunk stores parameter values in this order, so these must NEVER be reordered.
+     New parameters are appended just before END_OF_LIST.
+     */
+    enum class StateParam : juce::uint16
+    {
+        InputGain,
+        OutputGain,
+        PhaserRate,
+        PhaserDepth,
+        PhaserCenterFreq,
+        PhaserFeedback,
+        PhaserMix,
+        PhaserBypass,
+        ChorusRate,
+        ChorusDepth,
+        ChorusCenterDelay,
+        ChorusFeedback,
+        ChorusMix,
+        ChorusBypass,
+        OverdriveSaturation,
+        OverdriveBypass,
+        LadderFilterMode,
+        LadderFilterCutoff,
+        LadderFilterResonance,
+        LadderFilterDrive,
+        LadderFilterBypass,
+        GeneralFilterMode,
+        GeneralFilterFreq,
+        GeneralFilterQuality,
+        GeneralFilterGain,
+        GeneralFilterBypass,
+        SelectedTab,
+        CrossfadeMode,
+        CrossfadeTime,
+        Morph,
+        MorphEnabled,
+        MidSideMode,
+        PhaserSideBypass,
+        ChorusSideBypass,
+        OverdriveSideBypass,
+        LadderFilterSideBypass,
+        GeneralFilterSideBypass,
+        //the second module instances' parameters, in moduleParams order
+        Phaser2Rate,
+        Phaser2Depth,
+        Phaser2CenterFreq,
+        Phaser2Feedback,
+        Phaser2Mix,
+        Phaser2Bypass,
+        Chorus2Rate,
+        Chorus2Depth,
+        Chorus2CenterDelay,
+        Chorus2Feedback,
+        Chorus2Mix,
+        Chorus2Bypass,
+        Overdrive2Saturation,
+        Overdrive2Bypass,
+        LadderFilter2Mode,
+        LadderFilter2Cutoff,
+        LadderFilter2Resonance,
+        LadderFilter2Drive,
+        LadderFilter2Bypass,
+        GeneralFilter2Mode,
+        GeneralFilter2Freq,
+        GeneralFilter2Quality,
+        GeneralFilter2Gain,
+        GeneralFilter2Bypass,
+        Phaser2SideBypass,
+        Chorus2SideBypass,
+        Overdrive2SideBypass,
+        LadderFilter2SideBypass,
+        GeneralFilter2SideBypass,
+        END_OF_LIST
+    };
+
+    static constexpr size_t numStateParams = static_cast<size_t>(StateParam::END_OF_LIST);
+    
+    /*
+     the parameters every module instance has its own copy of, as the first instances' StateParams.
+     the rest, like the gains, are shared.
+     */
+    static constexpr std::array moduleParams
+    {
+        StateParam::PhaserRate,
+        StateParam::PhaserDepth,
+        StateParam::PhaserCenterFreq,
+        StateParam::PhaserFeedback,
+        StateParam::PhaserMix,
+        StateParam::PhaserBypass,
+        StateParam::ChorusRate,
+        StateParam::ChorusDepth,
+        StateParam::ChorusCenterDelay,
+        StateParam::ChorusFeedback,
+        StateParam::ChorusMix,
+        StateParam::ChorusBypass,
+        StateParam::OverdriveSaturation,
+        StateParam::OverdriveBypass,
+        StateParam::LadderFilterMode,
+        StateParam::LadderFilterCutoff,
+        StateParam::LadderFilterResonance,
+        StateParam::LadderFilterDrive,
+        StateParam::LadderFilterBypass,
+        StateParam::GeneralFilterMode,
+        StateParam::GeneralFilterFreq,
+        StateParam::GeneralFilterQuality,
+        StateParam::GeneralFilterGain,
+        StateParam::GeneralFilterBypass,
+        StateParam::PhaserSideBypass,
+        StateParam::ChorusSideBypass,
+        StateParam::OverdriveSideBypass,
+        StateParam::LadderFilterSideBypass,
+        StateParam::GeneralFilterSideBypass,
+    };
+    
+    static_assert(numStateParams - static_cast<size_t>(StateParam::Phaser2Rate) == moduleParams.size() * (numModuleInstances - 1),
+                  "every instance after the first needs a StateParam for each of moduleParams");
+    
+    //the given instance's copy of a first instance parameter. shared parameters are returned as they are.
+    static constexpr StateParam getInstanceParam(StateParam param, size_t instance)
+    {
+        auto it = std::find(moduleParams.begin(), moduleParams.end(), param);
+        if( instance == 0 || it == moduleParams.end() )
+            return param;
+        
+        auto index = static_cast<size_t>(it - moduleParams.begin());
+        return static_cast<StateParam>(static_cast<size_t>(StateParam::Phaser2Rate) + (instance - 1) * moduleParams.size() + index);
+    }
+
+    /*
+     The A and B parameter sets the Morph macro moves between.
+     valid is false until one of them has been stored.
+     */
+    struct MorphSnapshots
+    {
+        std::array<float, numStateParams> a {}, b {};
+        bool valid = false;
+    };
+    
+    enum class MorphSlot
+    {
+        A,
+        B
+    };
+    
+    /*
+     Everything that makes up the plugin state: the plain (denormalized) value of every parameter,
+        indexed by StateParam, the DSP order, the morph snapshots and the modulation routing.
+     an empty order means 'no order was stored'.
+     */
+    struct StateSnapshot
+    {
+        std::array<float, numStateParams> values {};
+        DSP_Order order;
+        MorphSnapshots morph;
+        ModMatrix::Routing modulation;
+
+        float& operator[](StateParam p) { return values[static_cast<size_t>(p)]; }
+        float operator[](StateParam p) const { return values[static_cast<size_t>(p)]; }
+    };
+
+    StateSnapshot getDefaultState() const;
+    //any thread but the audio thread. the order is the latest one asked for, not the one still playing.
+    StateSnapshot captureState() const;
+    //publishes the snapshot and lands it. see PublishedState below.
+    void applyState(const StateSnapshot& snapshot);
+
+    /*
+     the ValueTree format used before the compact chunk existed.
+     setStateInformation() still reads it. this writer is kept for the state benchmark.
+     */
+    void getLegacyStateInformation(juce::MemoryBlock& destData);
+    /*
+     the loader that went with it: apvts.replaceState() and the XML dump, kept for the state benchmark only.
+     it writes the parameters straight from the calling thread instead of publishing the state,
+        so it must not be called while processBlock() may be running.
+     */
+    void setLegacyStateInformation(const void* data, int sizeInBytes);
+
+    std::array<juce::RangedAudioParameter*, numStateParams> stateParams {};
+
+    /*
+     State restores and preset loads reach the audio thread as one complete, immutable PublishedState.
+        - it is built off the audio thread and published with a single atomic exchange.
+          a newer publish replaces one the audio thread hasn't picked up yet.
+        - the audio thread adopts it at the start of a block. no locks, no allocation.
+        - the state it replaces is handed back through retiredStates and deleted off the audio thread.
+     The values are then written into the APVTS parameters so the host and GUI see them ('landing').
+     Until that has happened, the audio thread reads its parameter values from the adopted state instead of
+        the parameters, so it never sees a mix of old and new values.
+     */
+    struct PublishedState
+    {
+        StateSnapshot snapshot;
+        juce::uint32 generation = 0;
+    };
+
+    //any thread but the audio thread. returns the generation to pass to landState().
+    juce::uint32 publishState(const StateSnapshot& snapshot);
+    void landState(const StateSnapshot& snapshot, juce::uint32 generation);
+
+    PresetLibrary& getPresetLibrary() { return *presetLibrary; }
+    UndoJournal& getUndoJournal() { return *undoJournal; }
+    
+    /*
+     message thread. stores the current parameter values as morph snapshot A or B.
+     the first time, the other slot gets the same values so the morph starts out neutral.
+     */
+    void storeMorphSnapshot(MorphSlot slot);
+    //any thread but the audio thread
+    bool hasMorphSnapshots() const;
+    
+    //the parameter each smoother follows, in getSmoothers() order
+    static constexpr std::array smoothedParams
+    {
+        StateParam::PhaserRate,
+        StateParam::PhaserCenterFreq,
+        StateParam::PhaserDepth,
+        StateParam::PhaserFeedback,
+        StateParam::PhaserMix,
+        StateParam::ChorusRate,
+        StateParam::ChorusDepth,
+        StateParam::ChorusCenterDelay,
+        StateParam::ChorusFeedback,
+        StateParam::ChorusMix,
+        StateParam::OverdriveSaturation,
+        StateParam::LadderFilterCutoff,
+        StateParam::LadderFilterResonance,
+        StateParam::LadderFilterDrive,
+        StateParam::GeneralFilterFreq,
+        StateParam::GeneralFilterQuality,
+        StateParam::GeneralFilterGain,
+        StateParam::InputGain,
+        StateParam::OutputGain,
+        StateParam::Phaser2Rate,
+        StateParam::Phaser2CenterFreq,
+        StateParam::Phaser2Depth,
+        StateParam::Phaser2Feedback,
+        StateParam::Phaser2Mix,
+        StateParam::Chorus2Rate,
+        StateParam::Chorus2Depth,
+        StateParam::Chorus2CenterDelay,
+        StateParam::Chorus2Feedback,
+        StateParam::Chorus2Mix,
+        StateParam::Overdrive2Saturation,
+        StateParam::LadderFilter2Cutoff,
+        StateParam::LadderFilter2Resonance,
+        StateParam::LadderFilter2Drive,
+        StateParam::GeneralFilter2Freq,
+        StateParam::GeneralFilter2Quality,
+        StateParam::GeneralFilter2Gain,
+    };
+    
+    /*
+     Modulation. see ModMatrix.h.
+     The targets are the StateParams with a smoother: mod matrix target t is smoothedParams[t].
+        routes to any other parameter are ignored.
+     The message thread owns the routing and hands copies to the audio thread with a SetModRouting command,
+        like the morph snapshots. the routing is saved with the rest of the state, by StateParam.
+     message thread only, like sendCommand(). a routing that doesn't fit in the queue is sent again by the timer.
+     */
+    void setModRouting(const ModMatrix::Routing& routing);
+    ModMatrix::Routing getModRouting() const;
+    static constexpr size_t numModTargets = smoothedParams.size();
+    static_assert(numModTargets <= ModMatrix::maxTargets, "the mod matrix needs a column for every smoothed parameter");
+    //the mod matrix target that modulates param, if it can be modulated
+    static std::optional<size_t> getModTarget(StateParam param);
+    
+    /*
+     Editor <-> processor messaging.
+     Commands go from the message thread to the audio thread and are drained once at the start of every block.
+     Events go from the audio thread to the editor and are drained once per frame in its timerCallback().
+     Each direction is one bounded SPSC queue of small tagged unions, so adding a message never adds a new
+        fifo or polling path. a full queue drops the message and counts it in the overflow counter.
+     */
+    /*
+     Memory on demand.
+     The analyzer fifos only exist while an editor is open. openAnalyzer() creates and prepares them
+        on the message thread and hands them to the audio thread. closeAnalyzer() takes them back,
+        and they are freed once the audio thread has acknowledged that it let go of them.
+     A module is only prepared, which is where it allocates its buffers, once it is in the order, bypassed or not.
+        an offline render prepares every module, so nothing is ever skipped in a bounce. see prepareModulesAhead().
+     */
+    struct AnalyzerFifos
+    {
+        SimpleMBComp::SingleChannelSampleFifo<juce::AudioBuffer<float>> left { SimpleMBComp::Channel::Left },
+            right { SimpleMBComp::Channel::Right };
+    };
+    
+    //message thread only. there is one editor at a time, so there is one set of fifos at a time.
+    AnalyzerFifos& openAnalyzer();
+    void closeAnalyzer();
+    
+    //an estimate of the memory this instance's DSP holds, from the sizes JUCE allocates in prepare()
+    struct MemoryUsage
+    {
+        size_t analyzerBytes = 0;
+        std::array<size_t, static_cast<size_t>(DSP_Option::END_OF_LIST)> moduleBytes {};
+        
+        size_t getTotalBytes() const;
+    };
+    
+    MemoryUsage getMemoryUsage() const;
+    
+    struct MeterFrame
+    {
+        float leftPre = 0.f, rightPre = 0.f, leftPost = 0.f, rightPost = 0.f;
+    };
+    
+    /*
+     CPU profiling.
+     The stages processBlock() spends its time in. the module instances come first, in DSP_Option order.
+     Each value in a CpuFrame is the share of one core the stage takes up in realtime (0.01 = 1%),
+        for both channels together.
+        average covers the time since the previous frame. peak is the worst single block in that time.
+     */
+    enum class ProfileStage : juce::uint8
+    {
+        Phase,
+        Chorus,
+        Overdrive,
+        LadderFilter,
+        GeneralFilter,
+        Phase2,
+        Chorus2,
+        Overdrive2,
+        LadderFilter2,
+        GeneralFilter2,
+        InputGain,
+        OutputGain,
+        Metering,
+        END_OF_LIST
+    };
+    
+    static constexpr size_t numProfileStages = static_cast<size_t>(ProfileStage::END_OF_LIST);
+    static ProfileStage getProfileStage(DSP_Option option) { return static_cast<ProfileStage>(option); }
+    static juce::String getProfileStageName(ProfileStage stage);
+    static_assert(static_cast<int>(ProfileStage::InputGain) == static_cast<int>(DSP_Option::END_OF_LIST),
+                  "the module stages must match DSP_Option");
+    
+    struct CpuFrame
+    {
+        std::array<float, numProfileStages> average {}, peak {};
+        
+        float getAverage(ProfileStage s) const { return average[static_cast<size_t>(s)]; }
+        float getPeak(ProfileStage s) const { return peak[static_cast<size_t>(s)]; }
+    };
+    
+    struct Command
+    {
+        enum class Type : juce::uint8
+        {
+            SetOrder,
+            ConfigureAnalyzer,
+            RequestSnapshot,
+            SetMorphSnapshots,
+            ConfigureProfiling,
+            SetModRouting
+        };
+        
+        //the fifos the audio thread feeds, or nullptr to stop. generation is acknowledged in analyzerGenerationSeen.
+        struct AnalyzerConfig
+        {
+            AnalyzerFifos* fifos;
+            juce::uint32 generation;
+        };
+        
+        Type type = Type::RequestSnapshot;
+        union
+        {
+            DSP_Order order;
+            AnalyzerConfig analyzer;
+            MorphSnapshots morph;
+            bool profilingEnabled;
+            ModMatrix::Routing modulation;
+        };
+        
+        Command() : order() { }
+        
+        static Command setOrder(const DSP_Order& o) { Command c; c.type = Type::SetOrder; c.order = o; return c; }
+        static Command configureAnalyzer(AnalyzerFifos* fifos, juce::uint32 generation)
+        {
+            Command c;
+            c.type = Type::ConfigureAnalyzer;
+            c.analyzer = { fifos, generation };
+            return c;
+        }
+        static Command requestSnapshot() { Command c; c.type = Type::RequestSnapshot; return c; }
+        static Command configureProfiling(bool enabled)
+        {
+            Command c;
+            c.type = Type::ConfigureProfiling;
+            c.profilingEnabled = enabled;
+            return c;
+        }
+        static Command setMorphSnapshots(const MorphSnapshots& m)
+        {
+            Command c;
+            c.type = Type::SetMorphSnapshots;
+            c.morph = m;
+            return c;
+        }
+        static Command setModRouting(const ModMatrix::Routing& r)
+        {
+            Command c;
+            c.type = Type::SetModRouting;
+            c.modulation = r;
+            return c;
+        }
+    };
+    
+    struct Event
+    {
+        enum class Type : juce::uint8
+        {
+            OrderChanged,
+            Meters,
+            Cpu,
+            Quality
+        };
+        
+        Type type = Type::Meters;
+        union
+        {
+            DSP_Order order;
+            MeterFrame meters;
+            CpuFrame cpu;
+            QualityGovernor::Tier quality;
+        };
+        
+        Event() : meters() { }
+    };
+    
+    //message thread only. the modules of a SetOrder command's order are prepared before it is sent.
+    bool sendCommand(const Command& command);
+    //editor only
+    bool popEvent(Event& event) { return eventQueue.pop(event); }
+    
+    juce::uint32 getNumCommandOverflows() const { return commandQueue.getNumOverflows(); }
+    juce::uint32 getNumEventOverflows() const { return eventQueue.getNumOverflows(); }
+    
+    //clears the DSP's tails. hosts call this from various threads.
+    void reset() override;
+    
+    /*
+     Sample-accurate automation.
+     A ParameterEvent sets a parameter to a plain value from sampleOffset on.
+     processBlockWithParameterEvents() runs a control tick exactly at each event, so the smoothing starts on that sample,
+        and the same automation renders the same at every block size.
+     Wrappers and tools that have the host's timestamped changes call it with them, sorted by sampleOffset.
+     processBlock() has no events. it runs a tick at the first sample of a block when a parameter was changed
+        since the last one, which is how the VST3 and AU wrappers deliver automation.
+     Either way, nothing is split while nothing changes and no smoother is moving.
+     audio thread only.
+     */
+    struct ParameterEvent
+    {
+        int sampleOffset = 0;
+        StateParam param = StateParam::InputGain;
+        float value = 0.f;
+    };
+    
+    void processBlockWithParameterEvents(juce::AudioBuffer<float>& buffer,
+                                         juce::MidiBuffer& midiMessages,
+                                         std::span<const ParameterEvent> events);
+    
+    /*
+     Benchmark hooks. Project13Bench uses these to time parts of processBlock() on their own.
+     They run the same code processBlock() runs on the active chain, on the whole block at once:
+        no 64-sample sub-blocks, no gain stages, no crossfade and no messaging.
+     The processor must be prepared, and these must be called from the thread that calls processBlock().
+     A module that isn't prepared yet is prepared on the first call that uses it.
+     */
+    void benchmarkModule(juce::dsp::AudioBlock<float> block, DSP_Option option);
+    void benchmarkChain(juce::dsp::AudioBlock<float> block, const DSP_Order& order);
+    
+    /*
+     Deadline telemetry: the duration, block size and headroom of every processBlock() call. see DeadlineTelemetry.h.
+     Overruns are attributed to the ProfileStage that took longest in the call,
+        or to "other" when most of the time went somewhere the stage timers don't cover.
+     The processor starts a log on its own when the PROJECT13_TELEMETRY environment variable is set.
+     message thread only.
+     */
+    void startTelemetryLog(const juce::File& file, int intervalSeconds = 10);
+    void stopTelemetryLog() { telemetryLogger.reset(); }
+    const DeadlineTelemetry& getTelemetry() const { return telemetry; }
+    
+    /*
+     Eco mode: quality steps down when processBlock() gets close to its deadline. see QualityGovernor.h.
+     Only realtime processing is governed. offline renders always run at full quality.
+     The editor gets a Quality event whenever the tier changes, and with every snapshot.
+     The mode starts out as the PROJECT13_ECO environment variable asks. any thread.
+     */
+    void setQualityMode(QualityGovernor::Mode mode) { governor.setMode(mode); }
+    QualityGovernor::Mode getQualityMode() const { return governor.getMode(); }
+    QualityGovernor::Tier getQualityTier() const { return governor.getTier(); }
+
+    juce::AudioParameterFloat* phaserRateHz = nullptr;
+    juce::AudioParameterFloat* phaserCenterFreqHz = nullptr;
+    juce::AudioParameterFloat* phaserDepthPercent = nullptr;
+    juce::AudioParameterFloat* phaserFeedbackPercent = nullptr;
+    juce::AudioParameterFloat* phaserMixPercent = nullptr;
+    juce::AudioParameterBool* phaserBypass = nullptr;
+    
+    juce::AudioParameterFloat* chorusRateHz = nullptr;
+    juce::AudioParameterFloat* chorusDepthPercent = nullptr;
+    juce::AudioParameterFloat* chorusCenterDelayMs = nullptr;
+    juce::AudioParameterFloat* chorusFeedbackPercent = nullptr;
+    juce::AudioParameterFloat* chorusMixPercent = nullptr;
+    juce::AudioParameterBool* chorusBypass = nullptr;
+    
+    juce::AudioParameterFloat* overdriveSaturation = nullptr;
+    juce::AudioParameterBool* overdriveBypass = nullptr;
+    
+    juce::AudioParameterChoice* ladderFilterMode = nullptr;
+    juce::AudioParameterFloat* ladderFilterCutoffHz = nullptr;
+    juce::AudioParameterFloat* ladderFilterResonance = nullptr;
+    juce::AudioParameterFloat* ladderFilterDrive = nullptr;
+    juce::AudioParameterBool* ladderFilterBypass = nullptr;
+    
+    juce::AudioParameterChoice* generalFilterMode = nullptr;
+    juce::AudioParameterFloat* generalFilterFreqHz = nullptr;
+    juce::AudioParameterFloat* generalFilterQuality = nullptr;
+    juce::AudioParameterFloat* generalFilterGain = nullptr;
+    juce::AudioParameterBool* generalFilterBypass = nullptr;
+    
+    juce::AudioParameterInt* selectedTab = nullptr;
+    
+    juce::AudioParameterFloat* inputGain = nullptr;
+    juce::AudioParameterFloat* outputGain = nullptr;
+    
+    juce::AudioParameterBool* crossfadeMode = nullptr;
+    juce::AudioParameterFloat* crossfadeTimeMs = nullptr;
+    
+    juce::AudioParameterFloat* morph = nullptr;
+    juce::AudioParameterBool* morphEnabled = nullptr;
+    
+    juce::AudioParameterBool* midSideMode = nullptr;
+    juce::AudioParameterBool* phaserSideBypass = nullptr;
+    juce::AudioParameterBool* chorusSideBypass = nullptr;
+    juce::AudioParameterBool* overdriveSideBypass = nullptr;
+    juce::AudioParameterBool* ladderFilterSideBypass = nullptr;
+    juce::AudioParameterBool* generalFilterSideBypass = nullptr;
+    
+    juce::SmoothedValue<float>
+    phaserRateHzSmoother,
+    phaserCenterFreqHzSmoother,
+    phaserDepthPercentSmoother,
+    phaserFeedbackPercentSmoother,
+    phaserMixPercentSmoother,
+    chorusRateHzSmoother,
+    chorusDepthPercentSmoother,
+    chorusCenterDelayMsSmoother,
+    chorusFeedbackPercentSmoother,
+    chorusMixPercentSmoother,
+    overdriveSaturationSmoother,
+    ladderFilterCutoffHzSmoother,
+    ladderFilterResonanceSmoother,
+    ladderFilterDriveSmoother,
+    generalFilterFreqHzSmoother,
+    generalFilterQualitySmoother,
+    generalFilterGainSmoother,
+    inputGainSmoother,
+    outputGainSmoother,
+    phaser2RateHzSmoother,
+    phaser2CenterFreqHzSmoother,
+    phaser2DepthPercentSmoother,
+    phaser2FeedbackPercentSmoother,
+    phaser2MixPercentSmoother,
+    chorus2RateHzSmoother,
+    chorus2DepthPercentSmoother,
+    chorus2CenterDelayMsSmoother,
+    chorus2FeedbackPercentSmoother,
+    chorus2MixPercentSmoother,
+    overdrive2SaturationSmoother,
+    ladderFilter2CutoffHzSmoother,
+    ladderFilter2ResonanceSmoother,
+    ladderFilter2DriveSmoother,
+    generalFilter2FreqHzSmoother,
+    generalFilter2QualitySmoother,
+    generalFilter2GainSmoother;
+    
+    std::vector< juce::RangedAudioParameter* > getParamsForOption(DSP_Option option);
+    
+private:
+    DSP_Order dspOrder;
+
+    std::unique_ptr<PresetLibrary> presetLibrary;
+    std::unique_ptr<UndoJournal> undoJournal;
+    //taken on the message thread when the journal is created, so other threads only ever copy it
+    juce::WeakReference<UndoJournal> undoJournalRef;
+    
+    static juce::StringArray getTelemetryStageNames();
+    DeadlineTelemetry telemetry { getTelemetryStageNames() };
+    std::unique_ptr<DeadlineTelemetry::Logger> telemetryLogger;
+    
+    QualityGovernor governor;
+    //audio thread only. the tier is picked at the start of each block and holds for all of it.
+    bool governorRunning = false;
+    QualityGovernor::Tier qualityTier = QualityGovernor::Tier::Full;
+    QualityGovernor::Tier reportedQualityTier = QualityGovernor::Tier::Full;
+
+    /*
+     ownership of a PublishedState moves pendingState -> adoptedState -> retiredStates.
+     whoever exchanges a pointer out of pendingState, or pops one from retiredStates, owns it.
+     the ring holds several, so a burst of preset changes between two reclaims doesn't hold up adoption.
+        it is only reclaimed under retireLock, since several non-audio threads may do it.
+     */
+    std::atomic<PublishedState*> pendingState { nullptr };
+    SpscQueue<PublishedState*, 16> retiredStates;
+    juce::CriticalSection retireLock;
+    std::atomic<juce::uint32> stateGeneration { 0 }, landedStateGeneration { 0 };
+    //audio thread only
+    PublishedState* adoptedState = nullptr;
+    
+    //returns true if a new state was adopted
+    bool adoptPublishedState();
+    //deletes the retired states. never called on the audio thread.
+    //publishState(), sendCommand() and the timer call it, so the ring rarely fills up.
+    void reclaimRetiredState();
+    void timerCallback() override;
+    
+    /*
+     Morphing.
+     The message thread owns morphSnapshots and hands copies to the audio thread with a SetMorphSnapshots command.
+        hosts may save and restore the state from other threads, so morphSnapshots and modRouting are guarded by
+        morphLock, which the audio thread never takes.
+     The audio thread blends its copy into liveParams in refreshLiveParams(), so the smoothers,
+        the filters and everything downstream follow the morph exactly like they follow the knobs.
+        float parameters are interpolated.
+        choice and bool parameters switch at the midpoint, through a chain crossfade.
+     Nothing here allocates: both arrays are preallocated and the command queue copies by value.
+     */
+    enum class MorphKind : juce::uint8
+    {
+        Interpolate,
+        SwitchAtMidpoint,
+        Fixed
+    };
+    
+    std::array<MorphKind, numStateParams> morphKinds {};
+    mutable juce::CriticalSection morphLock;
+    MorphSnapshots morphSnapshots;
+    
+    enum class MorphSide
+    {
+        Off,
+        A,
+        B
+    };
+    
+    //audio thread only
+    MorphSnapshots liveMorph;
+    MorphSide morphSide = MorphSide::Off;
+    bool morphSwitched = false;
+    
+    void applyMorph();
+
+    /*
+     where the audio thread reads each StateParam from.
+     exactly one of these pointers is set. reading through the typed pointer is a plain atomic load,
+     the same cost as the ->get() calls it replaces.
+     */
+    struct LiveParamSource
+    {
+        juce::AudioParameterFloat* floatParam = nullptr;
+        juce::AudioParameterChoice* choiceParam = nullptr;
+        juce::AudioParameterBool* boolParam = nullptr;
+        juce::AudioParameterInt* intParam = nullptr;
+
+        float read() const;
+    };
+
+    std::array<LiveParamSource, numStateParams> liveParamSources;
+    /*
+     the audio thread's view of every StateParam. refreshed at the start of every sub-block.
+     */
+    std::array<float, numStateParams> liveParams {};
+
+    void refreshLiveParams();
+    float live(StateParam p) const { return liveParams[static_cast<size_t>(p)]; }
+    bool liveBool(StateParam p) const { return live(p) >= 0.5f; }
+    
+    //guarded by morphLock
+    ModMatrix::Routing modRouting;
+    /*
+     guarded by morphLock. the order the last published state or SetOrder command asked for, which is what
+        captureState() saves. dspOrder belongs to the audio thread, and lags behind until it adopts the change
+        and any crossfade to it ends.
+     */
+    DSP_Order requestedOrder;
+    
+    /*
+     message thread only. set when a SetMorphSnapshots or SetModRouting command didn't fit in the queue.
+     timerCallback() sends the latest copy until it fits, so the audio thread never keeps a stale one.
+     */
+    bool morphSnapshotsUnsent = false, modRoutingUnsent = false;
+    void resendUnsentCommands();
+    //audio thread only
+    ModMatrix modMatrix;
+    
+    /*
+     the values the DSP is set to at each control tick: liveParams, with the smoothed parameters taken
+        from their smoothers and the modulation added on top. audio thread only.
+     */
+    std::array<float, numStateParams> controlValues {};
+    
+    void updateControlValues();
+    float control(StateParam p) const { return controlValues[static_cast<size_t>(p)]; }
+    
+    GainStage inputGainDSP, outputGainDSP;
+    
+    /*
+     Mid/side mode.
+     While it is on, the input gain stage encodes L/R into M/S and the output gain stage decodes it,
+        so the left chains process mid and the right chains process side.
+        the mid chains follow the module bypasses, the side chains the side bypasses.
+     It only changes at a control tick, and switching crossfades the chains like a morph does.
+     Each pair of chains keeps the mode it was started in. see ChainPair.
+        while a crossfade runs between the modes, the gain stages leave the matrix to the chains,
+        so the outgoing pair still hears the mode it was built for. see processChains().
+     audio thread only. the mode of the newest pair, the one a crossfade is heading for.
+     */
+    bool midSideActive = false;
+    
+    //the side bypasses for a right chain in mid/side mode, the module bypasses otherwise
+    bool isModuleBypassed(DSP_Option option, bool sideChannel) const;
+    
+    template<typename DSP>
+    struct DSP_Choice : juce::dsp::ProcessorBase
+    {
+        void prepare (const juce::dsp::ProcessSpec& spec) override
+        {
+            dsp.prepare(spec);
+        }
+        void process (const juce::dsp::ProcessContextReplacing<float>& context) override
+        {
+            dsp.process(context);
+        }
+        void reset() override
+        {
+            dsp.reset();
+        }
+        
+        //frees everything prepare() allocated, by starting over with a default-constructed processor
+        void release()
+        {
+            std::destroy_at(&dsp);
+            std::construct_at(&dsp);
+        }
+        
+        DSP dsp;
+    };
+    
+    struct MonoChannelDSP
+    {
+        MonoChannelDSP(Project13AudioProcessor& proc, bool right) : p(proc), isRight(right) {}
+        
+        //this chain's share of the module pool: one of each module per instance, indexed by getInstanceIndex()
+        template<typename DSP>
+        using Instances = std::array<DSP_Choice<DSP>, numModuleInstances>;
+        
+        DSP_Choice<juce::dsp::DelayLine<float>> delay;
+        Instances<juce::dsp::Phaser<float>> phasers;
+        Instances<juce::dsp::Chorus<float>> choruses;
+        Instances<juce::dsp::LadderFilter<float>> overdrives, ladderFilters;
+        Instances<juce::dsp::IIR::Filter<float>> generalFilters;
+     
+        //not on the audio thread, and only while the audio thread isn't using the module. see modulePrepared.
+        void prepareModule(DSP_Option option, const juce::dsp::ProcessSpec& spec);
+        void releaseModule(DSP_Option option);
+        
+        //sets up the oversamplers for a high quality render, or frees them and delays by the same latency instead
+        void prepareRender(const juce::dsp::ProcessSpec& spec, bool highQuality);
+        
+        //also takes the bypass states, so a chain that is frozen for a crossfade keeps the ones it had
+        void updateDSPFromParams(bool midSide);
+        
+        void process(juce::dsp::AudioBlock<float> block, const DSP_Order& dspOrder);
+        
+        /*
+         sets latencyDelay for the order the chain is about to play.
+         only called when the chain starts on an order, so a chain that is frozen for a crossfade keeps its own.
+         */
+        void setPaddingForOrder(const DSP_Order& dspOrder);
+        
+        juce::dsp::ProcessorBase* getProcessor(DSP_Option option);
+        
+        //clears every module's internal state and forces the filter coefficients to be recomputed
+        void reset();
+        
+    private:
+        Project13AudioProcessor& p;
+        //the right chains carry the side signal in mid/side mode
+        const bool isRight;
+        
+        //audio thread only. false until the processor has prepared the module.
+        bool isReady(DSP_Option option) const;
+        
+        //nullptr unless the chain is set up for a high quality render and the module is oversampled in one
+        juce::dsp::Oversampling<float>* getOversampler(DSP_Option option);
+        
+        //one per oversampled module instance
+        std::array<std::unique_ptr<juce::dsp::Oversampling<float>>, static_cast<size_t>(DSP_Option::END_OF_LIST)> oversamplers;
+        //the bypass states as of the last updateDSPFromParams()
+        std::array<bool, static_cast<size_t>(DSP_Option::END_OF_LIST)> bypassed {};
+        bool highQuality = false;
+        /*
+         stands in for the latency of the oversamplers the signal doesn't pass through in a high quality render:
+            the ones of the instances that aren't in the order. unused in realtime.
+         */
+        juce::dsp::DelayLine<float> latencyDelay;
+        int latencyDelaySamples = 0;
+        
+        void updateGeneralFilter(size_t instance);
+        
+        //the general filters' settings when their coefficients were last computed
+        struct FilterSettings
+        {
+            GeneralFilterMode mode = GeneralFilterMode::END_OF_LIST;
+            float freq = 0.f, q = 0.f, gain = -100.f;
+        };
+        
+        std::array<FilterSettings, numModuleInstances> filterSettings;
+    };
+    
+    MonoChannelDSP leftChannel { *this, false };
+    MonoChannelDSP rightChannel { *this, true };
+    
+    /*
+     Crossfade mode.
+     A second set of MonoChannelDSPs is prepared alongside the first.
+     When the DSP order changes, a preset arrives, or the state is restored, the idle set is reset,
+        switched to the new order and faded in with an equal-power crossfade while the active set
+        keeps its old settings and fades out.
+     When the fade completes the two sets swap roles.
+     Both sets only run during a transition, so steady-state CPU is unchanged.
+     Changes that arrive mid-fade are queued, so there are never more than 2 chains running.
+     */
+    MonoChannelDSP leftFadeChannel { *this, false };
+    MonoChannelDSP rightFadeChannel { *this, true };
+    
+    struct ChainPair
+    {
+        MonoChannelDSP* left = nullptr;
+        MonoChannelDSP* right = nullptr;
+        //set when the pair starts, and kept until it is started again, so an outgoing pair keeps its mode
+        bool midSide = false;
+        
+        void setPaddingForOrder(const DSP_Order& order)
+        {
+            left->setPaddingForOrder(order);
+            right->setPaddingForOrder(order);
+        }
+    };
+    
+    ChainPair activeChain { &leftChannel, &rightChannel };
+    ChainPair incomingChain { &leftFadeChannel, &rightFadeChannel };
+    
+    struct ChainCrossfade
+    {
+        bool active = false;
+        int samplesDone = 0;
+        int totalSamples = 0;
+        DSP_Order incomingOrder;
+        
+        bool queued = false;
+        DSP_Order queuedOrder;
+    };
+    
+    ChainCrossfade crossfade;
+    juce::AudioBuffer<float> crossfadeBuffer;
+    
+    /*
+     Render quality.
+     An offline render, i.e. isNonRealtime() when prepareToPlay() is called, runs the chorus, the overdrive
+        and the ladder filter 4x oversampled: the overdrive and the ladder's drive alias less,
+        and the chorus's interpolated delay line reads at 4 times the resolution.
+     While isNonRealtime(), parameters that are moving are also followed sample by sample instead of every control interval.
+     The oversamplers' linear-phase filters delay the signal by getRenderLatency() in every chain,
+        whatever the order and the bypass states are, because the signal passes through them even when a module doesn't run.
+        getRenderLatency() covers every oversampled instance in the pool. the ones the order leaves out are made up for
+        with a plain delay line, so a chain of any length has the same latency.
+     Realtime processing has no oversamplers and no latency. only a high quality render reports getRenderLatency(),
+        from the prepareToPlay() that sets it up, and the host compensates for it, so a bounce still lines up
+        with what was heard while playing.
+     */
+    static constexpr size_t oversamplingOrder = 2;
+    static bool isOversampledOffline(DSP_Option option);
+    //the latency of one oversampled module, and of all of them
+    static int getOversamplingLatency();
+    static int getRenderLatency();
+    //the spec a module is prepared with. moduleLock must be held.
+    juce::dsp::ProcessSpec getModuleSpec(DSP_Option option) const;
+    //set by prepareToPlay() under moduleLock
+    bool renderHighQuality = false;
+    
+    //built in the background after the first instance is created. see SharedTables.h.
+    SharedTables::Handle sharedTables;
+    
+    //the order the audio will end up in once any running or queued crossfade has finished
+    const DSP_Order& getLatestOrder() const;
+    
+    SpscQueue<Command, 32> commandQueue;
+    SpscQueue<Event, 128> eventQueue;
+    
+    //audio thread only
+    bool analyzerEnabled = false;
+    AnalyzerFifos* liveAnalyzerFifos = nullptr;
+    
+    /*
+     the message thread's side of the analyzer fifos. guarded by analyzerLock, so prepareToPlay() can
+        re-prepare them from whichever thread the host calls it on.
+     closed fifos wait in retiredFifos until the audio thread has seen the command that replaced them.
+     */
+    struct RetiredFifos
+    {
+        std::unique_ptr<AnalyzerFifos> fifos;
+        juce::uint32 generation = 0;
+    };
+    
+    juce::CriticalSection analyzerLock;
+    std::unique_ptr<AnalyzerFifos> openFifos;
+    std::vector<RetiredFifos> retiredFifos;
+    juce::uint32 analyzerGeneration = 0;
+    std::atomic<juce::uint32> analyzerGenerationSeen { 0 };
+    
+    void reclaimAnalyzerFifos();
+    
+    static constexpr size_t numDSPOptions = static_cast<size_t>(DSP_Option::END_OF_LIST);
+    using ModuleSet = std::array<bool, numDSPOptions>;
+    
+    /*
+     modulePrepared is set once a module is prepared in all four MonoChannelDSPs, and is only cleared by prepareToPlay().
+     the audio thread copies it into modulesReady at the start of each block, so a module that becomes
+        ready halfway through a block is only used from the next one.
+     moduleSpec is the spec of the last prepareToPlay(). it and the preparing itself are guarded by moduleLock.
+     */
+    juce::CriticalSection moduleLock;
+    juce::dsp::ProcessSpec moduleSpec { 0.0, 0, 1 };
+    std::array<std::atomic<bool>, numDSPOptions> modulePrepared {};
+    //audio thread only
+    ModuleSet modulesReady {};
+    
+    void refreshModulesReady();
+    //moduleLock must be held
+    void prepareModules(const ModuleSet& modules);
+    static ModuleSet getModulesInOrder(const DSP_Order& order);
+    /*
+     any thread but the audio thread.
+     prepares the modules of an order before the audio thread is sent it: by sendCommand() and publishState().
+        bypassing a module in the order doesn't need anything prepared, so parameter changes never prepare.
+     until a module is prepared, the audio thread skips it in realtime. an offline render has every module prepared.
+     */
+    void prepareModulesAhead(const ModuleSet& modules);
+    /*
+     every module prepareModulesAhead() was asked for since the last prepareToPlay(), which keeps them.
+        they may be in an order that is still in the command queue. guarded by moduleLock.
+     */
+    ModuleSet modulesRequested {};
+    
+    void parameterValueChanged(int parameterIndex, float newValue) override;
+    void parameterGestureChanged(int, bool) override { }
+    
+    /*
+     bumped by everything that needs a control tick: parameter changes, from any thread, and modules becoming ready.
+     the audio thread notes the count at each tick, and starts one at the next block when it has moved on.
+     */
+    std::atomic<juce::uint32> controlChanges { 0 };
+    /*
+     set by reset(), from whichever thread the host calls it on.
+     the audio thread clears the chains at the next control tick, before it handles any command.
+     */
+    std::atomic<bool> resetRequested { false };
+    //audio thread only
+    juce::uint32 seenControlChanges = 0;
+    bool isControlWorkPending() const;
+    void applyParameterEvent(const ParameterEvent& event);
+    /*
+     set by applyParameterEvent() for each parameter it changed. the timer tells the parameter's listeners
+        (the APVTS and the editor's attachments) on the message thread, where taking their locks is fine.
+     */
+    std::array<std::atomic<bool>, numStateParams> eventChangedParams {};
+    void notifyEventChangedParams();
+    
+    DSP_Order lastReportedOrder;
+    int samplesUntilMeterFrame = 0;
+    
+    //audio thread only. the next control tick is due when this reaches 0. see processBlock().
+    int samplesUntilControlTick = 0;
+    //while nothing changes and no smoother is moving
+    static constexpr int noControlTickScheduled = std::numeric_limits<int>::max();
+    //set when a crossfade starts, until the incoming chain has been updated from the parameters
+    bool incomingChainStale = false;
+    
+    //sums of squares since the last meter frame: left and right before the chains, then after them
+    struct MeterWindow
+    {
+        std::array<double, 4> squares {};
+        int numSamples = 0;
+        
+        void accumulate(const juce::dsp::AudioBlock<float>& block, size_t first);
+    };
+    
+    MeterWindow meterWindow;
+    
+    //audio thread only. nanoseconds spent in each stage in the current block, and since the last CpuFrame.
+    bool profilingEnabled = false;
+    //the telemetry is sampled once per block, so a block is either timed completely or not at all
+    bool telemetryRunning = false;
+    bool stageTimingEnabled = false;
+    std::array<juce::int64, numProfileStages> blockStageNs {}, windowStageNs {};
+    std::array<float, numProfileStages> windowStagePeak {};
+    double windowAudioNs = 0.0;
+    
+    //adds the time until it goes out of scope to a stage. does nothing while profiling is off.
+    struct ScopedStageTimer
+    {
+        ScopedStageTimer(Project13AudioProcessor& proc, ProfileStage s)
+#if PROJECT13_PROFILE_DSP
+        : p(proc), stage(static_cast<size_t>(s))
+        {
+            if( p.stageTimingEnabled )
+                start = std::chrono::steady_clock::now();
+        }
+        
+        ~ScopedStageTimer()
+        {
+            if( p.stageTimingEnabled )
+                p.blockStageNs[stage] += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+        }
+        
+    private:
+        Project13AudioProcessor& p;
+        size_t stage;
+        std::chrono::steady_clock::time_point start;
+#else
+        {
+            juce::ignoreUnused(proc, s);
+        }
+#endif
+    };
+    
+    //decides whether this block is timed. returns the time the call started.
+    std::chrono::steady_clock::time_point beginProfileBlock();
+    //records the call in the telemetry, folds the block's stage times into the window, and sends a CpuFrame when one is due
+    void finishProfileBlock(int numSamples, bool frameDue, std::chrono::steady_clock::time_point callStart);
+    //the ProfileStage that took longest in this block, or numProfileStages if the untimed code did
+    size_t getSlowestStage(juce::int64 callNs) const;
+    void clearProfile();
+    
+    //drains the command queue. a SetOrder command is returned in newDSPOrder.
+    void handleCommands(DSP_Order& newDSPOrder, bool& snapshotRequested);
+    void reportOrder(bool snapshotRequested);
+    //sends a Quality event when the tier changed, or when the editor asked for a snapshot
+    void reportQuality(bool snapshotRequested);
+    void resetChains();
+    void changeOrder(const DSP_Order& newOrder, bool stateChanged, bool forceCrossfade = false);
+    void finishCrossfade();
+    //matrixPerChain: the gain stages left the mid/side matrix out, so each pair does its own
+    void processChains(juce::dsp::AudioBlock<float> subBlock, bool matrixPerChain);
+    
+    //the per-interval control work: messages, parameters, smoothing and DSP updates
+    void runControlTick();
+    void updateIncomingChain();
+    //audio work only: the gain stages, the chains, the envelope followers and the meters
+    void processSegment(juce::dsp::AudioBlock<float> segment, juce::dsp::AudioBlock<float> sidechainSegment);
+    //the sidechain bus's channels in the buffer, or no channels when it is off
+    juce::dsp::AudioBlock<float> getSidechainBlock(juce::AudioBuffer<float>& buffer);
+    
+    struct ProcessState
+    {
+        juce::dsp::ProcessorBase* processor = nullptr;
+        bool bypassed = false;
+    };
+    
+    using DSP_Pointers = std::array<ProcessState, maxChainSlots>;
+    
+#define VERIFY_BYPASS_FUNCTIONALITY false
+    
+    template<typename ParamType, typename Params, typename Funcs>
+    void initCachedParams(Params paramsArray, Funcs funcsArray)
+    {
+        for( size_t i = 0; i < paramsArray.size(); ++i )
+        {
+            auto ptrToParamPtr = paramsArray[i];
+            *ptrToParamPtr = dynamic_cast<ParamType>(apvts.getParameter(
+                 funcsArray[i]() ));
+            jassert( *ptrToParamPtr != nullptr );
+        }
+    }
+    
+    using SmootherList = std::array<juce::SmoothedValue<float>*, smoothedParams.size()>;
+    SmootherList getSmoothers();
+
+    StateSnapshot stateFromValueTree(const juce::ValueTree& tree) const;
+
+    enum class SmootherUpdateMode
+    {
+        initialize,
+        liveInRealtime
+    };
+    
+    void updateSmoothersFromParams(int numSamplesToSkip, SmootherUpdateMode init);
+    
+    static StateParam getBypassParam(DSP_Option option);
+    //the bypass the module follows on the side channel in mid/side mode
+    static StateParam getSideBypassParam(DSP_Option option);
+    /*
+     the parameter and smoother updates processBlock() does before running the chains.
+     the modules are prepared first if they aren't yet, like sendCommand() does for a new order.
+     */
+    void prepareBenchmarkBlock(int numSamples, const ModuleSet& modules);
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Project13AudioProcessor)
+};
@@ -0,0 +1,448 @@
+/*
+  ==============================================================================
+
+    PresetLibrary.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "PresetLibrary.h"
+#include "StateCodec.h"
+
+namespace
+{
+constexpr auto indexMagic = StateCodec::makeTag("P13I");
+constexpr juce::uint16 indexVersion = 1;
+constexpr int indexHeaderSize = 24;
+constexpr int indexEntrySize = 20;
+
+struct ScannedPreset
+{
+    juce::String name, relativePath;
+    juce::int64 modificationTime = 0;
+};
+
+std::vector<ScannedPreset> scanPresetFolder(const juce::File& folder)
+{
+    std::vector<ScannedPreset> presets;
+    if( folder.isDirectory() == false )
+        return presets;
+
+    for( const auto& entry : juce::RangedDirectoryIterator(folder,
+                                                           true,
+                                                           juce::String("*") + PresetLibrary::presetExtension,
+                                                           juce::File::findFiles) )
+    {
+        auto file = entry.getFile();
+        presets.push_back({ file.getFileNameWithoutExtension(),
+                            file.getRelativePathFrom(folder),
+                            entry.getModificationTime().toMilliseconds() });
+    }
+
+    std::sort(presets.begin(), presets.end(), [](const auto& a, const auto& b)
+    {
+        return a.name.compareNatural(b.name) < 0;
+    });
+
+    return presets;
+}
+
+juce::uint32 hashPresets(const std::vector<ScannedPreset>& presets)
+{
+    juce::MemoryOutputStream mos;
+    for( const auto& p : presets )
+    {
+        mos << p.relativePath;
+        mos.writeInt64(p.modificationTime);
+    }
+    return StateCodec::crc32(mos.getData(), mos.getDataSize());
+}
+
+bool writeIndex(const std::vector<ScannedPreset>& presets, juce::uint32 hash, const juce::File& indexFile)
+{
+    juce::MemoryOutputStream strings;
+    juce::MemoryOutputStream entries;
+
+    auto addString = [&strings](const juce::String& s, juce::MemoryOutputStream& dest)
+    {
+        auto utf8 = s.toUTF8();
+        auto numBytes = juce::jmin(static_cast<int>(utf8.sizeInBytes()) - 1, 0xFFFF);
+        dest.writeInt(static_cast<int>(strings.getDataSize()));
+        strings.write(utf8.getAddress(), static_cast<size_t>(numBytes));
+        return numBytes;
+    };
+
+    for( const auto& p : presets )
+    {
+        auto nameLength = addString(p.name, entries);
+        auto foldedLength = addString(p.name.toLowerCase(), entries);
+        auto fileLength = addString(p.relativePath, entries);
+        entries.writeShort(static_cast<short>(nameLength));
+        entries.writeShort(static_cast<short>(foldedLength));
+        entries.writeShort(static_cast<short>(fileLength));
+        entries.writeShort(0);
+    }
+
+    juce::MemoryOutputStream index;
+    index.writeInt(static_cast<int>(indexMagic));
+    index.writeShort(static_cast<short>(indexVersion));
+    index.writeShort(static_cast<short>(indexEntrySize));
+    index.writeInt(static_cast<int>(presets.size()));
+    index.writeInt(indexHeaderSize + static_cast<int>(entries.getDataSize()));
+    index.writeInt(static_cast<int>(strings.getDataSize()));
+    index.writeInt(static_cast<int>(hash));
+    index.write(entries.getData(), entries.getDataSize());
+    index.write(strings.getData(), strings.getDataSize());
+
+    /*
+     other instances may have the old index mapped, so the new one is written next to it and moved into place.
+     */
+    indexFile.getParentDirectory().createDirectory();
+    juce::TemporaryFile temp(indexFile);
+    if( temp.getFile().replaceWithData(index.getData(), index.getDataSize()) == false )
+        return false;
+
+    return temp.overwriteTargetFileWithTemporary();
+}
+} //end anonymous namespace
+
+//==============================================================================
+PresetLibrary::SharedIndex::SharedIndex()
+{
+    //mapping the existing index is cheap, so browsing works immediately
+    index = openIndex(getIndexFile());
+    if( index != nullptr )
+        numPresets = static_cast<int>(juce::ByteOrder::littleEndianInt(static_cast<const char*>(index->getData()) + 8));
+}
+
+PresetLibrary::SharedIndex::~SharedIndex()
+{
+    //every library is gone, and took its decode jobs with it. this only waits for a scan.
+    loaderThread.removeAllJobs(true, 5000);
+    cancelPendingUpdate();
+}
+
+void PresetLibrary::SharedIndex::scanOnce()
+{
+    if( scanStarted.exchange(true) == false )
+        rescanAsync();
+}
+
+void PresetLibrary::SharedIndex::rescanAsync()
+{
+    scanStarted = true;
+    loaderThread.addJob([this]()
+    {
+        auto rebuilt = rebuildIndexIfStale();
+        {
+            const juce::ScopedLock sl(pendingLock);
+            pendingIndex = std::move(rebuilt);
+        }
+        triggerAsyncUpdate();
+    });
+}
+
+void PresetLibrary::SharedIndex::addLibrary(PresetLibrary& library)
+{
+    const juce::ScopedLock sl(librariesLock);
+    libraries.addIfNotAlreadyThere(&library);
+}
+
+void PresetLibrary::SharedIndex::removeLibrary(PresetLibrary& library)
+{
+    const juce::ScopedLock sl(librariesLock);
+    libraries.removeFirstMatchingValue(&library);
+}
+
+void PresetLibrary::SharedIndex::handleAsyncUpdate()
+{
+    std::unique_ptr<juce::MemoryMappedFile> newIndex;
+    {
+        const juce::ScopedLock sl(pendingLock);
+        newIndex = std::move(pendingIndex);
+    }
+
+    if( newIndex == nullptr )
+        return;
+
+    index = std::move(newIndex);
+    numPresets = static_cast<int>(juce::ByteOrder::littleEndianInt(static_cast<const char*>(index->getData()) + 8));
+
+    //sendChangeMessage() is asynchronous, so this never calls back into a library while the lock is held
+    const juce::ScopedLock sl(librariesLock);
+    for( auto* library : libraries )
+        library->sendChangeMessage();
+}
+
+//==============================================================================
+struct PresetLibrary::DecodeJob : juce::ThreadPoolJob
+{
+    DecodeJob(PresetLibrary& l, const juce::File& f) : juce::ThreadPoolJob("Project13 preset decode"), library(l), file(f) { }
+
+    JobStatus runJob() override
+    {
+        library.decodePreset(file);
+        return jobHasFinished;
+    }
+
+    PresetLibrary& library;
+    const juce::File file;
+};
+
+PresetLibrary::PresetLibrary(Project13AudioProcessor& p) : processor(p)
+{
+    shared->addLibrary(*this);
+}
+
+PresetLibrary::~PresetLibrary()
+{
+    shared->removeLibrary(*this);
+
+    //the loader thread is shared, so only this library's own jobs are taken off it
+    struct OwnJobs : juce::ThreadPool::JobSelector
+    {
+        explicit OwnJobs(PresetLibrary& l) : library(l) { }
+
+        bool isJobSuitable(juce::ThreadPoolJob* job) override
+        {
+            auto* decode = dynamic_cast<DecodeJob*>(job);
+            return decode != nullptr && &decode->library == &library;
+        }
+
+        PresetLibrary& library;
+    };
+
+    OwnJobs ownJobs(*this);
+    shared->getLoaderThread().removeAllJobs(true, 5000, &ownJobs);
+    cancelPendingUpdate();
+}
+
+int PresetLibrary::getNumPresets() const
+{
+    shared->scanOnce();
+    return shared->getNumPresets();
+}
+
+juce::File PresetLibrary::getPresetFolder()
+{
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+        .getChildFile("Project13")
+        .getChildFile("Presets");
+}
+
+juce::File PresetLibrary::getIndexFile()
+{
+    //kept outside of the preset folder so it never shows up in a scan
+    return getPresetFolder().getSiblingFile("Presets.index");
+}
+
+std::unique_ptr<juce::MemoryMappedFile> PresetLibrary::openIndex(const juce::File& indexFile)
+{
+    if( indexFile.existsAsFile() == false )
+        return {};
+
+    auto mapped = std::make_unique<juce::MemoryMappedFile>(indexFile, juce::MemoryMappedFile::readOnly);
+    auto* data = static_cast<const char*>(mapped->getData());
+    auto size = mapped->getSize();
+    if( data == nullptr || size < static_cast<size_t>(indexHeaderSize) )
+        return {};
+
+    if( juce::ByteOrder::littleEndianInt(data) != indexMagic ||
+        juce::ByteOrder::littleEndianShort(data + 4) != indexVersion ||
+        juce::ByteOrder::littleEndianShort(data + 6) != indexEntrySize )
+        return {};
+
+    auto numEntries = static_cast<size_t>(juce::ByteOrder::littleEndianInt(data + 8));
+    auto stringsOffset = static_cast<size_t>(juce::ByteOrder::littleEndianInt(data + 12));
+    auto stringsSize = static_cast<size_t>(juce::ByteOrder::littleEndianInt(data + 16));
+
+    if( stringsOffset != indexHeaderSize + numEntries * indexEntrySize ||
+        stringsOffset + stringsSize > size )
+        return {};
+
+    return mapped;
+}
+
+std::unique_ptr<juce::MemoryMappedFile> PresetLibrary::rebuildIndexIfStale()
+{
+    auto presets = scanPresetFolder(getPresetFolder());
+    auto hash = hashPresets(presets);
+    auto indexFile = getIndexFile();
+
+    auto existing = openIndex(indexFile);
+    if( existing != nullptr &&
+        juce::ByteOrder::littleEndianInt(static_cast<const char*>(existing->getData()) + 20) == hash )
+    {
+        return existing;
+    }
+
+    DBG( "PresetLibrary: rebuilding index for " << static_cast<int>(presets.size()) << " presets" );
+    existing.reset();
+    if( writeIndex(presets, hash, indexFile) == false )
+        return {};
+
+    return openIndex(indexFile);
+}
+
+bool PresetLibrary::SharedIndex::getEntry(int idx, IndexEntry& entry) const
+{
+    if( index == nullptr )
+        return false;
+
+    auto* data = static_cast<const char*>(index->getData());
+    auto numEntries = static_cast<int>(juce::ByteOrder::littleEndianInt(data + 8));
+    if( juce::isPositiveAndBelow(idx, numEntries) == false )
+        return false;
+
+    auto* strings = data + juce::ByteOrder::littleEndianInt(data + 12);
+    auto stringsSize = juce::ByteOrder::littleEndianInt(data + 16);
+    auto* e = data + indexHeaderSize + idx * indexEntrySize;
+
+    auto nameOffset = juce::ByteOrder::littleEndianInt(e);
+    auto foldedOffset = juce::ByteOrder::littleEndianInt(e + 4);
+    auto fileOffset = juce::ByteOrder::littleEndianInt(e + 8);
+    entry.nameLength = juce::ByteOrder::littleEndianShort(e + 12);
+    entry.foldedLength = juce::ByteOrder::littleEndianShort(e + 14);
+    entry.fileLength = juce::ByteOrder::littleEndianShort(e + 16);
+
+    if( nameOffset + entry.nameLength > stringsSize ||
+        foldedOffset + entry.foldedLength > stringsSize ||
+        fileOffset + entry.fileLength > stringsSize )
+    {
+        jassertfalse;
+        return false;
+    }
+
+    entry.name = strings + nameOffset;
+    entry.folded = strings + foldedOffset;
+    entry.file = strings + fileOffset;
+    return true;
+}
+
+juce::String PresetLibrary::getPresetName(int idx) const
+{
+    IndexEntry entry;
+    if( shared->getEntry(idx, entry) == false )
+        return {};
+
+    return juce::String::fromUTF8(entry.name, entry.nameLength);
+}
+
+juce::File PresetLibrary::getPresetFile(int idx) const
+{
+    IndexEntry entry;
+    if( shared->getEntry(idx, entry) == false )
+        return {};
+
+    return getPresetFolder().getChildFile(juce::String::fromUTF8(entry.file, entry.fileLength));
+}
+
+std::vector<int> PresetLibrary::search(const juce::String& query, int maxResults) const
+{
+    std::vector<int> results;
+    auto folded = query.trim().toLowerCase().toStdString();
+    auto numEntries = getNumPresets();
+
+    IndexEntry entry;
+    for( int i = 0; i < numEntries && static_cast<int>(results.size()) < maxResults; ++i )
+    {
+        if( shared->getEntry(i, entry) == false )
+            break;
+
+        if( folded.empty() ||
+            std::string_view(entry.folded, static_cast<size_t>(entry.foldedLength)).find(folded) != std::string_view::npos )
+        {
+            results.push_back(i);
+        }
+    }
+
+    return results;
+}
+
+void PresetLibrary::rescanAsync()
+{
+    shared->rescanAsync();
+}
+
+bool PresetLibrary::savePreset(const juce::String& name)
+{
+    auto legalName = juce::File::createLegalFileName(name.trim());
+    if( legalName.isEmpty() )
+        return false;
+
+    auto folder = getPresetFolder();
+    if( folder.createDirectory().failed() )
+        return false;
+
+    juce::MemoryBlock chunk;
+    processor.getStateInformation(chunk);
+
+    auto file = folder.getChildFile(legalName + presetExtension);
+    if( file.replaceWithData(chunk.getData(), chunk.getSize()) == false )
+        return false;
+
+    rescanAsync();
+    return true;
+}
+
+void PresetLibrary::loadPresetAsync(int idx)
+{
+    /*
+     hosts may call setCurrentProgram() from any thread, so this only records the request.
+     the file lookup happens on the message thread, the decoding on the loader thread.
+     */
+    shared->scanOnce();
+    requestedPreset = idx;
+    triggerAsyncUpdate();
+}
+
+void PresetLibrary::decodePreset(const juce::File& file)
+{
+    //loader thread
+    juce::MemoryBlock chunk;
+    if( file.loadFileAsData(chunk) == false )
+        return;
+
+    auto snapshot = processor.getDefaultState();
+    if( StateCodec::read(chunk.getData(), static_cast<int>(chunk.getSize()), snapshot) == false )
+    {
+        DBG( "PresetLibrary: couldn't decode " << file.getFullPathName() );
+        return;
+    }
+
+    auto landing = std::make_unique<PendingLanding>();
+    landing->snapshot = snapshot;
+    landing->generation = processor.publishState(snapshot);
+    {
+        const juce::ScopedLock sl(pendingLock);
+        pendingLanding = std::move(landing);
+    }
+    triggerAsyncUpdate();
+}
+
+void PresetLibrary::handleAsyncUpdate()
+{
+    std::unique_ptr<PendingLanding> landing;
+    {
+        const juce::ScopedLock sl(pendingLock);
+        landing = std::move(pendingLanding);
+    }
+
+    if( landing != nullptr )
+    {
+        processor.landState(landing->snapshot, landing->generation);
+    }
+
+    auto requested = requestedPreset.exchange(-1);
+    if( requested >= 0 )
+    {
+        auto file = getPresetFile(requested);
+        if( file.existsAsFile() )
+        {
+            currentPreset = requested;
+            shared->getLoaderThread().addJob(new DecodeJob(*this, file), true);
+            sendChangeMessage();
+        }
+    }
+}
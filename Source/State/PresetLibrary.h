@@ -0,0 +1,164 @@
+/*
+  ==============================================================================
+
+    PresetLibrary.h
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../PluginProcessor.h"
+
+/*
+ Presets are stored on disk as the plugin's compact state chunk (see StateCodec.h), one file per preset.
+
+ Browsing thousands of presets by reading each file is too slow, so the library keeps an index file that is
+    memory-mapped. Listing, naming and searching presets read straight from the mapping without parsing anything.
+ The index is rebuilt on the loader thread whenever the preset folder's contents change.
+
+ The mapped index and the loader thread are shared by every instance in the process (see SharedIndex),
+    so a session with 50 instances has one loader thread, and scans the folder once.
+    the first scan starts the first time any instance browses or loads a preset, not when it is created.
+
+ index layout (little-endian):
+    header (24 bytes)
+        uint32  magic 'P13I'
+        uint16  version
+        uint16  entry size
+        uint32  number of entries
+        uint32  offset of the string table
+        uint32  size of the string table
+        uint32  hash of every preset path + modification time, used to detect a stale index
+    entries (entry size bytes each, sorted by name)
+        uint32  name offset         uint32  folded (lower case) name offset
+        uint32  file offset         uint16  name length
+        uint16  folded name length  uint16  file length
+        uint16  reserved
+    string table
+        UTF-8 bytes. file paths are relative to the preset folder.
+
+ Loading a preset never touches the audio thread's locks or allocates there:
+    - the file is read and decoded on the loader thread
+    - the decoded snapshot is published to the audio thread with Project13AudioProcessor::publishState()
+    - the message thread then writes the values into the parameters with landState()
+ */
+struct PresetLibrary : juce::ChangeBroadcaster, private juce::AsyncUpdater
+{
+    PresetLibrary(Project13AudioProcessor& p);
+    ~PresetLibrary() override;
+
+    static juce::File getPresetFolder();
+    static juce::File getIndexFile();
+    static constexpr const char* presetExtension = ".p13preset";
+
+    /*
+     browsing. these read from the memory-mapped index and should be called from the message thread.
+     a change message is sent whenever the index is replaced.
+     */
+    int getNumPresets() const;
+    juce::String getPresetName(int index) const;
+    juce::File getPresetFile(int index) const;
+    /*
+     case-insensitive substring search over the preset names.
+     an empty query returns the first maxResults presets.
+     */
+    std::vector<int> search(const juce::String& query, int maxResults) const;
+
+    int getCurrentPreset() const { return currentPreset.load(); }
+
+    /*
+     safe to call from any thread. the file is read and decoded on the loader thread.
+     */
+    void loadPresetAsync(int index);
+
+    //message thread. saves the current state and rescans the folder for every instance.
+    bool savePreset(const juce::String& name);
+    void rescanAsync();
+
+private:
+    void handleAsyncUpdate() override;
+
+    void decodePreset(const juce::File& file);
+    //a decodePreset() call waiting on the shared loader thread. see the destructor.
+    struct DecodeJob;
+
+    struct IndexEntry
+    {
+        const char* name = nullptr;
+        const char* folded = nullptr;
+        const char* file = nullptr;
+        int nameLength = 0, foldedLength = 0, fileLength = 0;
+    };
+
+    /*
+     the part of the library that is the same for every instance: the mapped index and the loader thread.
+     held through a juce::SharedResourcePointer, so it is created with the first instance and
+        deleted with the last one.
+     */
+    struct SharedIndex : private juce::AsyncUpdater
+    {
+        SharedIndex();
+        ~SharedIndex() override;
+
+        //any thread. starts the first scan, once.
+        void scanOnce();
+        //any thread
+        void rescanAsync();
+        int getNumPresets() const { return numPresets.load(); }
+        //message thread only
+        bool getEntry(int index, IndexEntry& entry) const;
+
+        //any thread. the libraries are told when the index is replaced.
+        void addLibrary(PresetLibrary& library);
+        void removeLibrary(PresetLibrary& library);
+
+        juce::ThreadPool& getLoaderThread() { return loaderThread; }
+
+    private:
+        void handleAsyncUpdate() override;
+
+        //message thread only
+        std::unique_ptr<juce::MemoryMappedFile> index;
+        std::atomic<int> numPresets { 0 };
+        std::atomic<bool> scanStarted { false };
+
+        juce::CriticalSection librariesLock;
+        juce::Array<PresetLibrary*> libraries;
+
+        //handed from the loader thread to the message thread
+        juce::CriticalSection pendingLock;
+        std::unique_ptr<juce::MemoryMappedFile> pendingIndex;
+
+        //last, so its thread stops before anything it uses goes away
+        juce::ThreadPool loaderThread { 1 };
+
+        JUCE_DECLARE_NON_COPYABLE(SharedIndex)
+    };
+
+    static std::unique_ptr<juce::MemoryMappedFile> openIndex(const juce::File& indexFile);
+    static std::unique_ptr<juce::MemoryMappedFile> rebuildIndexIfStale();
+
+    Project13AudioProcessor& processor;
+    juce::SharedResourcePointer<SharedIndex> shared;
+
+    std::atomic<int> currentPreset { -1 };
+    std::atomic<int> requestedPreset { -1 };
+
+    struct PendingLanding
+    {
+        Project13AudioProcessor::StateSnapshot snapshot;
+        juce::uint32 generation = 0;
+    };
+
+    /*
+     handed from the loader thread to the message thread.
+     this lock is never taken by the audio thread.
+     */
+    juce::CriticalSection pendingLock;
+    std::unique_ptr<PendingLanding> pendingLanding;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PresetLibrary)
+};
@@ -0,0 +1,287 @@
+/*
+  ==============================================================================
+
+    StateCodec.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "StateCodec.h"
+
+namespace StateCodec
+{
+static constexpr int headerSize = 8;
+static constexpr int checksumSize = 4;
+static constexpr int sectionHeaderSize = 8;
+static constexpr int lfoSize = 5, envelopeSize = 10, routeSize = 7;
+
+static int countRoutes(const ModMatrix::Routing& routing)
+{
+    //the columns past the processor's targets can't be routed, so they aren't written
+    constexpr auto numTargets = static_cast<std::ptrdiff_t>(Project13AudioProcessor::numModTargets);
+    int count = 0;
+    for( const auto& row : routing.depths )
+        count += static_cast<int>(std::count_if(row.begin(), row.begin() + numTargets, [](auto depth) { return depth != 0.f; }));
+
+    return count;
+}
+
+static constexpr auto crcTable = []()
+{
+    std::array<juce::uint32, 256> table {};
+    for( juce::uint32 i = 0; i < 256; ++i )
+    {
+        auto c = i;
+        for( int k = 0; k < 8; ++k )
+            c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+        table[i] = c;
+    }
+    return table;
+}();
+
+juce::uint32 crc32(const void* data, size_t numBytes)
+{
+    auto* bytes = static_cast<const juce::uint8*>(data);
+    juce::uint32 crc = 0xFFFFFFFFu;
+    for( size_t i = 0; i < numBytes; ++i )
+        crc = crcTable[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+
+    return crc ^ 0xFFFFFFFFu;
+}
+
+bool isCompactState(const void* data, int sizeInBytes)
+{
+    if( data == nullptr || sizeInBytes < headerSize + checksumSize )
+        return false;
+
+    return juce::ByteOrder::littleEndianInt(data) == magic;
+}
+
+void write(const Project13AudioProcessor::StateSnapshot& snapshot, juce::MemoryBlock& destData)
+{
+    using P = Project13AudioProcessor;
+    const auto paramsPayloadSize = 2 + static_cast<int>(P::numStateParams * sizeof(float));
+    const auto orderPayloadSize = 1 + static_cast<int>(snapshot.order.size());
+    const auto hasMorph = snapshot.morph.valid;
+    const auto morphPayloadSize = 2 + static_cast<int>(2 * P::numStateParams * sizeof(float));
+    const auto hasModulation = snapshot.modulation != ModMatrix::Routing();
+    const auto numRoutes = countRoutes(snapshot.modulation);
+    const auto modulationPayloadSize = 1 + static_cast<int>(ModMatrix::numLfos) * lfoSize
+        + 1 + static_cast<int>(ModMatrix::numEnvelopes) * envelopeSize
+        + 2 + numRoutes * routeSize;
+
+    const auto totalSize = headerSize +
+        sectionHeaderSize + paramsPayloadSize +
+        sectionHeaderSize + orderPayloadSize +
+        (hasMorph ? sectionHeaderSize + morphPayloadSize : 0) +
+        (hasModulation ? sectionHeaderSize + modulationPayloadSize : 0) +
+        checksumSize;
+
+    destData.setSize(static_cast<size_t>(totalSize));
+    /*
+     MemoryOutputStream writes little-endian and only reallocates if the block is too small,
+        which it isn't.
+     */
+    juce::MemoryOutputStream mos(destData, false);
+
+    mos.writeInt(static_cast<int>(magic));
+    mos.writeShort(static_cast<short>(formatVersion));
+    mos.writeShort(static_cast<short>(2 + (hasMorph ? 1 : 0) + (hasModulation ? 1 : 0))); //number of sections
+
+    mos.writeInt(static_cast<int>(paramsTag));
+    mos.writeInt(paramsPayloadSize);
+    mos.writeShort(static_cast<short>(P::numStateParams));
+    for( auto v : snapshot.values )
+        mos.writeFloat(v);
+
+    mos.writeInt(static_cast<int>(orderTag));
+    mos.writeInt(orderPayloadSize);
+    mos.writeByte(static_cast<char>(snapshot.order.size()));
+    for( auto option : snapshot.order )
+        mos.writeByte(static_cast<char>(option));
+
+    if( hasMorph )
+    {
+        mos.writeInt(static_cast<int>(morphTag));
+        mos.writeInt(morphPayloadSize);
+        mos.writeShort(static_cast<short>(P::numStateParams));
+        for( auto v : snapshot.morph.a )
+            mos.writeFloat(v);
+        for( auto v : snapshot.morph.b )
+            mos.writeFloat(v);
+    }
+
+    if( hasModulation )
+    {
+        const auto& routing = snapshot.modulation;
+        mos.writeInt(static_cast<int>(modulationTag));
+        mos.writeInt(modulationPayloadSize);
+
+        mos.writeByte(static_cast<char>(routing.lfos.size()));
+        for( const auto& lfo : routing.lfos )
+        {
+            mos.writeFloat(lfo.rateHz);
+            mos.writeByte(static_cast<char>(lfo.shape));
+        }
+
+        mos.writeByte(static_cast<char>(routing.envelopes.size()));
+        for( const auto& envelope : routing.envelopes )
+        {
+            mos.writeFloat(envelope.attackMs);
+            mos.writeFloat(envelope.releaseMs);
+            mos.writeByte(static_cast<char>(envelope.detector));
+            mos.writeByte(static_cast<char>(envelope.input));
+        }
+
+        mos.writeShort(static_cast<short>(numRoutes));
+        for( size_t s = 0; s < ModMatrix::numSources; ++s )
+        {
+            for( size_t t = 0; t < P::numModTargets; ++t )
+            {
+                if( auto depth = routing.depths[s][t]; depth != 0.f )
+                {
+                    mos.writeByte(static_cast<char>(s));
+                    mos.writeShort(static_cast<short>(P::smoothedParams[t]));
+                    mos.writeFloat(depth);
+                }
+            }
+        }
+    }
+
+    jassert(static_cast<int>(mos.getDataSize()) == totalSize - checksumSize);
+    mos.writeInt(static_cast<int>(crc32(mos.getData(), mos.getDataSize())));
+}
+
+bool read(const void* data, int sizeInBytes, Project13AudioProcessor::StateSnapshot& snapshot)
+{
+    using P = Project13AudioProcessor;
+
+    if( isCompactState(data, sizeInBytes) == false )
+        return false;
+
+    auto* bytes = static_cast<const juce::uint8*>(data);
+    const auto bodySize = static_cast<size_t>(sizeInBytes - checksumSize);
+    if( juce::ByteOrder::littleEndianInt(bytes + bodySize) != crc32(bytes, bodySize) )
+    {
+        DBG( "StateCodec::read checksum mismatch" );
+        return false;
+    }
+
+    juce::MemoryInputStream mis(data, bodySize, false);
+    mis.readInt(); //magic
+    auto version = static_cast<juce::uint16>(mis.readShort());
+    if( version > formatVersion )
+    {
+        DBG( "StateCodec::read chunk version " << version << " is newer than " << formatVersion );
+        return false;
+    }
+
+    auto result = snapshot;
+    auto numSections = static_cast<juce::uint16>(mis.readShort());
+    for( int s = 0; s < numSections; ++s )
+    {
+        if( mis.getNumBytesRemaining() < sectionHeaderSize )
+            return false;
+
+        auto tag = static_cast<juce::uint32>(mis.readInt());
+        auto payloadSize = mis.readInt();
+        if( payloadSize < 0 || payloadSize > mis.getNumBytesRemaining() )
+            return false;
+
+        auto sectionEnd = mis.getPosition() + payloadSize;
+
+        if( tag == paramsTag && payloadSize >= 2 )
+        {
+            auto count = static_cast<size_t>(static_cast<juce::uint16>(mis.readShort()));
+            count = juce::jmin(count, static_cast<size_t>(payloadSize - 2) / sizeof(float));
+            //params this build doesn't know about yet are skipped with the rest of the section.
+            for( size_t i = 0; i < juce::jmin(count, P::numStateParams); ++i )
+                result.values[i] = mis.readFloat();
+        }
+        else if( tag == orderTag && payloadSize >= 1 )
+        {
+            auto count = static_cast<size_t>(static_cast<juce::uint8>(mis.readByte()));
+            //chunks from before the slot pool always hold the 5 modules
+            if( count >= 1 && count <= P::maxChainSlots && static_cast<int>(count) + 1 <= payloadSize )
+            {
+                for( size_t i = 0; i < count; ++i )
+                    result.order.add(static_cast<P::DSP_Option>(mis.readByte()));
+            }
+        }
+
+        else if( tag == morphTag && payloadSize >= 2 )
+        {
+            auto count = static_cast<size_t>(static_cast<juce::uint16>(mis.readShort()));
+            if( 2 + count * 2 * sizeof(float) <= static_cast<size_t>(payloadSize) )
+            {
+                /*
+                 snapshots from older builds lack the newer params.
+                 those take the values already in 'result', so they don't morph.
+                 */
+                result.morph.a = result.values;
+                result.morph.b = result.values;
+                for( auto* dest : { &result.morph.a, &result.morph.b } )
+                {
+                    for( size_t i = 0; i < count; ++i )
+                    {
+                        auto v = mis.readFloat();
+                        if( i < P::numStateParams )
+                            (*dest)[i] = v;
+                    }
+                }
+                result.morph.valid = true;
+            }
+        }
+        else if( tag == modulationTag )
+        {
+            //anything this build doesn't know about, i.e. a third LFO, is skipped
+            auto routing = ModMatrix::Routing();
+            auto numLfos = static_cast<size_t>(static_cast<juce::uint8>(mis.readByte()));
+            for( size_t i = 0; i < numLfos; ++i )
+            {
+                auto rate = mis.readFloat();
+                auto shape = static_cast<juce::uint8>(mis.readByte());
+                if( i < routing.lfos.size() && shape < static_cast<juce::uint8>(ModMatrix::LfoShape::END_OF_LIST) )
+                    routing.lfos[i] = { rate, static_cast<ModMatrix::LfoShape>(shape) };
+            }
+
+            auto numEnvelopes = static_cast<size_t>(static_cast<juce::uint8>(mis.readByte()));
+            for( size_t i = 0; i < numEnvelopes; ++i )
+            {
+                auto attack = mis.readFloat();
+                auto release = mis.readFloat();
+                auto detector = static_cast<juce::uint8>(mis.readByte());
+                auto input = static_cast<juce::uint8>(mis.readByte());
+                if( i < routing.envelopes.size()
+                   && detector < static_cast<juce::uint8>(ModMatrix::Detector::END_OF_LIST)
+                   && input < static_cast<juce::uint8>(ModMatrix::EnvelopeInput::END_OF_LIST) )
+                {
+                    routing.envelopes[i] = { attack, release,
+                        static_cast<ModMatrix::Detector>(detector), static_cast<ModMatrix::EnvelopeInput>(input) };
+                }
+            }
+
+            auto numRoutes = static_cast<int>(static_cast<juce::uint16>(mis.readShort()));
+            for( int i = 0; i < numRoutes && mis.getPosition() + routeSize <= sectionEnd; ++i )
+            {
+                auto source = static_cast<size_t>(static_cast<juce::uint8>(mis.readByte()));
+                auto param = static_cast<size_t>(static_cast<juce::uint16>(mis.readShort()));
+                auto depth = mis.readFloat();
+                auto target = param < P::numStateParams ? P::getModTarget(static_cast<P::StateParam>(param)) : std::nullopt;
+                if( source < ModMatrix::numSources && target.has_value() )
+                    routing.setDepth(static_cast<ModMatrix::Source>(source), *target, depth);
+            }
+
+            //a truncated section reads zeros, so check before trusting it
+            if( mis.getPosition() <= sectionEnd )
+                result.modulation = routing;
+        }
+
+        mis.setPosition(sectionEnd);
+    }
+
+    snapshot = result;
+    return true;
+}
+} //end namespace StateCodec
@@ -0,0 +1,80 @@
+/*
+  ==============================================================================
+
+    StateCodec.h
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../PluginProcessor.h"
+
+/*
+ The compact binary plugin state.
+
+ Hosts call getStateInformation() for every undo step and autosave.
+ Writing the whole APVTS ValueTree (plus an XML dump when loading) was the slow part of saving big sessions.
+ This format is a small fixed layout that can be written and read without building any trees:
+
+    offset  size
+    0       4       magic 'P13S'
+    4       2       format version
+    6       2       number of sections
+    8       ...     sections: [ tag (4) | payload size (4) | payload ]
+    end-4   4       CRC-32 of every byte before it
+
+ sections:
+    'PARM'  uint16 count, then 'count' floats. the index of each float is its StateParam stable ID.
+    'ORDR'  uint8 count, then 'count' DSP_Option bytes. 1 to maxChainSlots of them.
+    'MRPH'  uint16 count, then 'count' floats for morph snapshot A and 'count' floats for B.
+            only written once a morph snapshot has been stored.
+    'MODM'  the modulation routing. only written when it isn't the default.
+            uint8 count, then per LFO: float rate in Hz, uint8 ModMatrix::LfoShape.
+            uint8 count, then per envelope follower: float attack in ms, float release in ms,
+                uint8 ModMatrix::Detector, uint8 ModMatrix::EnvelopeInput.
+            uint16 count, then per route: uint8 ModMatrix::Source, uint16 target StateParam stable ID, float depth.
+            only the routes with a depth are stored.
+
+ Unknown sections are skipped, so newer chunks still load in older builds.
+ Chunks with fewer parameters than this build knows about leave the missing ones at their defaults.
+ The format version is only bumped if the existing layout changes in an incompatible way.
+ All integers are little-endian.
+ */
+namespace StateCodec
+{
+    constexpr juce::uint32 makeTag(const char (&t)[5])
+    {
+        return static_cast<juce::uint32>(static_cast<juce::uint8>(t[0])) |
+            static_cast<juce::uint32>(static_cast<juce::uint8>(t[1])) << 8 |
+            static_cast<juce::uint32>(static_cast<juce::uint8>(t[2])) << 16 |
+            static_cast<juce::uint32>(static_cast<juce::uint8>(t[3])) << 24;
+    }
+
+    static constexpr juce::uint32 magic = makeTag("P13S");
+    static constexpr juce::uint16 formatVersion = 1;
+
+    static constexpr juce::uint32 paramsTag = makeTag("PARM");
+    static constexpr juce::uint32 orderTag = makeTag("ORDR");
+    static constexpr juce::uint32 morphTag = makeTag("MRPH");
+    static constexpr juce::uint32 modulationTag = makeTag("MODM");
+
+    /*
+     true if the data starts with the compact state magic number.
+     anything else is treated as a ValueTree chunk from an older version.
+     */
+    bool isCompactState(const void* data, int sizeInBytes);
+
+    void write(const Project13AudioProcessor::StateSnapshot& snapshot, juce::MemoryBlock& destData);
+
+    /*
+     'snapshot' should already hold the default state.
+     returns false if the chunk is truncated, fails its checksum, or has a newer format version.
+     'snapshot' is left untouched in that case.
+     */
+    bool read(const void* data, int sizeInBytes, Project13AudioProcessor::StateSnapshot& snapshot);
+
+    juce::uint32 crc32(const void* data, size_t numBytes);
+}
@@ -0,0 +1,251 @@
+/*
+  ==============================================================================
+
+    UndoJournal.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "UndoJournal.h"
+
+namespace
+{
+juce::uint32 floatBits(float v)
+{
+    juce::uint32 bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    return bits;
+}
+
+float bitsToFloat(juce::uint32 bits)
+{
+    float v;
+    std::memcpy(&v, &bits, sizeof(v));
+    return v;
+}
+} //end anonymous namespace
+
+UndoJournal::UndoJournal(P& p) : processor(p)
+{
+    gestureStartValues.fill(std::numeric_limits<float>::quiet_NaN());
+    stateParamForIndex.resize(static_cast<size_t>(processor.getParameters().size()), -1);
+
+    for( size_t i = 0; i < P::numStateParams; ++i )
+    {
+        //the selected tab is navigation, not an edit
+        if( static_cast<P::StateParam>(i) == P::StateParam::SelectedTab )
+            continue;
+
+        auto* param = processor.stateParams[i];
+        stateParamForIndex[static_cast<size_t>(param->getParameterIndex())] = static_cast<int>(i);
+        param->addListener(this);
+    }
+
+    currentOrder = processor.captureState().order;
+}
+
+UndoJournal::~UndoJournal()
+{
+    for( auto* param : processor.stateParams )
+        param->removeListener(this);
+}
+
+juce::uint32 UndoJournal::packOrder(const P::DSP_Order& order)
+{
+    //4 bits per slot. the slots after the last one are END_OF_LIST.
+    static_assert(P::maxChainSlots * 4 <= 32, "DSP_Order no longer fits in a journal entry");
+    static_assert(static_cast<int>(P::DSP_Option::END_OF_LIST) < 16, "DSP_Option no longer fits in 4 bits");
+
+    juce::uint32 packed = 0;
+    for( size_t i = 0; i < P::maxChainSlots; ++i )
+    {
+        auto option = i < order.size() ? order[i] : P::DSP_Option::END_OF_LIST;
+        packed |= static_cast<juce::uint32>(option) << (i * 4);
+    }
+
+    return packed;
+}
+
+Project13AudioProcessor::DSP_Order UndoJournal::unpackOrder(juce::uint32 packed)
+{
+    P::DSP_Order order;
+    for( size_t i = 0; i < P::maxChainSlots; ++i )
+    {
+        auto option = static_cast<P::DSP_Option>((packed >> (i * 4)) & 0xF);
+        if( option == P::DSP_Option::END_OF_LIST )
+            break;
+
+        order.add(option);
+    }
+
+    return order;
+}
+
+void UndoJournal::parameterValueChanged(int parameterIndex, float newValue)
+{
+    //only the values at the start and end of a gesture are journaled
+    juce::ignoreUnused(parameterIndex, newValue);
+}
+
+void UndoJournal::parameterGestureChanged(int parameterIndex, bool gestureIsStarting)
+{
+    /*
+     gestures from the editor arrive on the message thread.
+     gestures a host sends from another thread are left to the host's own undo.
+     */
+    if( applying || juce::MessageManager::existsAndIsCurrentThread() == false )
+        return;
+
+    if( juce::isPositiveAndBelow(parameterIndex, static_cast<int>(stateParamForIndex.size())) == false )
+        return;
+
+    auto idx = stateParamForIndex[static_cast<size_t>(parameterIndex)];
+    if( idx < 0 )
+        return;
+
+    auto* param = processor.stateParams[static_cast<size_t>(idx)];
+    auto& startValue = gestureStartValues[static_cast<size_t>(idx)];
+
+    if( gestureIsStarting )
+    {
+        if( std::isnan(startValue) == false )
+            return; //nested gesture on the same parameter
+
+        //the first gesture of a group starts a new undo step
+        if( openGestures++ == 0 )
+            ++currentStep;
+
+        startValue = param->getValue();
+        return;
+    }
+
+    if( std::isnan(startValue) )
+        return; //the gesture started before the journal existed
+
+    auto endValue = param->getValue();
+    if( endValue != startValue )
+        record(static_cast<juce::uint16>(idx), floatBits(startValue), floatBits(endValue));
+
+    startValue = std::numeric_limits<float>::quiet_NaN();
+    if( --openGestures == 0 )
+        sendChangeMessage();
+}
+
+void UndoJournal::recordOrderChange(const P::DSP_Order& newOrder)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    if( newOrder == currentOrder )
+        return;
+
+    //a drag is a gesture of its own, unless a knob gesture is still open
+    if( openGestures == 0 )
+        ++currentStep;
+
+    record(orderTarget, packOrder(currentOrder), packOrder(newOrder));
+    currentOrder = newOrder;
+    sendChangeMessage();
+}
+
+void UndoJournal::noteCurrentOrder(const P::DSP_Order& order)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+    currentOrder = order;
+}
+
+void UndoJournal::record(juce::uint16 target, juce::uint32 from, juce::uint32 to)
+{
+    //new edits throw away everything that could have been redone
+    numEntries = numApplied;
+
+    //coalesce with an earlier change to the same target in this step
+    for( int i = numApplied - 1; i >= 0 && at(i).step == currentStep; --i )
+    {
+        if( at(i).target == target )
+        {
+            at(i).to = to;
+            return;
+        }
+    }
+
+    if( numEntries == capacity )
+    {
+        //drop the oldest step. if the step being recorded fills the whole ring, drop its oldest entry.
+        auto dropped = 1;
+        while( dropped < numEntries && at(dropped).step == at(0).step )
+            ++dropped;
+
+        if( dropped == numEntries )
+            dropped = 1;
+
+        oldest = (oldest + dropped) % capacity;
+        numEntries -= dropped;
+        numApplied -= dropped;
+    }
+
+    auto& e = at(numEntries);
+    e.step = currentStep;
+    e.target = target;
+    e.from = from;
+    e.to = to;
+
+    ++numEntries;
+    ++numApplied;
+}
+
+void UndoJournal::apply(const Entry& e, bool useNewValue)
+{
+    auto value = useNewValue ? e.to : e.from;
+    if( e.target == orderTarget )
+    {
+        currentOrder = unpackOrder(value);
+        //the audio thread reports the new order back to the editor, which rebuilds its tabs
+        processor.sendCommand(P::Command::setOrder(currentOrder));
+        return;
+    }
+
+    auto* param = processor.stateParams[e.target];
+    //the gesture lets the host record the change in its own automation
+    param->beginChangeGesture();
+    param->setValueNotifyingHost(bitsToFloat(value));
+    param->endChangeGesture();
+}
+
+bool UndoJournal::undo()
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    if( canUndo() == false )
+        return false;
+
+    const juce::ScopedValueSetter<bool> svs(applying, true);
+    auto step = at(numApplied - 1).step;
+    while( numApplied > 0 && at(numApplied - 1).step == step )
+    {
+        --numApplied;
+        apply(at(numApplied), false);
+    }
+
+    sendChangeMessage();
+    return true;
+}
+
+bool UndoJournal::redo()
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    if( canRedo() == false )
+        return false;
+
+    const juce::ScopedValueSetter<bool> svs(applying, true);
+    auto step = at(numApplied).step;
+    while( numApplied < numEntries && at(numApplied).step == step )
+    {
+        apply(at(numApplied), true);
+        ++numApplied;
+    }
+
+    sendChangeMessage();
+    return true;
+}
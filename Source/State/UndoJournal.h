@@ -0,0 +1,100 @@
+/*
+  ==============================================================================
+
+    UndoJournal.h
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../PluginProcessor.h"
+
+/*
+ Undo/redo for parameter tweaks and tab reorders.
+
+ juce::UndoManager with ValueTree property actions keeps one action object per property change,
+    so a long session of knob twiddling grows without bound.
+ This journal only records what a whole gesture changed:
+    when a parameter's begin/endChangeGesture pair completes, one delta (old value -> new value) is stored.
+    gestures that overlap are grouped into a single undo step.
+    a parameter changed more than once in the same step keeps a single delta.
+ DSP_Order changes are stored as a packed delta in the same way.
+
+ The entries live in a fixed-size ring. When it is full, the oldest undo step is dropped,
+    so memory per instance is capacity * sizeof(Entry) and never grows.
+
+ Changes made without a gesture (host automation, preset loads, state restores) aren't recorded.
+ Everything here runs on the message thread.
+ */
+struct UndoJournal : juce::ChangeBroadcaster, private juce::AudioProcessorParameter::Listener
+{
+    using P = Project13AudioProcessor;
+
+    UndoJournal(P& processor);
+    ~UndoJournal() override;
+
+    bool canUndo() const { return numApplied > 0 && openGestures == 0; }
+    bool canRedo() const { return numApplied < numEntries && openGestures == 0; }
+
+    bool undo();
+    bool redo();
+
+    //called by the editor when the user drags a tab to a new position
+    void recordOrderChange(const P::DSP_Order& newOrder);
+    //called when the order changes for a reason that shouldn't be undoable, i.e. a preset load
+    void noteCurrentOrder(const P::DSP_Order& order);
+
+    static constexpr int capacity = 512;
+
+private:
+    void parameterValueChanged(int parameterIndex, float newValue) override;
+    void parameterGestureChanged(int parameterIndex, bool gestureIsStarting) override;
+
+    struct Entry
+    {
+        juce::uint32 step = 0;
+        //a StateParam, or orderTarget
+        juce::uint16 target = 0;
+        juce::uint16 reserved = 0;
+        //normalized parameter values as float bits, or packed DSP_Orders
+        juce::uint32 from = 0, to = 0;
+    };
+
+    static_assert(sizeof(Entry) == 16, "keep the journal entries small");
+    static constexpr juce::uint16 orderTarget = 0xFFFF;
+
+    static juce::uint32 packOrder(const P::DSP_Order& order);
+    static P::DSP_Order unpackOrder(juce::uint32 packed);
+
+    Entry& at(int i) { return entries[static_cast<size_t>((oldest + i) % capacity)]; }
+    const Entry& at(int i) const { return entries[static_cast<size_t>((oldest + i) % capacity)]; }
+
+    void record(juce::uint16 target, juce::uint32 from, juce::uint32 to);
+    void apply(const Entry& e, bool useNewValue);
+
+    P& processor;
+
+    std::array<Entry, capacity> entries {};
+    int oldest = 0;
+    //entries recorded, including the ones that were undone and can be redone
+    int numEntries = 0;
+    //entries before the undo cursor
+    int numApplied = 0;
+
+    juce::uint32 currentStep = 0;
+    int openGestures = 0;
+    bool applying = false;
+
+    //the normalized value each parameter had when its gesture began. NaN when not in a gesture.
+    std::array<float, P::numStateParams> gestureStartValues;
+    //maps the host's parameter index to a StateParam. -1 for parameters that aren't journaled.
+    std::vector<int> stateParamForIndex;
+
+    P::DSP_Order currentOrder;
+
+    JUCE_DECLARE_WEAK_REFERENCEABLE (UndoJournal)
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (UndoJournal)
+};
@@ -0,0 +1,312 @@
+/*
+  ==============================================================================
+
+    DeadlineTelemetry.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "DeadlineTelemetry.h"
+
+DeadlineTelemetry::DeadlineTelemetry(const juce::StringArray& names) : stageNames(names)
+{
+    jassert( stageNames.size() > 0 && static_cast<size_t>(stageNames.size()) <= maxStages );
+}
+
+int DeadlineTelemetry::getLoadBucket(double load) noexcept
+{
+    if( load <= 0.0 )
+        return 0;
+
+    auto bucket = static_cast<int>(std::floor(bucketsPerOctave * std::log2(load))) + overrunBucket;
+    return juce::jlimit(0, numLoadBuckets - 1, bucket);
+}
+
+double DeadlineTelemetry::getLoadBucketUpperEdge(int bucket)
+{
+    if( bucket >= numLoadBuckets - 1 )
+        return std::numeric_limits<double>::infinity();
+
+    return std::exp2(static_cast<double>(bucket + 1 - overrunBucket) / bucketsPerOctave);
+}
+
+void DeadlineTelemetry::record(int numSamplesInBlock, double currentSampleRate, juce::int64 callStartNs, juce::int64 callNs, size_t stage) noexcept
+{
+    if( numSamplesInBlock <= 0 || currentSampleRate <= 0.0 )
+        return;
+
+    const auto deadlineNs = static_cast<double>(numSamplesInBlock) / currentSampleRate * 1.0e9;
+    const auto load = static_cast<double>(callNs) / deadlineNs;
+
+    const auto firstCall = numCalls.load(std::memory_order_relaxed) == 0;
+    bump(numCalls);
+    bump(numSamples, static_cast<juce::uint64>(numSamplesInBlock));
+    bump(totalNs, static_cast<juce::uint64>(juce::jmax<juce::int64>(0, callNs)));
+    bump(loadBuckets[static_cast<size_t>(getLoadBucket(load))]);
+
+    if( callNs > maxCallNs.load(std::memory_order_relaxed) )
+        maxCallNs.store(callNs, std::memory_order_relaxed);
+    if( load > maxLoad.load(std::memory_order_relaxed) )
+        maxLoad.store(static_cast<float>(load), std::memory_order_relaxed);
+
+    if( firstCall || numSamplesInBlock < minBlockSize.load(std::memory_order_relaxed) )
+        minBlockSize.store(numSamplesInBlock, std::memory_order_relaxed);
+    if( numSamplesInBlock > maxBlockSize.load(std::memory_order_relaxed) )
+        maxBlockSize.store(numSamplesInBlock, std::memory_order_relaxed);
+
+    auto sizeBucket = juce::jmin(numBlockSizeBuckets - 1, juce::roundToInt(std::ceil(std::log2(static_cast<double>(numSamplesInBlock)))));
+    bump(blockSizeBuckets[static_cast<size_t>(sizeBucket)]);
+
+    sampleRate.store(currentSampleRate, std::memory_order_relaxed);
+
+    if( load >= 1.0 )
+    {
+        bump(numOverruns);
+        bump(overrunsByStage[juce::jmin(stage, static_cast<size_t>(stageNames.size()) - 1)]);
+    }
+
+    //a gap of more than a second is the transport stopping, not jitter
+    const auto intervalNs = callStartNs - lastCallStartNs;
+    if( lastCallStartNs != 0 && lastDeadlineNs > 0 && intervalNs < 1000000000 )
+    {
+        auto jitter = std::abs(static_cast<double>(intervalNs - lastDeadlineNs)) / static_cast<double>(lastDeadlineNs);
+        bump(jitterBuckets[static_cast<size_t>(getLoadBucket(jitter))]);
+    }
+
+    lastCallStartNs = callStartNs;
+    lastDeadlineNs = static_cast<juce::int64>(deadlineNs);
+}
+
+DeadlineTelemetry::Snapshot DeadlineTelemetry::getSnapshot() const
+{
+    Snapshot s;
+    s.numCalls = numCalls.load(std::memory_order_relaxed);
+    s.numSamples = numSamples.load(std::memory_order_relaxed);
+    s.totalNs = totalNs.load(std::memory_order_relaxed);
+    s.numOverruns = numOverruns.load(std::memory_order_relaxed);
+    s.maxCallNs = maxCallNs.load(std::memory_order_relaxed);
+    s.maxLoad = maxLoad.load(std::memory_order_relaxed);
+    s.minBlockSize = minBlockSize.load(std::memory_order_relaxed);
+    s.maxBlockSize = maxBlockSize.load(std::memory_order_relaxed);
+    s.sampleRate = sampleRate.load(std::memory_order_relaxed);
+
+    for( size_t i = 0; i < loadBuckets.size(); ++i )
+    {
+        s.load[i] = loadBuckets[i].load(std::memory_order_relaxed);
+        s.jitter[i] = jitterBuckets[i].load(std::memory_order_relaxed);
+    }
+
+    for( size_t i = 0; i < blockSizeBuckets.size(); ++i )
+        s.blockSizes[i] = blockSizeBuckets[i].load(std::memory_order_relaxed);
+
+    for( size_t i = 0; i < overrunsByStage.size(); ++i )
+        s.overrunsByStage[i] = overrunsByStage[i].load(std::memory_order_relaxed);
+
+    return s;
+}
+
+DeadlineTelemetry::Snapshot DeadlineTelemetry::Snapshot::since(const Snapshot& older) const
+{
+    auto s = *this;
+    s.numCalls -= older.numCalls;
+    s.numSamples -= older.numSamples;
+    s.totalNs -= older.totalNs;
+    s.numOverruns -= older.numOverruns;
+
+    for( size_t i = 0; i < s.load.size(); ++i )
+    {
+        s.load[i] -= older.load[i];
+        s.jitter[i] -= older.jitter[i];
+    }
+
+    for( size_t i = 0; i < s.blockSizes.size(); ++i )
+        s.blockSizes[i] -= older.blockSizes[i];
+
+    for( size_t i = 0; i < s.overrunsByStage.size(); ++i )
+        s.overrunsByStage[i] -= older.overrunsByStage[i];
+
+    return s;
+}
+
+juce::String DeadlineTelemetry::format(const Snapshot& s) const
+{
+    auto percent = [](double fraction) { return juce::String(fraction * 100.0, 1) + "%"; };
+
+    auto histogram = [&percent](const std::array<juce::uint64, numLoadBuckets>& buckets)
+    {
+        //"<upper edge: count", for the buckets that were hit
+        juce::String line;
+        for( int b = 0; b < numLoadBuckets; ++b )
+        {
+            if( auto count = buckets[static_cast<size_t>(b)]; count > 0 )
+            {
+                auto edge = getLoadBucketUpperEdge(b);
+                line << "  " << (std::isfinite(edge) ? "<" + percent(edge) : ">=" + percent(getLoadBucketUpperEdge(b - 1)))
+                     << ": " << juce::String(static_cast<juce::int64>(count));
+            }
+        }
+        return line.isEmpty() ? juce::String("  -") : line;
+    };
+
+    juce::String text;
+    text << juce::Time::getCurrentTime().toString(true, true, true, true)
+         << "  " << juce::String(s.sampleRate, 0) << " Hz"
+         << "  calls " << juce::String(static_cast<juce::int64>(s.numCalls))
+         << "  overruns " << juce::String(static_cast<juce::int64>(s.numOverruns)) << juce::newLine;
+
+    if( s.numCalls > 0 && s.sampleRate > 0.0 )
+    {
+        auto audioNs = static_cast<double>(s.numSamples) / s.sampleRate * 1.0e9;
+        auto meanLoad = static_cast<double>(s.totalNs) / audioNs;
+        text << "  mean load " << percent(meanLoad) << " (headroom " << percent(1.0 - meanLoad) << ")"
+             << "  worst load " << percent(s.maxLoad) << " (headroom " << percent(1.0 - s.maxLoad) << ")"
+             << "  slowest call " << juce::String(static_cast<double>(s.maxCallNs) / 1.0e3, 1) << " us"
+             << "  block sizes " << s.minBlockSize << ".." << s.maxBlockSize << juce::newLine;
+    }
+
+    text << "  load:  " << histogram(s.load) << juce::newLine;
+    text << "  jitter:" << histogram(s.jitter) << juce::newLine;
+
+    text << "  block sizes:";
+    for( int b = 0; b < numBlockSizeBuckets; ++b )
+    {
+        if( auto count = s.blockSizes[static_cast<size_t>(b)]; count > 0 )
+            text << "  <=" << getBlockSizeBucketUpperEdge(b) << ": " << juce::String(static_cast<juce::int64>(count));
+    }
+    text << juce::newLine;
+
+    if( s.numOverruns > 0 )
+    {
+        text << "  overruns by stage:";
+        for( int i = 0; i < stageNames.size(); ++i )
+        {
+            if( auto count = s.overrunsByStage[static_cast<size_t>(i)]; count > 0 )
+                text << "  " << stageNames[i] << ": " << juce::String(static_cast<juce::int64>(count));
+        }
+        text << juce::newLine;
+    }
+
+    return text;
+}
+
+std::optional<juce::File> DeadlineTelemetry::getLogFileFromEnvironment()
+{
+    auto value = juce::SystemStats::getEnvironmentVariable("PROJECT13_TELEMETRY", {}).trim();
+    if( value.isEmpty() || value == "0" )
+        return {};
+
+    if( value != "1" )
+        return juce::File::getCurrentWorkingDirectory().getChildFile(value);
+
+    //one file per process, so several hosts can log at the same time. the instances in a process tell their lines apart by id.
+    static const auto perProcessFile = juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+        .getChildFile("Project13")
+        .getChildFile("Telemetry")
+        .getChildFile(juce::Time::getCurrentTime().formatted("%Y-%m-%d_%H-%M-%S")
+                      + "_" + juce::String(juce::Random::getSystemRandom().nextInt(100000)) + ".log");
+    return perProcessFile;
+}
+
+//==============================================================================
+namespace
+{
+std::atomic<int> nextLoggerId { 1 };
+} //end anonymous namespace
+
+DeadlineTelemetry::Logger::Logger(DeadlineTelemetry& t, const juce::File& f, int intervalSeconds) :
+telemetry(t),
+file(f),
+intervalMs(juce::jmax(1, intervalSeconds) * 1000),
+id(nextLoggerId.fetch_add(1))
+{
+    file.getParentDirectory().createDirectory();
+    previous = telemetry.getSnapshot();
+    nextReportMs = juce::Time::getMillisecondCounter() + static_cast<juce::uint32>(intervalMs);
+    telemetry.setEnabled(true);
+    thread->add(*this);
+}
+
+DeadlineTelemetry::Logger::~Logger()
+{
+    telemetry.setEnabled(false);
+    thread->remove(*this);
+}
+
+void DeadlineTelemetry::Logger::writeReport()
+{
+    auto current = telemetry.getSnapshot();
+    auto interval = current.since(previous);
+    previous = current;
+
+    //nothing to say while the host isn't processing
+    if( interval.numCalls == 0 )
+        return;
+
+    auto tag = "[" + juce::String(id) + "] ";
+    juce::String report;
+    for( const auto& line : juce::StringArray::fromLines(telemetry.format(interval)) )
+        report << (line.isEmpty() ? line : tag + line) << juce::newLine;
+
+    //FileOutputStream appends to an existing file
+    juce::FileOutputStream stream(file);
+    if( stream.openedOk() )
+        stream << report;
+}
+
+DeadlineTelemetry::Logger::LogThread::LogThread() : juce::Thread("Project13 telemetry")
+{
+    startThread();
+}
+
+DeadlineTelemetry::Logger::LogThread::~LogThread()
+{
+    //every logger has written its last report by now
+    stopThread(2000);
+}
+
+void DeadlineTelemetry::Logger::LogThread::add(Logger& logger)
+{
+    {
+        const juce::ScopedLock sl(lock);
+        loggers.addIfNotAlreadyThere(&logger);
+    }
+
+    //the new logger's interval may end before the one the thread is waiting for
+    notify();
+}
+
+void DeadlineTelemetry::Logger::LogThread::remove(Logger& logger)
+{
+    const juce::ScopedLock sl(lock);
+    loggers.removeFirstMatchingValue(&logger);
+    logger.writeReport();
+}
+
+void DeadlineTelemetry::Logger::LogThread::run()
+{
+    while( threadShouldExit() == false )
+    {
+        //at most a second, so a logger added meanwhile is never kept waiting long
+        auto waitMs = 1000;
+        {
+            const juce::ScopedLock sl(lock);
+            auto now = juce::Time::getMillisecondCounter();
+            for( auto* logger : loggers )
+            {
+                //wraps around safely, like the counter does
+                auto dueIn = static_cast<int>(logger->nextReportMs - now);
+                if( dueIn <= 0 )
+                {
+                    logger->writeReport();
+                    logger->nextReportMs = now + static_cast<juce::uint32>(logger->intervalMs);
+                    dueIn = logger->intervalMs;
+                }
+
+                waitMs = juce::jmin(waitMs, dueIn);
+            }
+        }
+
+        wait(waitMs);
+    }
+}
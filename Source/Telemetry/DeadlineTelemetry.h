@@ -0,0 +1,157 @@
+/*
+  ==============================================================================
+
+    DeadlineTelemetry.h
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/*
+ Deadline telemetry for processBlock().
+
+ Every call is recorded with its duration, its block size and its load: the duration relative to the
+    realtime deadline, which is the length of the block at the current sample rate.
+    headroom is 1 - load. a load of 1 or more is an overrun, which is an xrun in the making.
+ Loads go into a histogram with 4 buckets per octave, from 0.1% to 400% of the deadline.
+ Jitter is how far the time between two calls strays from the length of the previous block.
+    hosts that call from a jittery thread eat into the deadline before processBlock() even starts.
+ Every overrun is attributed to a stage, whichever one the processor says took the longest in that call.
+
+ The audio thread is the only writer. each counter is a relaxed atomic, so recording is a handful
+    of loads and stores, and readers on any thread can take a Snapshot at any time.
+    a snapshot isn't taken atomically as a whole: a call that is recorded meanwhile may be only half in it.
+    that is fine for telemetry, and the next snapshot includes the rest.
+
+ A Logger appends the difference between consecutive snapshots to a text file.
+    every Logger in the process is served by one shared thread, and tags its lines with its own id,
+    so several instances can log into the same file.
+ */
+struct DeadlineTelemetry
+{
+    static constexpr int bucketsPerOctave = 4;
+    static constexpr int numLoadBuckets = 50;
+    //bucket 0 holds loads below 2^-10 (0.1%). bucket overrunBucket is the first one at or above 100%.
+    static constexpr int overrunBucket = 41;
+    static constexpr int numBlockSizeBuckets = 16;
+    static constexpr size_t maxStages = 15;
+
+    //the names of the stages overruns are attributed to, in the processor's order
+    explicit DeadlineTelemetry(const juce::StringArray& stageNames);
+
+    //any thread. recording starts with the next call.
+    void setEnabled(bool shouldBeEnabled) { enabled.store(shouldBeEnabled, std::memory_order_relaxed); }
+    bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+    //audio thread only. 'stage' is only used for overruns, and is < the number of stage names.
+    void record(int numSamples, double sampleRate, juce::int64 callStartNs, juce::int64 callNs, size_t stage) noexcept;
+
+    struct Snapshot
+    {
+        juce::uint64 numCalls = 0, numSamples = 0, totalNs = 0, numOverruns = 0;
+        //the worst values since the telemetry started
+        juce::int64 maxCallNs = 0;
+        float maxLoad = 0.f;
+        int minBlockSize = 0, maxBlockSize = 0;
+        double sampleRate = 0.0;
+
+        std::array<juce::uint64, numLoadBuckets> load {}, jitter {};
+        std::array<juce::uint64, numBlockSizeBuckets> blockSizes {};
+        std::array<juce::uint64, maxStages> overrunsByStage {};
+
+        //the counters for the time between two snapshots. the worst values are kept from 'this'.
+        Snapshot since(const Snapshot& older) const;
+    };
+
+    Snapshot getSnapshot() const;
+
+    static double getLoadBucketUpperEdge(int bucket);
+    static int getBlockSizeBucketUpperEdge(int bucket) { return 1 << bucket; }
+
+    //a readable report of a snapshot, i.e. the difference between two of them
+    juce::String format(const Snapshot& snapshot) const;
+
+    /*
+     Appends a report to a file every 'intervalSeconds', and a final one when it stops.
+     Each line of a report starts with "[id] ", where the id is unique to the logger within the process.
+     The telemetry is enabled while the logger runs.
+     */
+    struct Logger
+    {
+        Logger(DeadlineTelemetry& telemetry, const juce::File& file, int intervalSeconds);
+        ~Logger();
+
+        int getId() const { return id; }
+
+    private:
+        //the one thread that writes every logger's reports. created with the first logger, deleted with the last one.
+        struct LogThread : juce::Thread
+        {
+            LogThread();
+            ~LogThread() override;
+
+            void add(Logger& logger);
+            //writes the logger's last report before it goes
+            void remove(Logger& logger);
+
+        private:
+            void run() override;
+
+            //guards the loggers, and makes sure only one report is written at a time
+            juce::CriticalSection lock;
+            juce::Array<Logger*> loggers;
+        };
+
+        //LogThread's lock must be held
+        void writeReport();
+
+        DeadlineTelemetry& telemetry;
+        const juce::File file;
+        const int intervalMs;
+        const int id;
+        juce::uint32 nextReportMs = 0;
+        Snapshot previous;
+
+        juce::SharedResourcePointer<LogThread> thread;
+
+        JUCE_DECLARE_NON_COPYABLE(Logger)
+    };
+
+    /*
+     the log file PROJECT13_TELEMETRY asks for, if any.
+     set it to a file path, or to 1 for a file in the Project13/Telemetry app data folder.
+        with 1, every instance in the process logs into the same file, named when the first one asks.
+     */
+    static std::optional<juce::File> getLogFileFromEnvironment();
+
+private:
+    using Counter = std::atomic<juce::uint64>;
+
+    //only the audio thread writes, so a relaxed load and store is enough, and is cheaper than fetch_add()
+    static void bump(Counter& counter, juce::uint64 amount = 1) noexcept
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+
+    static int getLoadBucket(double load) noexcept;
+
+    juce::StringArray stageNames;
+    std::atomic<bool> enabled { false };
+
+    Counter numCalls { 0 }, numSamples { 0 }, totalNs { 0 }, numOverruns { 0 };
+    std::atomic<juce::int64> maxCallNs { 0 };
+    std::atomic<float> maxLoad { 0.f };
+    std::atomic<int> minBlockSize { 0 }, maxBlockSize { 0 };
+    std::atomic<double> sampleRate { 0.0 };
+
+    std::array<Counter, numLoadBuckets> loadBuckets {}, jitterBuckets {};
+    std::array<Counter, numBlockSizeBuckets> blockSizeBuckets {};
+    std::array<Counter, maxStages> overrunsByStage {};
+
+    //audio thread only
+    juce::int64 lastCallStartNs = 0, lastDeadlineNs = 0;
+};
@@ -0,0 +1,248 @@
+/*
+  ==============================================================================
+
+    QualityGovernor.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "QualityGovernor.h"
+
+namespace
+{
+constexpr double windowSeconds = 0.25;
+constexpr float stepDownMean = 0.7f, stepDownPeak = 0.85f;
+constexpr float stepUpMean = 0.4f, stepUpPeak = 0.6f;
+//calls at or above stepDownPeak that make a window hot: at least this many, and at least this fraction of its calls
+constexpr int minHotCalls = 3;
+constexpr float minHotFraction = 0.1f;
+//in windows: 2 seconds, doubling up to 16 seconds
+constexpr int minCalmWindows = 8, maxCalmWindows = 64;
+//a share that hasn't been refreshed for this long belongs to an instance that stopped processing
+constexpr juce::uint32 shareExpiryMs = 1000;
+
+/*
+ every instance's share of the load, with the audio thread it runs on.
+ fixed-size and lock-free, so the audio threads can update it and read it.
+ */
+struct Share
+{
+    std::atomic<bool> taken { false };
+    std::atomic<juce::int64> ppm { 0 };
+    std::atomic<juce::uint32> refreshedMs { 0 };
+    std::atomic<juce::Thread::ThreadID> thread { nullptr };
+};
+
+constexpr int maxShares = 256;
+std::array<Share, maxShares> shares;
+
+int claimShare()
+{
+    for( int i = 0; i < maxShares; ++i )
+    {
+        auto expected = false;
+        if( shares[static_cast<size_t>(i)].taken.compare_exchange_strong(expected, true) )
+            return i;
+    }
+
+    //the global load leaves this instance out
+    return -1;
+}
+} //end anonymous namespace
+
+QualityGovernor::QualityGovernor() : shareSlot(claimShare())
+{
+    reset();
+}
+
+QualityGovernor::~QualityGovernor()
+{
+    setShare(0.f);
+    if( shareSlot >= 0 )
+        shares[static_cast<size_t>(shareSlot)].taken.store(false);
+}
+
+int QualityGovernor::getControlInterval(Tier t)
+{
+    switch( t )
+    {
+        case Tier::Full: return 64;
+        case Tier::Reduced: return 256;
+        case Tier::Eco: return maxControlInterval;
+        case Tier::END_OF_LIST: break;
+    }
+
+    jassertfalse;
+    return 64;
+}
+
+juce::String QualityGovernor::getTierName(Tier t)
+{
+    switch( t )
+    {
+        case Tier::Full: return "Full";
+        case Tier::Reduced: return "Reduced";
+        case Tier::Eco: return "Eco";
+        case Tier::END_OF_LIST: break;
+    }
+
+    jassertfalse;
+    return {};
+}
+
+QualityGovernor::Mode QualityGovernor::getModeFromEnvironment()
+{
+    auto value = juce::SystemStats::getEnvironmentVariable("PROJECT13_ECO", {}).trim().toLowerCase();
+    if( value == "off" || value == "0" )
+        return Mode::Off;
+    if( value == "global" )
+        return Mode::Global;
+
+    return Mode::Instance;
+}
+
+float QualityGovernor::getGlobalLoad()
+{
+    //the live shares summed per audio thread. no allocation, so the audio threads can call this.
+    struct ThreadLoad
+    {
+        juce::Thread::ThreadID thread = nullptr;
+        juce::int64 ppm = 0;
+    };
+
+    std::array<ThreadLoad, maxShares> threads;
+    int numThreads = 0;
+    juce::int64 busiest = 0;
+
+    const auto now = juce::Time::getMillisecondCounter();
+    for( auto& share : shares )
+    {
+        auto ppm = share.ppm.load(std::memory_order_relaxed);
+        if( ppm == 0 || now - share.refreshedMs.load(std::memory_order_relaxed) > shareExpiryMs )
+            continue;
+
+        auto thread = share.thread.load(std::memory_order_relaxed);
+        auto end = threads.begin() + numThreads;
+        auto entry = std::find_if(threads.begin(), end, [thread](const ThreadLoad& t) { return t.thread == thread; });
+        if( entry == end )
+        {
+            entry->thread = thread;
+            entry->ppm = 0;
+            ++numThreads;
+        }
+
+        entry->ppm += ppm;
+        busiest = juce::jmax(busiest, entry->ppm);
+    }
+
+    return static_cast<float>(busiest) * 1.0e-6f;
+}
+
+void QualityGovernor::setShare(float load) noexcept
+{
+    sharePpm = static_cast<juce::int64>(load * 1.0e6f);
+    if( shareSlot < 0 )
+        return;
+
+    auto& share = shares[static_cast<size_t>(shareSlot)];
+    share.thread.store(sharePpm != 0 ? juce::Thread::getCurrentThreadId() : nullptr, std::memory_order_relaxed);
+    share.refreshedMs.store(juce::Time::getMillisecondCounter(), std::memory_order_relaxed);
+    share.ppm.store(sharePpm, std::memory_order_relaxed);
+}
+
+void QualityGovernor::reset() noexcept
+{
+    tier.store(Tier::Full, std::memory_order_relaxed);
+    windowNs = windowAudioNs = 0.0;
+    windowPeak = 0.f;
+    windowCalls = hotCalls = 0;
+    calmWindows = 0;
+    windowsSinceStepUp = maxCalmWindows;
+    requiredCalmWindows = minCalmWindows;
+
+    //an instance that isn't processing doesn't load anything
+    setShare(0.f);
+}
+
+void QualityGovernor::stepDown() noexcept
+{
+    auto current = getTier();
+    if( current != Tier::Eco )
+        tier.store(static_cast<Tier>(static_cast<int>(current) + 1), std::memory_order_relaxed);
+
+    //stepping up didn't hold, so the next try waits longer
+    if( windowsSinceStepUp < requiredCalmWindows )
+        requiredCalmWindows = juce::jmin(requiredCalmWindows * 2, maxCalmWindows);
+
+    calmWindows = 0;
+}
+
+QualityGovernor::Tier QualityGovernor::update(int numSamples, double sampleRate, juce::int64 callNs) noexcept
+{
+    const auto currentMode = getMode();
+    if( currentMode == Mode::Off )
+    {
+        if( getTier() != Tier::Full || sharePpm != 0 )
+            reset();
+
+        return Tier::Full;
+    }
+
+    if( numSamples <= 0 || sampleRate <= 0.0 )
+        return getTier();
+
+    const auto deadlineNs = static_cast<double>(numSamples) / sampleRate * 1.0e9;
+    const auto load = static_cast<float>(static_cast<double>(callNs) / deadlineNs);
+
+    windowNs += static_cast<double>(callNs);
+    windowAudioNs += deadlineNs;
+    windowPeak = juce::jmax(windowPeak, load);
+    ++windowCalls;
+    if( load >= stepDownPeak )
+        ++hotCalls;
+
+    if( windowAudioNs < windowSeconds * 1.0e9 )
+        return getTier();
+
+    const auto mean = static_cast<float>(windowNs / windowAudioNs);
+    setShare(mean);
+
+    //the busiest thread includes this instance's own share, so it is at least as loaded as this instance
+    const auto decisionMean = currentMode == Mode::Global ? juce::jmax(mean, getGlobalLoad()) : mean;
+    const auto isHot = hotCalls >= juce::jmax(minHotCalls, juce::roundToInt(minHotFraction * static_cast<float>(windowCalls)));
+    const auto peak = windowPeak;
+
+    windowNs = windowAudioNs = 0.0;
+    windowPeak = 0.f;
+    windowCalls = hotCalls = 0;
+
+    windowsSinceStepUp = juce::jmin(windowsSinceStepUp + 1, maxCalmWindows);
+
+    if( decisionMean >= stepDownMean || isHot )
+    {
+        stepDown();
+        return getTier();
+    }
+
+    if( decisionMean < stepUpMean && juce::jmax(peak, decisionMean) < stepUpPeak )
+        ++calmWindows;
+    else
+        calmWindows = 0;
+
+    if( calmWindows >= requiredCalmWindows && getTier() != Tier::Full )
+    {
+        tier.store(static_cast<Tier>(static_cast<int>(getTier()) - 1), std::memory_order_relaxed);
+        calmWindows = 0;
+        windowsSinceStepUp = 0;
+    }
+
+    //a long calm stretch at Full forgives earlier bounces
+    if( getTier() == Tier::Full && calmWindows >= maxCalmWindows )
+    {
+        requiredCalmWindows = minCalmWindows;
+        calmWindows = 0;
+    }
+
+    return getTier();
+}
@@ -0,0 +1,104 @@
+/*
+  ==============================================================================
+
+    QualityGovernor.h
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/*
+ Eco mode: trades quality for CPU when processBlock() gets close to its deadline.
+
+ The governor is fed the duration of every realtime processBlock() call, and decides on a Tier.
+    the load of a call is its duration relative to the length of its block, like in DeadlineTelemetry.
+ It steps down one tier at the end of a 250 ms window whose mean load reaches 70%,
+    or in which at least 3 calls, and at least a tenth of them, reached 85%.
+    a single slow call, even an overrun, doesn't step down on its own: hosts have the odd late call for reasons of their own.
+ It steps back up one tier only after 2 seconds below 40% mean and 60% worst.
+    if it has to step down again soon after stepping up, it waits twice as long before the next try, up to 16 seconds.
+
+ Instance mode looks at this instance's load only.
+ Global mode looks at the mean loads of every instance in the process, so a big session
+    steps all of its instances down together, even when each one on its own is cheap.
+    instances on the same audio thread run one after another, so their loads add up.
+    hosts that spread instances over several threads are as loaded as their busiest thread, so that sum counts.
+    an instance that hasn't reported for a second, i.e. one that stopped processing, doesn't count.
+
+ The tier only changes between blocks, and none of the tiers switch anything abruptly,
+    so stepping down or up never clicks. see getControlInterval() and isAnalyzerFed().
+ */
+struct QualityGovernor
+{
+    enum class Tier : juce::uint8
+    {
+        Full,
+        Reduced,
+        Eco,
+        END_OF_LIST
+    };
+
+    enum class Mode : juce::uint8
+    {
+        Off,
+        Instance,
+        Global,
+        END_OF_LIST
+    };
+
+    QualityGovernor();
+    ~QualityGovernor();
+
+    //any thread. Off goes back to Full on the next block.
+    void setMode(Mode newMode) { mode.store(newMode, std::memory_order_relaxed); }
+    Mode getMode() const { return mode.load(std::memory_order_relaxed); }
+
+    //any thread
+    Tier getTier() const { return tier.load(std::memory_order_relaxed); }
+
+    //audio thread only. returns the tier for the next block.
+    Tier update(int numSamples, double sampleRate, juce::int64 callNs) noexcept;
+
+    //back to Full, forgetting the load so far. not while update() may be running.
+    void reset() noexcept;
+
+    /*
+     the number of samples between control updates: the smoothers advance, and the modules take the smoothed
+        values, once per interval. longer intervals move the parameters in bigger steps along the same ramps.
+     */
+    static int getControlInterval(Tier t);
+    static constexpr int maxControlInterval = 512;
+
+    //the spectrum analyzer freezes in the Eco tier. the meters keep running.
+    static bool isAnalyzerFed(Tier t) { return t != Tier::Eco; }
+
+    static juce::String getTierName(Tier t);
+
+    //the mode PROJECT13_ECO asks for: off, instance or global. Instance if it isn't set.
+    static Mode getModeFromEnvironment();
+
+    //the sum of the mean loads of the instances on the busiest audio thread, from their last full windows
+    static float getGlobalLoad();
+
+private:
+    void stepDown() noexcept;
+    void setShare(float load) noexcept;
+
+    //this instance's slot in the process-wide share table, or -1 if every slot is taken
+    const int shareSlot;
+
+    std::atomic<Mode> mode { Mode::Instance };
+    std::atomic<Tier> tier { Tier::Full };
+
+    //audio thread only
+    double windowNs = 0.0, windowAudioNs = 0.0;
+    float windowPeak = 0.f;
+    int windowCalls = 0, hotCalls = 0;
+    int calmWindows = 0, windowsSinceStepUp = 0, requiredCalmWindows = 0;
+    //this instance's part of the global load, in millionths of a deadline
+    juce::int64 sharePpm = 0;
+};
@@ -0,0 +1,590 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 19 Oct 2026
+
+    Project13Bench
+    Headless benchmarks for Project13AudioProcessor.
+
+    usage:
+        Project13Bench [--suite all|state|modules|chain|block|hostblock] [--json <file>] [--label <text>]
+                       [--iterations N] [--samples N] [--repeats N] [--quick]
+
+        --suite         which benchmarks to run. defaults to all.
+        --json          also write every result to a JSON file, for tracking regressions between releases.
+        --label         stored in the JSON file as-is, i.e. a version number or a commit hash.
+        --iterations    iterations for the state benchmarks.
+        --samples       sample frames processed per measurement in the DSP benchmarks. defaults to 131072.
+        --repeats       measurements per case. the median is reported. defaults to 5.
+        --quick         fewer block sizes and sample rates, for a fast check.
+
+    suites:
+        state           saving and loading the plugin state.
+        modules         each DSP_Option on its own, active and bypassed.
+        chain           MonoChannelDSP::process() for both channels, for every DSP_Order.
+        block           processBlock() end to end, for every DSP_Order.
+        hostblock       processBlock() end to end for host blocks of 1 - 4096 samples, prepared for 4096.
+                        the per-tick work is spread across host calls, so ns/sample should stay flat.
+
+    The DSP suites sweep block sizes 16 - 4096 and sample rates 44.1 - 192 kHz.
+    The chain and block sweeps use the default order, and then run all 120 permutations of the 5 modules at 48 kHz / 512 samples,
+        and a chain that fills every slot with second module instances.
+    The modules suite covers the second instances too.
+    DSP timings are in ns per stereo sample frame.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../../../Source/PluginProcessor.h"
+
+#include <chrono>
+#include <iostream>
+
+namespace
+{
+using P = Project13AudioProcessor;
+
+struct BenchResult
+{
+    juce::String name;
+    double nsPerOp = 0.0;
+    size_t bytes = 0;
+};
+
+template<typename Func>
+double measureNsPerOp(int iterations, Func&& func)
+{
+    //warm up caches and any lazily created objects first
+    for( int i = 0; i < juce::jmax(1, iterations / 10); ++i )
+        func();
+
+    auto start = std::chrono::steady_clock::now();
+    for( int i = 0; i < iterations; ++i )
+        func();
+    auto end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(iterations);
+}
+
+void printResult(const BenchResult& r)
+{
+    std::cout << r.name.paddedRight(' ', 28)
+              << juce::String(r.nsPerOp / 1000.0, 3).paddedLeft(' ', 12) << " us/op";
+    if( r.bytes > 0 )
+        std::cout << juce::String(static_cast<juce::int64>(r.bytes)).paddedLeft(' ', 10) << " bytes";
+
+    std::cout << std::endl;
+}
+
+/*
+ compares the ValueTree state chunk used by earlier versions with the compact StateCodec chunk.
+ the compact paths go through the same public functions a host would call.
+ the legacy paths run what those functions did before the compact chunk existed: writing the APVTS tree,
+    and reading it back with apvts.replaceState(). setStateInformation() only still parses the old chunk,
+    and then publishes it like any other state, so timing it would say nothing about the old loader.
+ */
+std::vector<BenchResult> runStateBenchmarks(int iterations)
+{
+    std::vector<BenchResult> results;
+    Project13AudioProcessor processor;
+
+    juce::MemoryBlock legacy, compact;
+    processor.getLegacyStateInformation(legacy);
+    processor.getStateInformation(compact);
+
+    results.push_back({ "state/save/legacy", measureNsPerOp(iterations, [&]()
+    {
+        juce::MemoryBlock mb;
+        processor.getLegacyStateInformation(mb);
+    }), legacy.getSize() });
+
+    results.push_back({ "state/save/compact", measureNsPerOp(iterations, [&]()
+    {
+        juce::MemoryBlock mb;
+        processor.getStateInformation(mb);
+    }), compact.getSize() });
+
+    results.push_back({ "state/load/legacy", measureNsPerOp(iterations, [&]()
+    {
+        processor.setLegacyStateInformation(legacy.getData(), static_cast<int>(legacy.getSize()));
+    }), legacy.getSize() });
+
+    results.push_back({ "state/load/compact", measureNsPerOp(iterations, [&]()
+    {
+        processor.setStateInformation(compact.getData(), static_cast<int>(compact.getSize()));
+    }), compact.getSize() });
+
+    return results;
+}
+
+juce::var toJson(const BenchResult& r)
+{
+    auto* obj = new juce::DynamicObject();
+    obj->setProperty("suite", "state");
+    obj->setProperty("name", r.name);
+    obj->setProperty("nsPerOp", r.nsPerOp);
+    obj->setProperty("bytes", static_cast<juce::int64>(r.bytes));
+    return juce::var(obj);
+}
+
+//==============================================================================
+struct DSPSettings
+{
+    juce::int64 samplesPerRun = 1 << 17;
+    int repeats = 5;
+    std::vector<int> blockSizes { 16, 32, 64, 128, 256, 512, 1024, 2048, 4096 };
+    std::vector<double> sampleRates { 44100.0, 48000.0, 88200.0, 96000.0, 176400.0, 192000.0 };
+
+    //where the order sweeps run
+    int orderBlockSize = 512;
+    double orderSampleRate = 48000.0;
+};
+
+struct DSPResult
+{
+    juce::String suite, name;
+    int blockSize = 0;
+    double sampleRate = 0.0;
+    bool bypassed = false;
+    double nsPerSample = 0.0, minNsPerSample = 0.0;
+
+    //the share of one core this costs in realtime
+    double getCpuPercent() const { return nsPerSample * sampleRate * 1.0e-7; }
+};
+
+juce::var toJson(const DSPResult& r)
+{
+    auto* obj = new juce::DynamicObject();
+    obj->setProperty("suite", r.suite);
+    obj->setProperty("name", r.name);
+    obj->setProperty("blockSize", r.blockSize);
+    obj->setProperty("sampleRate", r.sampleRate);
+    obj->setProperty("bypassed", r.bypassed);
+    obj->setProperty("nsPerSample", r.nsPerSample);
+    obj->setProperty("minNsPerSample", r.minNsPerSample);
+    obj->setProperty("cpuPercent", r.getCpuPercent());
+    return juce::var(obj);
+}
+
+void printResult(const DSPResult& r)
+{
+    std::cout << (r.suite + "/" + r.name).paddedRight(' ', 56)
+              << juce::String(r.blockSize).paddedLeft(' ', 6)
+              << juce::String(r.sampleRate / 1000.0, 1).paddedLeft(' ', 7) << " kHz"
+              << (r.bypassed ? "  bypassed" : "          ")
+              << juce::String(r.nsPerSample, 2).paddedLeft(' ', 10) << " ns/sample"
+              << juce::String(r.getCpuPercent(), 2).paddedLeft(' ', 8) << " %"
+              << std::endl;
+}
+
+juce::String getOptionName(P::DSP_Option option)
+{
+    switch( option )
+    {
+        case P::DSP_Option::Phase: return "Phase";
+        case P::DSP_Option::Chorus: return "Chorus";
+        case P::DSP_Option::Overdrive: return "Overdrive";
+        case P::DSP_Option::LadderFilter: return "LadderFilter";
+        case P::DSP_Option::GeneralFilter: return "GeneralFilter";
+        case P::DSP_Option::Phase2:
+        case P::DSP_Option::Chorus2:
+        case P::DSP_Option::Overdrive2:
+        case P::DSP_Option::LadderFilter2:
+        case P::DSP_Option::GeneralFilter2:
+            return getOptionName(P::getModuleKind(option)) + juce::String(P::getInstanceIndex(option) + 1);
+        case P::DSP_Option::END_OF_LIST: break;
+    }
+
+    return "None";
+}
+
+juce::String getOrderName(const P::DSP_Order& order)
+{
+    juce::StringArray names;
+    for( auto option : order )
+        names.add(getOptionName(option));
+
+    return names.joinIntoString(">");
+}
+
+//the default order comes first
+std::vector<P::DSP_Order> getAllOrders()
+{
+    std::array<P::DSP_Option, P::numModuleKinds> modules;
+    for( size_t i = 0; i < modules.size(); ++i )
+        modules[i] = static_cast<P::DSP_Option>(i);
+
+    //the modules start sorted, so this visits every permutation
+    std::vector<P::DSP_Order> orders;
+    do
+    {
+        P::DSP_Order order;
+        for( auto option : modules )
+            order.add(option);
+
+        orders.push_back(order);
+    } while( std::next_permutation(modules.begin(), modules.end()) );
+
+    //the longest chain there is: the default order, then second instances until every slot is used
+    auto full = P::getDefaultOrder();
+    for( size_t i = P::numModuleKinds; full.isFull() == false; ++i )
+        full.add(static_cast<P::DSP_Option>(i));
+
+    orders.push_back(full);
+    return orders;
+}
+
+juce::AudioParameterBool* getBypassParam(P& processor, P::DSP_Option option)
+{
+    jassert( option != P::DSP_Option::END_OF_LIST );
+    //the first instance's bypass, or this instance's copy of it
+    auto bypass = [&processor, instance = P::getInstanceIndex(option)](P::StateParam param)
+    {
+        return dynamic_cast<juce::AudioParameterBool*>(processor.stateParams[static_cast<size_t>(P::getInstanceParam(param, instance))]);
+    };
+
+    switch( P::getModuleKind(option) )
+    {
+        case P::DSP_Option::Phase: return bypass(P::StateParam::PhaserBypass);
+        case P::DSP_Option::Chorus: return bypass(P::StateParam::ChorusBypass);
+        case P::DSP_Option::Overdrive: return bypass(P::StateParam::OverdriveBypass);
+        case P::DSP_Option::LadderFilter: return bypass(P::StateParam::LadderFilterBypass);
+        case P::DSP_Option::GeneralFilter: return bypass(P::StateParam::GeneralFilterBypass);
+        case P::DSP_Option::Phase2:
+        case P::DSP_Option::Chorus2:
+        case P::DSP_Option::Overdrive2:
+        case P::DSP_Option::LadderFilter2:
+        case P::DSP_Option::GeneralFilter2:
+        case P::DSP_Option::END_OF_LIST: break;
+    }
+
+    jassertfalse;
+    return nullptr;
+}
+
+void setAllBypassed(P& processor, bool bypassed)
+{
+    for( size_t i = 0; i < static_cast<size_t>(P::DSP_Option::END_OF_LIST); ++i )
+        getBypassParam(processor, static_cast<P::DSP_Option>(i))->setValueNotifyingHost(bypassed ? 1.f : 0.f);
+}
+
+/*
+ Runs every DSP benchmark against one processor instance.
+ Each block is refilled from a few seconds of noise first, the way a host delivers fresh input.
+    otherwise the filters would keep working on their own output, which decays towards silence.
+    the 'baseline' suite measures the refill alone, so it can be subtracted from the other results.
+ */
+struct DSPBench
+{
+    explicit DSPBench(const DSPSettings& s) : settings(s)
+    {
+        //the realtime path is what gets measured, at full quality, whatever load the benchmark itself puts on the machine
+        processor.setQualityMode(QualityGovernor::Mode::Off);
+
+        noise.setSize(2, 1 << 18);
+        juce::Random random(0x13);
+        for( int ch = 0; ch < noise.getNumChannels(); ++ch )
+        {
+            for( int i = 0; i < noise.getNumSamples(); ++i )
+                noise.setSample(ch, i, random.nextFloat() * 0.5f - 0.25f);
+        }
+    }
+
+    void prepare(double sampleRate, int blockSize)
+    {
+        processor.setPlayConfigDetails(2, 2, sampleRate, blockSize);
+        processor.prepareToPlay(sampleRate, blockSize);
+        buffer.setSize(2, blockSize, false, false, true);
+        current = { sampleRate, blockSize };
+    }
+
+    template<typename Func>
+    DSPResult measure(const juce::String& suite, const juce::String& name, bool bypassed, Func&& processOneBlock)
+    {
+        const auto blockSize = buffer.getNumSamples();
+        auto run = [&]()
+        {
+            juce::int64 done = 0;
+            while( done < settings.samplesPerRun )
+            {
+                auto offset = static_cast<int>(done % (noise.getNumSamples() - blockSize));
+                for( int ch = 0; ch < 2; ++ch )
+                    buffer.copyFrom(ch, 0, noise, ch, offset, blockSize);
+
+                processOneBlock();
+                done += blockSize;
+            }
+
+            return done;
+        };
+
+        //warm up: caches, branch predictors, and the parameter smoothers settling on their targets
+        run();
+
+        std::vector<double> runs;
+        for( int i = 0; i < settings.repeats; ++i )
+        {
+            auto start = std::chrono::steady_clock::now();
+            auto done = run();
+            auto end = std::chrono::steady_clock::now();
+            runs.push_back(std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(done));
+        }
+
+        std::sort(runs.begin(), runs.end());
+
+        DSPResult r;
+        r.suite = suite;
+        r.name = name;
+        r.blockSize = blockSize;
+        r.sampleRate = current.sampleRate;
+        r.bypassed = bypassed;
+        r.nsPerSample = runs[runs.size() / 2];
+        r.minNsPerSample = runs.front();
+        printResult(r);
+        return r;
+    }
+
+    void runBaseline(std::vector<DSPResult>& results)
+    {
+        for( auto blockSize : settings.blockSizes )
+        {
+            prepare(settings.orderSampleRate, blockSize);
+            results.push_back(measure("baseline", "refill", false, []() { }));
+        }
+    }
+
+    void runModules(std::vector<DSPResult>& results)
+    {
+        for( auto sampleRate : settings.sampleRates )
+        {
+            for( auto blockSize : settings.blockSizes )
+            {
+                prepare(sampleRate, blockSize);
+                for( size_t i = 0; i < static_cast<size_t>(P::DSP_Option::END_OF_LIST); ++i )
+                {
+                    auto option = static_cast<P::DSP_Option>(i);
+                    for( auto bypassed : { false, true } )
+                    {
+                        setAllBypassed(processor, false);
+                        getBypassParam(processor, option)->setValueNotifyingHost(bypassed ? 1.f : 0.f);
+
+                        results.push_back(measure("modules", getOptionName(option), bypassed, [&]()
+                        {
+                            processor.benchmarkModule(juce::dsp::AudioBlock<float>(buffer), option);
+                        }));
+                    }
+                }
+            }
+        }
+
+        setAllBypassed(processor, false);
+    }
+
+    void runChain(std::vector<DSPResult>& results)
+    {
+        sweep(results, "chain", [this](const P::DSP_Order& order)
+        {
+            processor.benchmarkChain(juce::dsp::AudioBlock<float>(buffer), order);
+        });
+    }
+
+    /*
+     a host prepared for large blocks that delivers smaller ones, down to single samples.
+     the refill is part of the measurement here, and costs a little more per sample for the smallest blocks.
+     */
+    void runHostBlocks(std::vector<DSPResult>& results)
+    {
+        constexpr int maxBlockSize = 4096;
+        setAllBypassed(processor, false);
+        
+        std::vector<double> nsPerSample;
+        for( int hostBlockSize = 1; hostBlockSize <= maxBlockSize; hostBlockSize *= 2 )
+        {
+            prepare(settings.orderSampleRate, maxBlockSize);
+            buffer.setSize(2, hostBlockSize, false, false, true);
+            
+            auto r = measure("hostblock", "default order", false, [this]() { processor.processBlock(buffer, midi); });
+            nsPerSample.push_back(r.nsPerSample);
+            results.push_back(r);
+        }
+        
+        auto [best, worst] = std::minmax_element(nsPerSample.begin(), nsPerSample.end());
+        std::cout << "hostblock spread: the slowest block size takes " << juce::String(*worst / *best, 2)
+                  << "x the ns/sample of the fastest" << std::endl;
+    }
+
+    void runBlock(std::vector<DSPResult>& results)
+    {
+        auto sentOrder = P::DSP_Order();
+        sweep(results, "block", [this, &sentOrder](const P::DSP_Order& order)
+        {
+            //processBlock() picks the new order up itself. the first block it happens in is part of the warm up.
+            if( order != sentOrder && processor.sendCommand(P::Command::setOrder(order)) )
+                sentOrder = order;
+
+            processor.processBlock(buffer, midi);
+        });
+    }
+
+private:
+    /*
+     the default order across every block size, sample rate and bypass state,
+        then every order at the order sweep's block size and sample rate.
+     */
+    template<typename Func>
+    void sweep(std::vector<DSPResult>& results, const juce::String& suite, Func&& processOneBlock)
+    {
+        const auto orders = getAllOrders();
+        const auto& defaultOrder = orders.front();
+
+        for( auto sampleRate : settings.sampleRates )
+        {
+            for( auto blockSize : settings.blockSizes )
+            {
+                prepare(sampleRate, blockSize);
+                for( auto bypassed : { false, true } )
+                {
+                    setAllBypassed(processor, bypassed);
+                    results.push_back(measure(suite, getOrderName(defaultOrder), bypassed, [&]() { processOneBlock(defaultOrder); }));
+                }
+            }
+        }
+
+        setAllBypassed(processor, false);
+        prepare(settings.orderSampleRate, settings.orderBlockSize);
+        for( const auto& order : orders )
+        {
+            results.push_back(measure(suite, getOrderName(order), false, [&]() { processOneBlock(order); }));
+        }
+    }
+
+    const DSPSettings& settings;
+    Project13AudioProcessor processor;
+
+    juce::AudioBuffer<float> noise, buffer;
+    juce::MidiBuffer midi;
+
+    struct
+    {
+        double sampleRate = 0.0;
+        int blockSize = 0;
+    } current;
+};
+
+juce::String getArg(const juce::StringArray& args, const juce::String& name)
+{
+    auto idx = args.indexOf(name);
+    return idx >= 0 && idx + 1 < args.size() ? args[idx + 1] : juce::String();
+}
+} //end anonymous namespace
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    //the APVTS and the parameter listeners expect a message manager.
+    juce::ScopedJuceInitialiser_GUI juceInit;
+
+    juce::StringArray args(argv + 1, argc - 1);
+    int iterations = 2000;
+    if( auto value = getArg(args, "--iterations"); value.isNotEmpty() )
+        iterations = juce::jmax(1, value.getIntValue());
+
+    DSPSettings settings;
+    if( auto value = getArg(args, "--samples"); value.isNotEmpty() )
+        settings.samplesPerRun = juce::jmax<juce::int64>(4096, value.getLargeIntValue());
+    if( auto value = getArg(args, "--repeats"); value.isNotEmpty() )
+        settings.repeats = juce::jmax(1, value.getIntValue());
+    if( args.contains("--quick") )
+    {
+        settings.blockSizes = { 16, 512, 4096 };
+        settings.sampleRates = { 48000.0, 192000.0 };
+    }
+
+    auto suite = getArg(args, "--suite");
+    if( suite.isEmpty() )
+        suite = "all";
+
+    if( juce::StringArray { "all", "state", "modules", "chain", "block", "hostblock" }.contains(suite) == false )
+    {
+        std::cerr << "Project13Bench: unknown suite '" << suite << "'" << std::endl;
+        return 1;
+    }
+
+    auto runSuite = [&suite](const char* name) { return suite == "all" || suite == name; };
+
+    juce::Array<juce::var> json;
+
+    if( runSuite("state") )
+    {
+        std::cout << "Project13Bench: state, " << iterations << " iterations" << std::endl;
+
+        auto results = runStateBenchmarks(iterations);
+        for( const auto& r : results )
+        {
+            printResult(r);
+            json.add(toJson(r));
+        }
+
+        /*
+         a big session saves every instance in a row. show what that costs for a 400-instance template.
+         */
+        for( const auto& r : results )
+        {
+            std::cout << r.name.paddedRight(' ', 28)
+                      << juce::String(r.nsPerOp * 400.0 / 1.0e6, 3).paddedLeft(' ', 12) << " ms per 400 instances"
+                      << std::endl;
+        }
+    }
+
+    if( suite != "state" )
+    {
+        std::cout << "Project13Bench: " << suite << ", " << settings.samplesPerRun << " samples x "
+                  << settings.repeats << " repeats per case" << std::endl;
+
+        //processBlock() does this itself. the module and chain hooks don't.
+        juce::ScopedNoDenormals noDenormals;
+
+        std::vector<DSPResult> results;
+        DSPBench bench(settings);
+        bench.runBaseline(results);
+        if( runSuite("modules") )
+            bench.runModules(results);
+        if( runSuite("chain") )
+            bench.runChain(results);
+        if( runSuite("block") )
+            bench.runBlock(results);
+        if( runSuite("hostblock") )
+            bench.runHostBlocks(results);
+
+        for( const auto& r : results )
+            json.add(toJson(r));
+    }
+
+    if( auto jsonPath = getArg(args, "--json"); jsonPath.isNotEmpty() )
+    {
+        auto* root = new juce::DynamicObject();
+        root->setProperty("tool", "Project13Bench");
+        root->setProperty("schema", 1);
+        root->setProperty("label", getArg(args, "--label"));
+        root->setProperty("date", juce::Time::getCurrentTime().toISO8601(true));
+        root->setProperty("juce", juce::SystemStats::getJUCEVersion());
+        root->setProperty("os", juce::SystemStats::getOperatingSystemName());
+        root->setProperty("cpu", juce::SystemStats::getCpuModel());
+        root->setProperty("samplesPerRun", settings.samplesPerRun);
+        root->setProperty("repeats", settings.repeats);
+        root->setProperty("results", json);
+
+        auto file = juce::File::getCurrentWorkingDirectory().getChildFile(jsonPath);
+        if( file.replaceWithText(juce::JSON::toString(juce::var(root))) == false )
+        {
+            std::cerr << "Project13Bench: can't write " << file.getFullPathName() << std::endl;
+            return 1;
+        }
+
+        std::cout << "wrote " << json.size() << " results to " << file.getFullPathName() << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,496 @@
+/*
+  ==============================================================================
+
+    GoldenSuite.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "GoldenSuite.h"
+#include "../../../Source/PluginProcessor.h"
+
+#include <iostream>
+
+namespace
+{
+using P = Project13AudioProcessor;
+
+constexpr double sampleRate = 48000.0;
+constexpr int blockSize = 512;
+constexpr int numSamples = 24000;
+//the bypass mask has a bit per module. it applies to every instance of the module alike.
+constexpr size_t numModules = P::numModuleKinds;
+
+enum class Signal
+{
+    Sweep,
+    Impulse,
+    Noise,
+    END_OF_LIST
+};
+
+const char* getSignalName(Signal signal)
+{
+    switch( signal )
+    {
+        case Signal::Sweep: return "sweep";
+        case Signal::Impulse: return "impulse";
+        case Signal::Noise: return "noise";
+        case Signal::END_OF_LIST: break;
+    }
+
+    jassertfalse;
+    return "";
+}
+
+double getToleranceDb(Signal signal)
+{
+    return signal == Signal::Impulse ? -100.0 : -80.0;
+}
+
+struct TestCase
+{
+    P::DSP_Order order;
+    int bypassMask = 0;
+    int ladderMode = 0;
+    int generalMode = 0;
+    Signal signal = Signal::Sweep;
+    //rendered offline with oversampling, or the way it plays in realtime
+    bool highQuality = true;
+
+    //i.e. o01234_b00_l0_g0_hq_sweep
+    juce::String getName() const
+    {
+        juce::String name("o");
+        for( auto option : order )
+            name << static_cast<int>(option);
+
+        name << "_b" << juce::String::toHexString(bypassMask).paddedLeft('0', 2)
+             << "_l" << ladderMode
+             << "_g" << generalMode
+             << (highQuality ? "_hq_" : "_rt_") << getSignalName(signal);
+        return name;
+    }
+};
+
+P::DSP_Order getDefaultOrder()
+{
+    return P::getDefaultOrder();
+}
+
+std::vector<P::DSP_Order> getAllOrders()
+{
+    std::array<P::DSP_Option, numModules> modules;
+    for( size_t i = 0; i < modules.size(); ++i )
+        modules[i] = static_cast<P::DSP_Option>(i);
+
+    //the modules start sorted, so this visits every permutation
+    std::vector<P::DSP_Order> orders;
+    do
+    {
+        P::DSP_Order order;
+        for( auto option : modules )
+            order.add(option);
+
+        orders.push_back(order);
+    } while( std::next_permutation(modules.begin(), modules.end()) );
+
+    //chains of other lengths: every instance on its own, and every slot used with both instances of some modules
+    for( size_t i = 0; i < static_cast<size_t>(P::DSP_Option::END_OF_LIST); ++i )
+    {
+        P::DSP_Order order;
+        order.add(static_cast<P::DSP_Option>(i));
+        orders.push_back(order);
+    }
+
+    auto full = getDefaultOrder();
+    for( size_t i = numModules; full.isFull() == false; ++i )
+        full.add(static_cast<P::DSP_Option>(i));
+
+    orders.push_back(full);
+    return orders;
+}
+
+std::vector<TestCase> getCases(bool exhaustive, int numLadderModes, int numGeneralModes)
+{
+    std::vector<TestCase> cases;
+    auto add = [&cases](const P::DSP_Order& order, int mask, int ladder, int general)
+    {
+        for( auto highQuality : { true, false } )
+        {
+            for( int s = 0; s < static_cast<int>(Signal::END_OF_LIST); ++s )
+                cases.push_back({ order, mask, ladder, general, static_cast<Signal>(s), highQuality });
+        }
+    };
+
+    const auto numMasks = 1 << numModules;
+    const auto defaultOrder = getDefaultOrder();
+
+    //every order with every mask covers the orders and the masks on their own, too
+    for( const auto& order : getAllOrders() )
+    {
+        for( int mask = 0; mask < (exhaustive ? numMasks : 1); ++mask )
+            add(order, mask, 0, 0);
+    }
+
+    if( exhaustive == false )
+    {
+        for( int mask = 1; mask < numMasks; ++mask )
+            add(defaultOrder, mask, 0, 0);
+    }
+
+    for( int ladder = 0; ladder < numLadderModes; ++ladder )
+    {
+        for( int general = 0; general < numGeneralModes; ++general )
+        {
+            if( ladder == 0 && general == 0 )
+                continue; //already covered
+
+            for( int mask = 0; mask < (exhaustive ? numMasks : 1); ++mask )
+                add(defaultOrder, mask, ladder, general);
+        }
+    }
+
+    return cases;
+}
+
+juce::AudioBuffer<float> makeSignal(Signal signal)
+{
+    juce::AudioBuffer<float> buffer(2, numSamples);
+    buffer.clear();
+
+    switch( signal )
+    {
+        case Signal::Sweep:
+        {
+            //exponential sine sweep, 20 Hz - 20 kHz, -6 dBFS
+            const auto f1 = 20.0, f2 = 20000.0;
+            const auto duration = numSamples / sampleRate;
+            const auto k = std::log(f2 / f1);
+            for( int i = 0; i < numSamples; ++i )
+            {
+                auto t = i / sampleRate;
+                auto phase = juce::MathConstants<double>::twoPi * f1 * duration / k * (std::exp(t / duration * k) - 1.0);
+                auto value = static_cast<float>(0.5 * std::sin(phase));
+                buffer.setSample(0, i, value);
+                buffer.setSample(1, i, value);
+            }
+            break;
+        }
+        case Signal::Impulse:
+        {
+            buffer.setSample(0, 0, 1.f);
+            buffer.setSample(1, 0, 1.f);
+            break;
+        }
+        case Signal::Noise:
+        {
+            //a fixed seed, and different noise per channel
+            juce::Random random(0x13);
+            for( int ch = 0; ch < 2; ++ch )
+            {
+                for( int i = 0; i < numSamples; ++i )
+                    buffer.setSample(ch, i, random.nextFloat() - 0.5f);
+            }
+            break;
+        }
+        case Signal::END_OF_LIST:
+            jassertfalse;
+            break;
+    }
+
+    return buffer;
+}
+
+P::StateParam getBypassParam(size_t module)
+{
+    constexpr std::array<P::StateParam, numModules> bypassParams
+    {
+        P::StateParam::PhaserBypass,
+        P::StateParam::ChorusBypass,
+        P::StateParam::OverdriveBypass,
+        P::StateParam::LadderFilterBypass,
+        P::StateParam::GeneralFilterBypass,
+    };
+
+    return bypassParams[module];
+}
+
+struct Renderer
+{
+    Renderer()
+    {
+        //the realtime cases must not depend on how fast this machine renders them
+        processor.setQualityMode(QualityGovernor::Mode::Off);
+        processor.setPlayConfigDetails(2, 2, sampleRate, blockSize);
+
+        for( int s = 0; s < static_cast<int>(Signal::END_OF_LIST); ++s )
+            signals.push_back(makeSignal(static_cast<Signal>(s)));
+    }
+
+    int getNumLadderModes() const { return processor.ladderFilterMode->choices.size(); }
+    int getNumGeneralModes() const { return processor.generalFilterMode->choices.size(); }
+
+    juce::AudioBuffer<float> render(const TestCase& test)
+    {
+        auto state = processor.getDefaultState();
+
+        //every instance of a module gets the same settings
+        auto set = [&state](P::StateParam param, float value)
+        {
+            for( size_t instance = 0; instance < P::numModuleInstances; ++instance )
+                state[P::getInstanceParam(param, instance)] = value;
+        };
+
+        //a voicing where every module changes the signal
+        set(P::StateParam::PhaserDepth, 80.f);
+        set(P::StateParam::PhaserMix, 50.f);
+        set(P::StateParam::ChorusDepth, 50.f);
+        set(P::StateParam::ChorusMix, 50.f);
+        set(P::StateParam::OverdriveSaturation, 4.f);
+        set(P::StateParam::LadderFilterCutoff, 2000.f);
+        set(P::StateParam::LadderFilterResonance, 40.f);
+        set(P::StateParam::GeneralFilterGain, 6.f);
+
+        set(P::StateParam::LadderFilterMode, static_cast<float>(test.ladderMode));
+        set(P::StateParam::GeneralFilterMode, static_cast<float>(test.generalMode));
+        for( size_t m = 0; m < numModules; ++m )
+            set(getBypassParam(m), (test.bypassMask >> m) & 1 ? 1.f : 0.f);
+
+        state.order = test.order;
+
+        //prepareToPlay() adopts the state and clears every module, so each case starts from scratch
+        processor.setNonRealtime(test.highQuality);
+        processor.applyState(state);
+        processor.prepareToPlay(sampleRate, blockSize);
+
+        auto buffer = signals[static_cast<size_t>(test.signal)];
+        for( int pos = 0; pos < numSamples; pos += blockSize )
+        {
+            auto num = juce::jmin(blockSize, numSamples - pos);
+            juce::AudioBuffer<float> block(buffer.getArrayOfWritePointers(), 2, pos, num);
+            processor.processBlock(block, midi);
+        }
+
+        processor.releaseResources();
+
+        P::Event event;
+        while( processor.popEvent(event) ) { }
+
+        return buffer;
+    }
+
+    Project13AudioProcessor processor;
+    std::vector<juce::AudioBuffer<float>> signals;
+    juce::MidiBuffer midi;
+};
+
+//==============================================================================
+struct Difference
+{
+    bool ok = false;
+    juce::String error;
+    double maxErrorDb = -200.0;
+    double nullDepthDb = -200.0;
+};
+
+double toDb(double gain)
+{
+    return juce::jmax(-200.0, 20.0 * std::log10(gain));
+}
+
+Difference compare(const juce::AudioBuffer<float>& reference, const juce::AudioBuffer<float>& result)
+{
+    Difference d;
+    if( reference.getNumChannels() != result.getNumChannels() || reference.getNumSamples() != result.getNumSamples() )
+    {
+        d.error = "length or channel count differs";
+        return d;
+    }
+
+    double maxError = 0.0, errorSquares = 0.0, referenceSquares = 0.0;
+    for( int ch = 0; ch < reference.getNumChannels(); ++ch )
+    {
+        auto* ref = reference.getReadPointer(ch);
+        auto* res = result.getReadPointer(ch);
+        for( int i = 0; i < reference.getNumSamples(); ++i )
+        {
+            auto error = static_cast<double>(res[i]) - static_cast<double>(ref[i]);
+            if( std::isfinite(res[i]) == false )
+                error = 1.0e10;
+
+            maxError = juce::jmax(maxError, std::abs(error));
+            errorSquares += error * error;
+            referenceSquares += static_cast<double>(ref[i]) * static_cast<double>(ref[i]);
+        }
+    }
+
+    d.ok = true;
+    d.maxErrorDb = toDb(maxError);
+    d.nullDepthDb = errorSquares == 0.0 ? -200.0 : toDb(std::sqrt(errorSquares / juce::jmax(referenceSquares, 1.0e-30)));
+    return d;
+}
+
+bool writeWav(const juce::File& file, const juce::AudioBuffer<float>& buffer)
+{
+    file.deleteFile();
+    auto stream = file.createOutputStream();
+    if( stream == nullptr )
+        return false;
+
+    juce::WavAudioFormat wav;
+    std::unique_ptr<juce::AudioFormatWriter> writer(wav.createWriterFor(stream.get(), sampleRate, 2, 32, {}, 0));
+    if( writer == nullptr )
+        return false;
+
+    stream.release(); //the writer owns the stream now
+    return writer->writeFromAudioSampleBuffer(buffer, 0, buffer.getNumSamples());
+}
+
+std::optional<juce::AudioBuffer<float>> readWav(const juce::File& file)
+{
+    juce::WavAudioFormat wav;
+    std::unique_ptr<juce::AudioFormatReader> reader(wav.createReaderFor(file.createInputStream().release(), true));
+    if( reader == nullptr )
+        return {};
+
+    juce::AudioBuffer<float> buffer(static_cast<int>(reader->numChannels), static_cast<int>(reader->lengthInSamples));
+    if( reader->read(&buffer, 0, buffer.getNumSamples(), 0, true, true) == false )
+        return {};
+
+    return buffer;
+}
+
+//the case's own tolerance comes from the signal at the end of its name
+double getToleranceDb(const GoldenSuite::Settings& settings, const juce::String& caseName)
+{
+    if( settings.toleranceDb.has_value() )
+        return *settings.toleranceDb;
+
+    for( int s = 0; s < static_cast<int>(Signal::END_OF_LIST); ++s )
+    {
+        if( caseName.endsWith(juce::String("_") + getSignalName(static_cast<Signal>(s))) )
+            return getToleranceDb(static_cast<Signal>(s));
+    }
+
+    return -80.0;
+}
+
+struct Summary
+{
+    int numCases = 0, numFailed = 0;
+    double worstMaxErrorDb = -200.0, worstNullDepthDb = -200.0;
+
+    void add(const GoldenSuite::Settings& settings, const juce::String& name, const Difference& d)
+    {
+        ++numCases;
+        const auto tolerance = getToleranceDb(settings, name);
+        const auto passed = d.ok && d.maxErrorDb <= tolerance;
+        if( passed == false )
+            ++numFailed;
+
+        if( d.ok )
+        {
+            worstMaxErrorDb = juce::jmax(worstMaxErrorDb, d.maxErrorDb);
+            worstNullDepthDb = juce::jmax(worstNullDepthDb, d.nullDepthDb);
+        }
+
+        if( passed && settings.verbose == false )
+            return;
+
+        std::cout << (passed ? "ok     " : "FAILED ") << name.paddedRight(' ', 28);
+        if( d.ok )
+        {
+            std::cout << " max error " << juce::String(d.maxErrorDb, 1) << " dB (tolerance " << juce::String(tolerance, 1) << " dB)"
+                      << ", null depth " << juce::String(d.nullDepthDb, 1) << " dB" << std::endl;
+        }
+        else
+        {
+            std::cout << " " << d.error << std::endl;
+        }
+    }
+
+    int print() const
+    {
+        std::cout << numCases << " cases, " << numFailed << " failed" << std::endl
+                  << "worst max error    " << juce::String(worstMaxErrorDb, 1) << " dB" << std::endl
+                  << "shallowest null    " << juce::String(worstNullDepthDb, 1) << " dB" << std::endl;
+
+        return numFailed == 0 && numCases > 0 ? 0 : 1;
+    }
+};
+} //end anonymous namespace
+
+//==============================================================================
+namespace GoldenSuite
+{
+    int writeReferences(const Settings& settings)
+    {
+        if( settings.folder.createDirectory().failed() )
+        {
+            std::cerr << "Project13Check: can't create " << settings.folder.getFullPathName() << std::endl;
+            return 1;
+        }
+
+        Renderer renderer;
+        const auto cases = getCases(settings.exhaustive, renderer.getNumLadderModes(), renderer.getNumGeneralModes());
+        for( const auto& test : cases )
+        {
+            auto file = settings.folder.getChildFile(test.getName() + ".wav");
+            if( writeWav(file, renderer.render(test)) == false )
+            {
+                std::cerr << "Project13Check: can't write " << file.getFullPathName() << std::endl;
+                return 1;
+            }
+        }
+
+        std::cout << "wrote " << cases.size() << " references to " << settings.folder.getFullPathName() << std::endl;
+        return 0;
+    }
+
+    int compareWithReferences(const Settings& settings)
+    {
+        Renderer renderer;
+        Summary summary;
+        for( const auto& test : getCases(settings.exhaustive, renderer.getNumLadderModes(), renderer.getNumGeneralModes()) )
+        {
+            auto name = test.getName();
+            auto reference = readWav(settings.folder.getChildFile(name + ".wav"));
+
+            Difference d;
+            if( reference.has_value() )
+                d = compare(*reference, renderer.render(test));
+            else
+                d.error = "no reference";
+
+            summary.add(settings, name, d);
+        }
+
+        return summary.print();
+    }
+
+    int compareFolders(const Settings& settings, const juce::File& other)
+    {
+        auto files = settings.folder.findChildFiles(juce::File::findFiles, false, "*.wav");
+        files.sort();
+
+        Summary summary;
+        for( const auto& file : files )
+        {
+            auto name = file.getFileNameWithoutExtension();
+            auto a = readWav(file);
+            auto b = readWav(other.getChildFile(file.getFileName()));
+
+            Difference d;
+            if( a.has_value() && b.has_value() )
+                d = compare(*a, *b);
+            else
+                d.error = a.has_value() ? "missing in " + other.getFullPathName() : "can't read " + file.getFullPathName();
+
+            summary.add(settings, name, d);
+        }
+
+        return summary.print();
+    }
+}
@@ -0,0 +1,59 @@
+/*
+  ==============================================================================
+
+    GoldenSuite.h
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/*
+ Golden-output regression tests.
+
+ Fixed test signals (a log sine sweep, an impulse and seeded noise) are rendered through processBlock(),
+    both as a high quality offline render and the way they play in realtime, for:
+    every permutation of the 5 modules, every module instance on its own and a chain that fills every slot,
+        with every module active,
+    every bypass mask in the default order,
+    every ladder filter mode x general filter mode in the default order.
+ --exhaustive also renders every order with every bypass mask, and every filter mode pair with every bypass mask.
+
+ The modules are set to a fixed voicing where each one audibly changes the signal. Everything else
+    is left at its default. Each case starts from a freshly prepared processor, so the results don't
+    depend on which cases ran before it. the quality governor is off, so the realtime cases don't depend
+    on the speed of the machine either.
+ A realtime case is named like its high quality twin, with _rt_ instead of _hq_ before the signal.
+
+ References are stereo 32-bit float WAV files, one per case, named after the case.
+ A case passes when the largest sample difference is within its tolerance:
+    -100 dBFS for the impulse, -80 dBFS for the sweep and the noise, which drive the nonlinear
+    modules harder and so amplify rounding differences more.
+ The null-test depth (the RMS of the difference relative to the RMS of the reference) is reported too.
+ */
+namespace GoldenSuite
+{
+    struct Settings
+    {
+        juce::File folder;
+        bool exhaustive = false;
+        //overrides every case's own tolerance when set
+        std::optional<double> toleranceDb;
+        bool verbose = false;
+    };
+
+    //renders every case with this build and stores the results as the new references
+    int writeReferences(const Settings& settings);
+
+    //renders every case with this build and compares it against the references
+    int compareWithReferences(const Settings& settings);
+
+    /*
+     compares two sets of references, i.e. written by two different builds.
+     every file in 'settings.folder' is compared with the file of the same name in 'other'.
+     */
+    int compareFolders(const Settings& settings, const juce::File& other);
+}
@@ -0,0 +1,617 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 19 Oct 2026
+
+    Project13Check
+    Realtime-safety checker for Project13AudioProcessor.
+
+    Drives processBlock() through every permutation of the 5 modules, and chains of other lengths
+        with second module instances, with parameter sweeps, crossfades,
+        morphing, modulation, state restores and odd block sizes, while RealtimeGuard watches the audio thread
+        for allocations, locks, sleeps and writes.
+    Every distinct violation is printed once with its stack trace, and the exit code is 1,
+        so a build script or CI job fails on a regression.
+    The same sample-accurate parameter events, with LFOs and envelope followers modulating too,
+        are also rendered at block sizes 1, 17, 512 and 2048, and the renders must be bit-identical.
+    And a sustained tone must not click while mid/side mode is switched on and off.
+
+    It also runs the golden-output regression tests. see GoldenSuite.h.
+
+    usage:
+        Project13Check [--sample-rate N] [--block-size N] [--steps N] [--seed N]
+        Project13Check --golden-write <dir> [--exhaustive]
+        Project13Check --golden <dir> [--exhaustive] [--tolerance-db N] [--verbose]
+        Project13Check --golden-diff <dirA> <dirB> [--tolerance-db N] [--verbose]
+
+        --sample-rate   defaults to 48000.
+        --block-size    the block size prepareToPlay() is given. defaults to 512.
+                        processBlock() is also called with smaller, irregular blocks, the way hosts do.
+        --steps         parameter changes per DSP_Order. defaults to 8.
+        --seed          seed for the random parameter values. defaults to 1.
+
+        --golden-write  renders every golden case and stores the results in <dir> as the references.
+        --golden        renders every golden case and compares it against the references in <dir>.
+        --golden-diff   compares the references two builds wrote, without rendering anything.
+        --exhaustive    also renders every order and every filter mode pair with every bypass mask.
+        --tolerance-db  the largest allowed difference for every case, i.e. -60.
+                        by default each case uses its own, depending on the test signal.
+        --verbose       prints the cases that pass, too.
+
+    Linux only. see RealtimeGuard.h.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../../../Source/PluginProcessor.h"
+#include "RealtimeGuard.h"
+#include "GoldenSuite.h"
+
+#include <iostream>
+
+namespace
+{
+using P = Project13AudioProcessor;
+
+struct CheckSettings
+{
+    double sampleRate = 48000.0;
+    int blockSize = 512;
+    int steps = 8;
+    juce::int64 seed = 1;
+};
+
+std::vector<P::DSP_Order> getAllOrders()
+{
+    std::array<P::DSP_Option, P::numModuleKinds> modules;
+    for( size_t i = 0; i < modules.size(); ++i )
+        modules[i] = static_cast<P::DSP_Option>(i);
+
+    //the modules start sorted, so this visits every permutation
+    std::vector<P::DSP_Order> orders;
+    do
+    {
+        P::DSP_Order order;
+        for( auto option : modules )
+            order.add(option);
+
+        orders.push_back(order);
+    } while( std::next_permutation(modules.begin(), modules.end()) );
+
+    //every instance on its own, so switching between them changes the chain's length and its latency padding
+    for( size_t i = 0; i < static_cast<size_t>(P::DSP_Option::END_OF_LIST); ++i )
+    {
+        P::DSP_Order order;
+        order.add(static_cast<P::DSP_Option>(i));
+        orders.push_back(order);
+    }
+
+    //every slot used, with both instances of a module in the chain at once
+    P::DSP_Order full;
+    for( size_t i = static_cast<size_t>(P::DSP_Option::END_OF_LIST); full.isFull() == false; --i )
+        full.add(static_cast<P::DSP_Option>(i - 1));
+
+    orders.push_back(full);
+    return orders;
+}
+
+struct Checker
+{
+    explicit Checker(const CheckSettings& s) : settings(s), random(s.seed)
+    {
+        //with the sidechain connected, so the envelope followers that listen to it have something to measure
+        auto layout = processor.getBusesLayout();
+        layout.inputBuses.getReference(1) = juce::AudioChannelSet::stereo();
+        processor.setBusesLayout(layout);
+        processor.setRateAndBufferSizeDetails(settings.sampleRate, settings.blockSize);
+        processor.prepareToPlay(settings.sampleRate, settings.blockSize);
+        numChannels = processor.getTotalNumInputChannels();
+
+        //what an open editor turns on. the analyzer fifos and the meters run on the audio thread too.
+        analyzerFifos = &processor.openAnalyzer();
+        processor.sendCommand(P::Command::requestSnapshot());
+
+        buffer.setSize(numChannels, settings.blockSize);
+    }
+
+    /*
+     one block, the way a host delivers it: fresh input, then processBlock() on its own.
+     the checks only cover processBlock(). everything the message thread does in between is allowed to allocate.
+     */
+    void processBlock(int numSamples)
+    {
+        buffer.setSize(numChannels, numSamples, false, false, true);
+        for( int ch = 0; ch < numChannels; ++ch )
+        {
+            for( int i = 0; i < numSamples; ++i )
+                buffer.setSample(ch, i, random.nextFloat() * 0.5f - 0.25f);
+        }
+
+        {
+            RealtimeGuard::ScopedRealtimeCheck check;
+            processor.processBlock(buffer, midi);
+        }
+
+        drainEvents();
+    }
+
+    //what the editor's timerCallback() would do
+    void drainEvents()
+    {
+        P::Event event;
+        while( processor.popEvent(event) ) { }
+
+        for( auto* scsf : { &analyzerFifos->left, &analyzerFifos->right } )
+        {
+            juce::AudioBuffer<float> discard;
+            while( scsf->getNumCompleteBuffersAvailable() > 0 )
+                scsf->getAudioBuffer(discard);
+        }
+    }
+
+    //a host's automation: random values, with the extremes mixed in
+    void randomizeParameters()
+    {
+        for( size_t i = 0; i < P::numStateParams; ++i )
+        {
+            if( static_cast<P::StateParam>(i) == P::StateParam::SelectedTab )
+                continue;
+
+            auto pick = random.nextInt(4);
+            auto value = pick == 0 ? 0.f : pick == 1 ? 1.f : random.nextFloat();
+            processor.stateParams[i]->setValueNotifyingHost(value);
+        }
+    }
+
+    //every source routed to every target with a random depth, and fast modulators so they move within a block
+    void randomizeModulation()
+    {
+        ModMatrix::Routing routing;
+        for( auto& lfo : routing.lfos )
+            lfo = { 0.1f + random.nextFloat() * 20.f, static_cast<ModMatrix::LfoShape>(random.nextInt(static_cast<int>(ModMatrix::LfoShape::END_OF_LIST))) };
+        for( auto& envelope : routing.envelopes )
+        {
+            envelope = { random.nextFloat() * 50.f, random.nextFloat() * 500.f,
+                random.nextBool() ? ModMatrix::Detector::Peak : ModMatrix::Detector::Rms,
+                random.nextBool() ? ModMatrix::EnvelopeInput::Main : ModMatrix::EnvelopeInput::Sidechain };
+        }
+
+        for( size_t s = 0; s < ModMatrix::numSources; ++s )
+        {
+            for( size_t t = 0; t < P::numModTargets; ++t )
+                routing.setDepth(static_cast<ModMatrix::Source>(s), t, random.nextFloat() * 2.f - 1.f);
+        }
+
+        processor.setModRouting(routing);
+    }
+
+    void runBlocks()
+    {
+        //full blocks, then the sizes hosts produce around loop points and automation splits
+        for( auto numSamples : { settings.blockSize, 1, 17, settings.blockSize / 3, 64, settings.blockSize } )
+            processBlock(juce::jlimit(1, settings.blockSize, numSamples));
+    }
+
+    void run()
+    {
+        const auto orders = getAllOrders();
+        for( size_t i = 0; i < orders.size(); ++i )
+        {
+            setContext("order " + juce::String(static_cast<int>(i)) + " with random parameters");
+
+            //half of the orders switch with a crossfade, so both chains run
+            processor.crossfadeMode->setValueNotifyingHost(i % 2 == 0 ? 0.f : 1.f);
+            processor.sendCommand(P::Command::setOrder(orders[i]));
+
+            for( int step = 0; step < settings.steps; ++step )
+            {
+                randomizeParameters();
+                runBlocks();
+            }
+        }
+
+        setContext("morph sweep");
+        processor.morphEnabled->setValueNotifyingHost(1.f);
+        randomizeParameters();
+        processor.storeMorphSnapshot(P::MorphSlot::A);
+        randomizeParameters();
+        processor.storeMorphSnapshot(P::MorphSlot::B);
+        for( int step = 0; step <= 20; ++step )
+        {
+            processor.morph->setValueNotifyingHost(static_cast<float>(step % 11) / 10.f);
+            runBlocks();
+        }
+
+        processor.morphEnabled->setValueNotifyingHost(0.f);
+
+        //the routing stays on for the state restores, so it goes through the state chunk too
+        setContext("modulation");
+        for( int step = 0; step < settings.steps; ++step )
+        {
+            randomizeModulation();
+            randomizeParameters();
+            runBlocks();
+        }
+
+        setContext("state restore");
+        for( int step = 0; step < settings.steps; ++step )
+        {
+            randomizeParameters();
+            juce::MemoryBlock state;
+            processor.getStateInformation(state);
+            randomizeParameters();
+            processor.setStateInformation(state.getData(), static_cast<int>(state.getSize()));
+            runBlocks();
+        }
+
+        setContext("reset");
+        processor.reset();
+        runBlocks();
+    }
+
+private:
+    void setContext(const juce::String& context)
+    {
+        //RealtimeGuard keeps the pointer, so the strings live as long as the checker
+        contexts.add(context);
+        RealtimeGuard::setContext(contexts.getReference(contexts.size() - 1).toRawUTF8());
+    }
+
+    const CheckSettings& settings;
+    juce::Random random;
+
+    Project13AudioProcessor processor;
+    P::AnalyzerFifos* analyzerFifos = nullptr;
+    //the main bus and the sidechain
+    int numChannels = 2;
+    juce::AudioBuffer<float> buffer;
+    juce::MidiBuffer midi;
+
+    juce::StringArray contexts;
+};
+
+//==============================================================================
+/*
+ sample-accurate automation and modulation must not depend on how the host splits the audio into blocks.
+ each block size renders on a freshly prepared processor, in realtime with the quality governor off,
+    so nothing but the block size differs.
+ mid/side mode is switched on and off too, so the render has crossfades in it. the largest block size
+    is longer than any control interval, so a crossfade has to be cut into segments that fit its buffer.
+ */
+constexpr std::array eventBlockSizes { 1, 17, 512, 2048 };
+static_assert(eventBlockSizes.back() > QualityGovernor::maxControlInterval);
+constexpr int eventRenderLength = 8192;
+
+std::vector<P::ParameterEvent> makeParameterEvents(const CheckSettings& settings)
+{
+    //only used for the parameter ranges
+    Project13AudioProcessor processor;
+    juce::Random random(settings.seed);
+
+    //sorted by sampleOffset, several on the same sample now and then
+    std::vector<P::ParameterEvent> events;
+    for( int offset = 0; offset < eventRenderLength; offset += random.nextInt(160) )
+    {
+        auto param = P::smoothedParams[static_cast<size_t>(random.nextInt(static_cast<int>(P::smoothedParams.size())))];
+        auto* parameter = processor.stateParams[static_cast<size_t>(param)];
+        events.push_back({ offset, param, parameter->convertFrom0to1(random.nextFloat()) });
+    }
+
+    //the switches land in the middle of the largest blocks
+    for( auto [offset, value] : { std::pair { 1500, 1.f }, std::pair { 5500, 0.f } } )
+    {
+        auto it = std::upper_bound(events.begin(), events.end(), offset,
+                                   [](int o, const P::ParameterEvent& e) { return o < e.sampleOffset; });
+        events.insert(it, { offset, P::StateParam::MidSideMode, value });
+    }
+
+    return events;
+}
+
+/*
+ every source routed to a few smoothed parameters, so the LFOs and the envelope followers have to land
+    on the same values at every block size too.
+ one follower listens for peaks and one for RMS, with short times so they move within the render.
+ */
+ModMatrix::Routing makeModRouting(const CheckSettings& settings)
+{
+    juce::Random random(settings.seed + 1);
+
+    ModMatrix::Routing routing;
+    routing.lfos[0] = { 7.f, ModMatrix::LfoShape::Sine };
+    routing.lfos[1] = { 3.f, ModMatrix::LfoShape::Triangle };
+    routing.envelopes[0] = { 1.f, 20.f, ModMatrix::Detector::Peak, ModMatrix::EnvelopeInput::Main };
+    routing.envelopes[1] = { 5.f, 50.f, ModMatrix::Detector::Rms, ModMatrix::EnvelopeInput::Main };
+
+    for( size_t s = 0; s < ModMatrix::numSources; ++s )
+    {
+        for( int route = 0; route < 3; ++route )
+        {
+            auto param = P::smoothedParams[static_cast<size_t>(random.nextInt(static_cast<int>(P::smoothedParams.size())))];
+            if( auto target = P::getModTarget(param) )
+                routing.setDepth(static_cast<ModMatrix::Source>(s), *target, random.nextFloat() - 0.5f);
+        }
+    }
+
+    return routing;
+}
+
+juce::AudioBuffer<float> renderParameterEvents(const CheckSettings& settings,
+                                               const std::vector<P::ParameterEvent>& events,
+                                               int blockSize)
+{
+    Project13AudioProcessor processor;
+    processor.setQualityMode(QualityGovernor::Mode::Off);
+    //lands on the first control tick, the same sample at every block size
+    processor.setModRouting(makeModRouting(settings));
+    processor.setRateAndBufferSizeDetails(settings.sampleRate, eventBlockSizes.back());
+    processor.prepareToPlay(settings.sampleRate, eventBlockSizes.back());
+
+    //the same seeded noise for every block size
+    juce::Random random(settings.seed);
+    juce::AudioBuffer<float> buffer(juce::jmax(processor.getTotalNumInputChannels(), processor.getTotalNumOutputChannels()), eventRenderLength);
+    buffer.clear();
+    for( int ch = 0; ch < 2; ++ch )
+    {
+        for( int i = 0; i < eventRenderLength; ++i )
+            buffer.setSample(ch, i, random.nextFloat() * 0.5f - 0.25f);
+    }
+
+    juce::MidiBuffer midi;
+    std::vector<P::ParameterEvent> blockEvents;
+    blockEvents.reserve(events.size());
+
+    size_t nextEvent = 0;
+    for( int pos = 0; pos < eventRenderLength; pos += blockSize )
+    {
+        const auto numSamples = juce::jmin(blockSize, eventRenderLength - pos);
+
+        //the block's own events, with offsets relative to its start
+        blockEvents.clear();
+        for( ; nextEvent < events.size() && events[nextEvent].sampleOffset < pos + numSamples; ++nextEvent )
+        {
+            auto event = events[nextEvent];
+            event.sampleOffset -= pos;
+            blockEvents.push_back(event);
+        }
+
+        juce::AudioBuffer<float> block(buffer.getArrayOfWritePointers(), buffer.getNumChannels(), pos, numSamples);
+
+        RealtimeGuard::ScopedRealtimeCheck check;
+        processor.processBlockWithParameterEvents(block, midi, blockEvents);
+    }
+
+    processor.releaseResources();
+    return buffer;
+}
+
+//returns false, and says where, if any block size renders differently from the first one
+bool checkEventBlockSizes(const CheckSettings& settings)
+{
+    RealtimeGuard::setContext("parameter events at block sizes 1, 17, 512 and 2048");
+
+    const auto events = makeParameterEvents(settings);
+    const auto reference = renderParameterEvents(settings, events, eventBlockSizes.front());
+
+    auto identical = true;
+    for( size_t b = 1; b < eventBlockSizes.size(); ++b )
+    {
+        const auto result = renderParameterEvents(settings, events, eventBlockSizes[b]);
+        for( int ch = 0; ch < 2; ++ch )
+        {
+            auto* expected = reference.getReadPointer(ch);
+            auto* actual = result.getReadPointer(ch);
+            auto* mismatch = std::mismatch(expected, expected + eventRenderLength, actual,
+                                           [](float x, float y) { return std::memcmp(&x, &y, sizeof(float)) == 0; }).first;
+            if( mismatch != expected + eventRenderLength )
+            {
+                auto i = static_cast<int>(mismatch - expected);
+                std::cout << "parameter events: block size " << eventBlockSizes[b] << " differs from block size "
+                          << eventBlockSizes.front() << " on channel " << ch << " from sample " << i
+                          << " (" << expected[i] << " vs " << actual[i] << ")" << std::endl;
+                identical = false;
+                break;
+            }
+        }
+    }
+
+    return identical;
+}
+
+//==============================================================================
+/*
+ switching mid/side mode crossfades between a pair of chains in each mode, and must not click.
+ a sustained stereo tone runs through a voicing where every module changes the signal, and the side
+    skips the phaser and the chorus, while the mode flips every half second.
+ the largest step between two samples anywhere in the render may be at most twice the largest one
+    in the steady stretches just before each switch.
+ */
+constexpr int midSideTogglePeriod = 24000;
+constexpr int midSideToggles = 8;
+//longer than any control interval, like the largest block size of the parameter events
+constexpr int midSideBlockSize = 2048;
+
+bool checkMidSideToggle(const CheckSettings& settings)
+{
+    RealtimeGuard::setContext("mid/side toggles under a sustained tone");
+
+    Project13AudioProcessor processor;
+    processor.setQualityMode(QualityGovernor::Mode::Off);
+
+    auto state = processor.getDefaultState();
+    auto set = [&state](P::StateParam param, float value)
+    {
+        for( size_t instance = 0; instance < P::numModuleInstances; ++instance )
+            state[P::getInstanceParam(param, instance)] = value;
+    };
+
+    set(P::StateParam::PhaserDepth, 80.f);
+    set(P::StateParam::PhaserMix, 50.f);
+    set(P::StateParam::ChorusDepth, 50.f);
+    set(P::StateParam::ChorusMix, 50.f);
+    set(P::StateParam::OverdriveSaturation, 4.f);
+    set(P::StateParam::LadderFilterCutoff, 2000.f);
+    set(P::StateParam::LadderFilterResonance, 40.f);
+    set(P::StateParam::GeneralFilterGain, 6.f);
+    set(P::StateParam::PhaserSideBypass, 1.f);
+    set(P::StateParam::ChorusSideBypass, 1.f);
+    state[P::StateParam::MidSideMode] = 0.f;
+
+    processor.applyState(state);
+    processor.setRateAndBufferSizeDetails(settings.sampleRate, midSideBlockSize);
+    processor.prepareToPlay(settings.sampleRate, midSideBlockSize);
+
+    //a different pitch on each side, so there is a side signal to process
+    const auto length = midSideTogglePeriod * (midSideToggles + 1);
+    juce::AudioBuffer<float> buffer(juce::jmax(processor.getTotalNumInputChannels(), processor.getTotalNumOutputChannels()), length);
+    buffer.clear();
+    for( int i = 0; i < length; ++i )
+    {
+        auto t = static_cast<double>(i) / settings.sampleRate;
+        buffer.setSample(0, i, 0.25f * static_cast<float>(std::sin(juce::MathConstants<double>::twoPi * 220.0 * t)));
+        buffer.setSample(1, i, 0.25f * static_cast<float>(std::sin(juce::MathConstants<double>::twoPi * 330.0 * t)));
+    }
+
+    juce::MidiBuffer midi;
+    for( int pos = 0; pos < length; pos += midSideBlockSize )
+    {
+        const auto numSamples = juce::jmin(midSideBlockSize, length - pos);
+
+        //the switch lands mid-block, on the sample it is due
+        std::vector<P::ParameterEvent> events;
+        const auto period = (pos + midSideTogglePeriod - 1) / midSideTogglePeriod;
+        const auto toggle = period * midSideTogglePeriod;
+        if( period >= 1 && period <= midSideToggles && toggle < pos + numSamples )
+            events.push_back({ toggle - pos, P::StateParam::MidSideMode, static_cast<float>(period % 2) });
+
+        juce::AudioBuffer<float> block(buffer.getArrayOfWritePointers(), buffer.getNumChannels(), pos, numSamples);
+
+        RealtimeGuard::ScopedRealtimeCheck check;
+        processor.processBlockWithParameterEvents(block, midi, events);
+    }
+
+    processor.releaseResources();
+
+    //the largest step within [start, end) on either channel
+    auto largestStep = [&buffer](int start, int end)
+    {
+        auto step = 0.f;
+        for( int ch = 0; ch < 2; ++ch )
+        {
+            auto* samples = buffer.getReadPointer(ch);
+            for( int i = juce::jmax(1, start); i < end; ++i )
+                step = juce::jmax(step, std::abs(samples[i] - samples[i - 1]));
+        }
+        return step;
+    };
+
+    //the steady stretches: the last third of each period, long after the 50 ms fade
+    auto steadyStep = 0.f;
+    for( int toggle = 1; toggle <= midSideToggles + 1; ++toggle )
+        steadyStep = juce::jmax(steadyStep, largestStep(toggle * midSideTogglePeriod - midSideTogglePeriod / 3, toggle * midSideTogglePeriod));
+
+    //the first period settles the filters and the delays, and is left out
+    const auto step = largestStep(midSideTogglePeriod - midSideTogglePeriod / 3, length);
+    if( step > 2.f * steadyStep )
+    {
+        std::cout << "mid/side toggles: a step of " << step << " between two samples, against at most "
+                  << steadyStep << " while the mode holds" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+juce::String getArg(const juce::StringArray& args, const juce::String& name)
+{
+    auto idx = args.indexOf(name);
+    return idx >= 0 && idx + 1 < args.size() ? args[idx + 1] : juce::String();
+}
+} //end anonymous namespace
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    RealtimeGuard::install();
+
+    //the APVTS and the parameter listeners expect a message manager.
+    juce::ScopedJuceInitialiser_GUI juceInit;
+
+    juce::StringArray args(argv + 1, argc - 1);
+
+    GoldenSuite::Settings golden;
+    golden.exhaustive = args.contains("--exhaustive");
+    golden.verbose = args.contains("--verbose");
+    if( auto value = getArg(args, "--tolerance-db"); value.isNotEmpty() )
+        golden.toleranceDb = value.getDoubleValue();
+
+    if( auto dir = getArg(args, "--golden-write"); dir.isNotEmpty() )
+    {
+        golden.folder = juce::File::getCurrentWorkingDirectory().getChildFile(dir);
+        return GoldenSuite::writeReferences(golden);
+    }
+
+    if( auto dir = getArg(args, "--golden"); dir.isNotEmpty() )
+    {
+        golden.folder = juce::File::getCurrentWorkingDirectory().getChildFile(dir);
+        return GoldenSuite::compareWithReferences(golden);
+    }
+
+    if( auto idx = args.indexOf("--golden-diff"); idx >= 0 )
+    {
+        if( idx + 2 >= args.size() )
+        {
+            std::cerr << "Project13Check: --golden-diff needs two folders" << std::endl;
+            return 1;
+        }
+
+        golden.folder = juce::File::getCurrentWorkingDirectory().getChildFile(args[idx + 1]);
+        return GoldenSuite::compareFolders(golden, juce::File::getCurrentWorkingDirectory().getChildFile(args[idx + 2]));
+    }
+
+    CheckSettings settings;
+    if( auto value = getArg(args, "--sample-rate"); value.isNotEmpty() )
+        settings.sampleRate = juce::jlimit(8000.0, 384000.0, value.getDoubleValue());
+    if( auto value = getArg(args, "--block-size"); value.isNotEmpty() )
+        settings.blockSize = juce::jlimit(16, 8192, value.getIntValue());
+    if( auto value = getArg(args, "--steps"); value.isNotEmpty() )
+        settings.steps = juce::jmax(1, value.getIntValue());
+    if( auto value = getArg(args, "--seed"); value.isNotEmpty() )
+        settings.seed = value.getLargeIntValue();
+
+    std::cout << "Project13Check: " << settings.sampleRate << " Hz, block size " << settings.blockSize
+              << ", " << settings.steps << " steps per order" << std::endl;
+
+    {
+        Checker checker(settings);
+        checker.run();
+    }
+
+    const auto eventsMatch = checkEventBlockSizes(settings);
+    const auto midSideSmooth = checkMidSideToggle(settings);
+
+    if( RealtimeGuard::getNumViolations() > 0 )
+    {
+        RealtimeGuard::printReport(std::cout);
+        std::cout << "FAILED: " << RealtimeGuard::getNumViolations()
+                  << " realtime-safety violations in processBlock()" << std::endl;
+        return 1;
+    }
+
+    if( eventsMatch == false )
+    {
+        std::cout << "FAILED: the parameter events render differently at different block sizes" << std::endl;
+        return 1;
+    }
+
+    if( midSideSmooth == false )
+    {
+        std::cout << "FAILED: switching mid/side mode clicks" << std::endl;
+        return 1;
+    }
+
+    std::cout << "passed" << std::endl;
+    return 0;
+}
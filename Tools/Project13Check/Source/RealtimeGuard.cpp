@@ -0,0 +1,296 @@
+/*
+  ==============================================================================
+
+    RealtimeGuard.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "RealtimeGuard.h"
+
+#include <cerrno>
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <map>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+
+//the real implementations, exported by glibc
+extern "C"
+{
+    void* __libc_malloc(size_t size) noexcept;
+    void* __libc_calloc(size_t count, size_t size) noexcept;
+    void* __libc_realloc(void* ptr, size_t size) noexcept;
+    void* __libc_memalign(size_t alignment, size_t size) noexcept;
+    void __libc_free(void* ptr) noexcept;
+
+    int __nanosleep(const struct timespec* duration, struct timespec* remaining);
+    int __sched_yield() noexcept;
+    ssize_t __write(int fd, const void* buffer, size_t size);
+}
+
+namespace
+{
+using RealtimeGuard::Kind;
+
+constexpr int maxFrames = 24;
+constexpr int maxViolations = 512;
+//the frames inside note() and the replacement function itself
+constexpr int framesToSkip = 2;
+
+struct Violation
+{
+    Kind kind = Kind::END_OF_LIST;
+    size_t size = 0;
+    const char* context = nullptr;
+    int numFrames = 0;
+    void* frames[maxFrames] {};
+};
+
+//plain globals, so nothing here is constructed after the first malloc() call
+Violation violations[maxViolations];
+std::atomic<int> numViolations { 0 };
+std::atomic<const char*> currentContext { nullptr };
+
+//libpthread's entry points aren't exported under another name, so these are looked up with dlsym()
+using MutexFunction = int (*)(pthread_mutex_t*) noexcept;
+std::atomic<MutexFunction> realMutexLock { nullptr }, realMutexTrylock { nullptr };
+
+MutexFunction getReal(std::atomic<MutexFunction>& function, const char* name)
+{
+    auto f = function.load();
+    if( f == nullptr )
+    {
+        f = reinterpret_cast<MutexFunction>(dlsym(RTLD_NEXT, name));
+        function.store(f);
+    }
+
+    return f;
+}
+
+thread_local int checkDepth = 0;
+thread_local bool recording = false;
+
+void note(Kind kind, size_t size = 0)
+{
+    //backtrace() can call malloc() itself
+    if( checkDepth == 0 || recording )
+        return;
+
+    recording = true;
+
+    auto idx = numViolations.fetch_add(1);
+    if( idx < maxViolations )
+    {
+        auto& v = violations[idx];
+        v.kind = kind;
+        v.size = size;
+        v.context = currentContext.load();
+        v.numFrames = backtrace(v.frames, maxFrames);
+    }
+
+    recording = false;
+}
+
+const char* getKindName(Kind kind)
+{
+    switch( kind )
+    {
+        case Kind::Malloc: return "allocation";
+        case Kind::Free: return "deallocation";
+        case Kind::MutexLock: return "mutex lock";
+        case Kind::Sleep: return "sleep/yield";
+        case Kind::Write: return "write()";
+        case Kind::END_OF_LIST: break;
+    }
+
+    return "?";
+}
+
+//"binary(mangled+0x12) [0x...]" -> "demangled+0x12"
+juce::String demangle(const char* symbol)
+{
+    juce::String s(symbol);
+    auto open = s.indexOfChar('(');
+    auto plus = s.indexOfChar(open, '+');
+    if( open < 0 || plus <= open + 1 )
+        return s;
+
+    auto mangled = s.substring(open + 1, plus);
+    int status = 0;
+    auto* demangled = abi::__cxa_demangle(mangled.toRawUTF8(), nullptr, nullptr, &status);
+    if( demangled == nullptr )
+        return s;
+
+    auto result = juce::String(demangled) + s.substring(plus, s.indexOfChar(plus, ')'));
+    std::free(demangled);
+    return result;
+}
+} //end anonymous namespace
+
+//==============================================================================
+extern "C"
+{
+    void* malloc(size_t size) noexcept
+    {
+        note(Kind::Malloc, size);
+        return __libc_malloc(size);
+    }
+
+    void* calloc(size_t count, size_t size) noexcept
+    {
+        note(Kind::Malloc, count * size);
+        return __libc_calloc(count, size);
+    }
+
+    void* realloc(void* ptr, size_t size) noexcept
+    {
+        note(Kind::Malloc, size);
+        return __libc_realloc(ptr, size);
+    }
+
+    void* memalign(size_t alignment, size_t size) noexcept
+    {
+        note(Kind::Malloc, size);
+        return __libc_memalign(alignment, size);
+    }
+
+    void* aligned_alloc(size_t alignment, size_t size) noexcept
+    {
+        note(Kind::Malloc, size);
+        return __libc_memalign(alignment, size);
+    }
+
+    int posix_memalign(void** result, size_t alignment, size_t size) noexcept
+    {
+        note(Kind::Malloc, size);
+        *result = __libc_memalign(alignment, size);
+        return *result != nullptr || size == 0 ? 0 : ENOMEM;
+    }
+
+    void free(void* ptr) noexcept
+    {
+        if( ptr != nullptr )
+            note(Kind::Free);
+
+        __libc_free(ptr);
+    }
+
+    int pthread_mutex_lock(pthread_mutex_t* mutex) noexcept
+    {
+        note(Kind::MutexLock);
+        return getReal(realMutexLock, "pthread_mutex_lock")(mutex);
+    }
+
+    int pthread_mutex_trylock(pthread_mutex_t* mutex) noexcept
+    {
+        note(Kind::MutexLock);
+        return getReal(realMutexTrylock, "pthread_mutex_trylock")(mutex);
+    }
+
+    int nanosleep(const struct timespec* duration, struct timespec* remaining)
+    {
+        note(Kind::Sleep);
+        return __nanosleep(duration, remaining);
+    }
+
+    int sched_yield() noexcept
+    {
+        note(Kind::Sleep);
+        return __sched_yield();
+    }
+
+    ssize_t write(int fd, const void* buffer, size_t size)
+    {
+        note(Kind::Write, size);
+        return __write(fd, buffer, size);
+    }
+}
+
+//==============================================================================
+namespace RealtimeGuard
+{
+    void install()
+    {
+        getReal(realMutexLock, "pthread_mutex_lock");
+        getReal(realMutexTrylock, "pthread_mutex_trylock");
+
+        void* frames[4];
+        backtrace(frames, 4);
+    }
+
+    void setContext(const char* context)
+    {
+        currentContext.store(context);
+    }
+
+    int getNumViolations()
+    {
+        return numViolations.load();
+    }
+
+    int getNumDropped()
+    {
+        return juce::jmax(0, numViolations.load() - maxViolations);
+    }
+
+    void clear()
+    {
+        numViolations.store(0);
+    }
+
+    ScopedRealtimeCheck::ScopedRealtimeCheck() { ++checkDepth; }
+    ScopedRealtimeCheck::~ScopedRealtimeCheck() { --checkDepth; }
+
+    void printReport(std::ostream& out)
+    {
+        struct Group
+        {
+            const Violation* first = nullptr;
+            int count = 0;
+        };
+
+        //the same call site is usually hit on every block. report each one once.
+        std::map<juce::String, Group> groups;
+        const auto numRecorded = juce::jmin(numViolations.load(), maxViolations);
+        for( int i = 0; i < numRecorded; ++i )
+        {
+            const auto& v = violations[i];
+            juce::String key(static_cast<int>(v.kind));
+            for( int f = framesToSkip; f < v.numFrames; ++f )
+                key << ":" << juce::String::toHexString(reinterpret_cast<juce::pointer_sized_int>(v.frames[f]));
+
+            auto& group = groups[key];
+            if( group.count++ == 0 )
+                group.first = &v;
+        }
+
+        for( const auto& [key, group] : groups )
+        {
+            const auto& v = *group.first;
+            out << group.count << " x " << getKindName(v.kind);
+            if( v.size > 0 )
+                out << " (" << v.size << " bytes)";
+            if( v.context != nullptr )
+                out << " in " << v.context;
+            out << std::endl;
+
+            auto numFrames = v.numFrames - framesToSkip;
+            if( auto* symbols = backtrace_symbols(v.frames + framesToSkip, numFrames) )
+            {
+                for( int f = 0; f < numFrames; ++f )
+                    out << "    " << demangle(symbols[f]) << std::endl;
+
+                std::free(symbols);
+            }
+
+            out << std::endl;
+        }
+
+        if( getNumDropped() > 0 )
+            out << getNumDropped() << " more violations weren't recorded" << std::endl;
+    }
+}
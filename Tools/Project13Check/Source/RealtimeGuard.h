@@ -0,0 +1,66 @@
+/*
+  ==============================================================================
+
+    RealtimeGuard.h
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/*
+ Catches code that isn't realtime safe.
+
+ RealtimeGuard.cpp replaces malloc, calloc, realloc, free and the aligned allocators,
+    pthread_mutex_lock/trylock, nanosleep, sched_yield and write for the whole process.
+    operator new and delete end up in malloc and free, so they are covered too.
+ While a ScopedRealtimeCheck is alive on a thread, every call that thread makes to one of them is recorded
+    with a stack trace, and then passed on to the real function, so the program keeps running.
+
+ Recording doesn't allocate: violations go into a fixed-size table, and the stack traces are only
+    symbolized when the report is printed.
+
+ This relies on glibc, which exports the __libc_* entry points the replacements forward to.
+    the real pthread functions are found with dlsym(RTLD_NEXT).
+ The executable must be linked with -rdynamic so the replacements are the ones the shared libraries find.
+ */
+namespace RealtimeGuard
+{
+    enum class Kind : juce::uint8
+    {
+        Malloc,
+        Free,
+        MutexLock,
+        Sleep,
+        Write,
+        END_OF_LIST
+    };
+
+    //call once from main(), before any checks. warms up backtrace(), which allocates the first time it runs.
+    void install();
+
+    /*
+     a label for the violations that follow, i.e. the case a test driver is running.
+     the pointer is stored, not the string, so it must stay valid until printReport().
+     */
+    void setContext(const char* context);
+
+    int getNumViolations();
+    //the number of violations that didn't fit in the table. they are counted, but have no stack trace.
+    int getNumDropped();
+
+    //prints every distinct violation once, with its count, context and symbolized stack trace
+    void printReport(std::ostream& out);
+    void clear();
+
+    struct ScopedRealtimeCheck
+    {
+        ScopedRealtimeCheck();
+        ~ScopedRealtimeCheck();
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedRealtimeCheck)
+    };
+}
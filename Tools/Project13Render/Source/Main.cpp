@@ -0,0 +1,531 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 19 Oct 2026
+
+    Project13Render
+    Headless offline renderer. Streams audio files through Project13AudioProcessor
+        and writes the result, as fast as the machine allows.
+
+    usage:
+        Project13Render --in <file> --out <file> [options]
+        Project13Render --batch <folder or list file> --out-dir <folder> [--jobs N] [--format wav|flac] [options]
+
+        --in            any format juce::AudioFormatManager::registerBasicFormats() reads (WAV, AIFF, FLAC, ...)
+        --out           .wav or .flac. always stereo, at the input's sample rate.
+        --batch         a folder of audio files, or a text file with one path per line.
+        --out-dir       batch output folder. each output is named after its input.
+        --jobs          batch worker threads. defaults to the number of cores.
+        --format        batch output format. defaults to wav.
+
+    options:
+        --state         a state chunk saved by the plugin, or a .p13preset file. both use the same format.
+        --block-size    the block size processBlock() is called with.
+                        defaults to 512 for a single file, and 4096 in batch mode, where only throughput matters.
+        --bits          output bit depth: 16, 24 or 32 (float). defaults to 24.
+
+    WAV and AIFF inputs are read through a memory-mapped reader.
+    WAV outputs are written straight into a memory-mapped file (see MappedWavWriter).
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../../../Source/PluginProcessor.h"
+
+#include <chrono>
+#include <iostream>
+
+namespace
+{
+struct RenderSettings
+{
+    juce::File stateFile;
+    int blockSize = 512;
+    int bitsPerSample = 24;
+};
+
+struct RenderResult
+{
+    bool ok = false;
+    juce::String error;
+    juce::int64 numSamples = 0;
+    double sampleRate = 0.0;
+    double processSeconds = 0.0;
+    double totalSeconds = 0.0;
+
+    //seconds of audio rendered per second spent in processBlock()
+    double getRealtimeFactor() const
+    {
+        return processSeconds > 0.0 ? (static_cast<double>(numSamples) / sampleRate) / processSeconds : 0.0;
+    }
+};
+
+RenderResult fail(RenderResult r, const juce::String& error)
+{
+    r.ok = false;
+    r.error = error;
+    return r;
+}
+
+double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+//==============================================================================
+/*
+ Writes a stereo WAV file by converting each block directly into a memory-mapped file.
+ There is no intermediate buffer and no write() call per block.
+ The length has to be known up front, which it always is when rendering a file.
+ */
+struct MappedWavWriter
+{
+    static constexpr int headerSize = 44;
+    static constexpr int numChannels = 2;
+
+    bool open(const juce::File& file, double sampleRate, int bits, juce::int64 numFrames)
+    {
+        bitsPerSample = bits;
+        const auto bytesPerFrame = static_cast<juce::int64>(numChannels * bits / 8);
+        const auto dataSize = numFrames * bytesPerFrame;
+        if( dataSize + headerSize - 8 > static_cast<juce::int64>(std::numeric_limits<juce::uint32>::max()) )
+            return false; //too big for a plain RIFF file
+
+        juce::MemoryOutputStream header;
+        header.write("RIFF", 4);
+        header.writeInt(static_cast<int>(dataSize + headerSize - 8));
+        header.write("WAVEfmt ", 8);
+        header.writeInt(16);
+        header.writeShort(static_cast<short>(bits == 32 ? 3 : 1)); //IEEE float : PCM
+        header.writeShort(static_cast<short>(numChannels));
+        header.writeInt(static_cast<int>(sampleRate));
+        header.writeInt(static_cast<int>(sampleRate * static_cast<double>(bytesPerFrame)));
+        header.writeShort(static_cast<short>(bytesPerFrame));
+        header.writeShort(static_cast<short>(bits));
+        header.write("data", 4);
+        header.writeInt(static_cast<int>(dataSize));
+        jassert(header.getDataSize() == headerSize);
+
+        {
+            file.deleteFile();
+            juce::FileOutputStream out(file);
+            if( out.failedToOpen() || out.write(header.getData(), header.getDataSize()) == false )
+                return false;
+
+            //extend the file to its final size, so the whole thing can be mapped
+            if( dataSize > 0 && (out.setPosition(headerSize + dataSize - 1) == false || out.writeByte(0) == false) )
+                return false;
+        }
+
+        mapped = std::make_unique<juce::MemoryMappedFile>(file, juce::MemoryMappedFile::readWrite);
+        if( mapped->getData() == nullptr || static_cast<juce::int64>(mapped->getSize()) != headerSize + dataSize )
+            return false;
+
+        dest = static_cast<char*>(mapped->getData()) + headerSize;
+        return true;
+    }
+
+    void write(const juce::AudioBuffer<float>& buffer, int numSamples)
+    {
+        using namespace juce;
+        auto source = AudioData::NonInterleavedSource<AudioData::Float32, AudioData::NativeEndian> { buffer.getArrayOfReadPointers(), numChannels };
+
+        switch( bitsPerSample )
+        {
+            case 16:
+                AudioData::interleaveSamples(source, AudioData::InterleavedDest<AudioData::Int16, AudioData::LittleEndian> { reinterpret_cast<uint16*>(dest), numChannels }, numSamples);
+                break;
+            case 24:
+                AudioData::interleaveSamples(source, AudioData::InterleavedDest<AudioData::Int24, AudioData::LittleEndian> { reinterpret_cast<char*>(dest), numChannels }, numSamples);
+                break;
+            default:
+                AudioData::interleaveSamples(source, AudioData::InterleavedDest<AudioData::Float32, AudioData::LittleEndian> { reinterpret_cast<float*>(dest), numChannels }, numSamples);
+                break;
+        }
+
+        dest += numSamples * numChannels * bitsPerSample / 8;
+    }
+
+private:
+    std::unique_ptr<juce::MemoryMappedFile> mapped;
+    char* dest = nullptr;
+    int bitsPerSample = 24;
+};
+
+std::unique_ptr<juce::AudioFormatReader> openReader(juce::AudioFormatManager& formats, const juce::File& file)
+{
+    //WAV and AIFF have memory-mapped readers. reading from them is a conversion straight out of the mapping.
+    if( auto* format = formats.findFormatForFileExtension(file.getFileExtension()) )
+    {
+        if( std::unique_ptr<juce::MemoryMappedAudioFormatReader> mapped { format->createMemoryMappedReader(file) } )
+        {
+            if( mapped->mapEntireFile() )
+                return mapped;
+        }
+    }
+
+    return std::unique_ptr<juce::AudioFormatReader>(formats.createReaderFor(file));
+}
+
+std::unique_ptr<juce::AudioFormatWriter> createWriter(juce::AudioFormatManager& formats,
+                                                      const juce::File& file,
+                                                      double sampleRate,
+                                                      int bitsPerSample)
+{
+    auto* format = formats.findFormatForFileExtension(file.getFileExtension());
+    if( format == nullptr )
+        return {};
+
+    file.deleteFile();
+    auto stream = file.createOutputStream();
+    if( stream == nullptr )
+        return {};
+
+    std::unique_ptr<juce::AudioFormatWriter> writer(format->createWriterFor(stream.get(),
+                                                                            sampleRate,
+                                                                            2,
+                                                                            bitsPerSample,
+                                                                            {},
+                                                                            0));
+    if( writer != nullptr )
+        stream.release(); //the writer owns the stream now
+
+    return writer;
+}
+
+//==============================================================================
+/*
+ A processor plus the buffers it renders with.
+ batch workers keep one of these for every file they render.
+ */
+struct Renderer
+{
+    Renderer(juce::AudioFormatManager& f, const RenderSettings& s) : formats(f), settings(s)
+    {
+        processor.setNonRealtime(true);
+
+        if( settings.stateFile != juce::File() )
+        {
+            juce::MemoryBlock chunk;
+            stateLoaded = settings.stateFile.loadFileAsData(chunk);
+            if( stateLoaded )
+                processor.setStateInformation(chunk.getData(), static_cast<int>(chunk.getSize()));
+        }
+    }
+
+    RenderResult render(const juce::File& input, const juce::File& output)
+    {
+        RenderResult result;
+        auto totalStart = std::chrono::steady_clock::now();
+
+        if( settings.stateFile != juce::File() && stateLoaded == false )
+            return fail(result, "can't read " + settings.stateFile.getFullPathName());
+
+        auto reader = openReader(formats, input);
+        if( reader == nullptr )
+            return fail(result, "can't read " + input.getFullPathName());
+
+        result.sampleRate = reader->sampleRate;
+        result.numSamples = reader->lengthInSamples;
+
+        std::unique_ptr<MappedWavWriter> mappedWriter;
+        std::unique_ptr<juce::AudioFormatWriter> writer;
+        if( output.hasFileExtension("wav") )
+        {
+            mappedWriter = std::make_unique<MappedWavWriter>();
+            if( mappedWriter->open(output, reader->sampleRate, settings.bitsPerSample, result.numSamples) == false )
+                mappedWriter.reset();
+        }
+
+        if( mappedWriter == nullptr )
+        {
+            writer = createWriter(formats, output, reader->sampleRate, settings.bitsPerSample);
+            if( writer == nullptr )
+                return fail(result, "can't write " + output.getFullPathName());
+        }
+
+        /*
+         the state was set before the first prepareToPlay(), which adopts it, so the first sample is
+            rendered with the restored settings.
+         for later files, reset() clears the tails of the previous one.
+         */
+        processor.setPlayConfigDetails(2, 2, reader->sampleRate, settings.blockSize);
+        processor.prepareToPlay(reader->sampleRate, settings.blockSize);
+        processor.reset();
+
+        buffer.setSize(2, settings.blockSize, false, false, true);
+        const auto numInputChannels = static_cast<int>(reader->numChannels);
+
+        /*
+         the output is shifted back by the processor's latency, the way a host compensates for it.
+            the input is padded with silence for as long, so the output is as long as the input.
+         */
+        const auto latency = static_cast<juce::int64>(processor.getLatencySamples());
+        const auto numToProcess = result.numSamples + latency;
+
+        std::chrono::steady_clock::duration processTime {};
+        for( juce::int64 pos = 0; pos < numToProcess; pos += settings.blockSize )
+        {
+            auto numThisBlock = static_cast<int>(juce::jmin<juce::int64>(settings.blockSize, numToProcess - pos));
+            auto numToRead = static_cast<int>(juce::jlimit<juce::int64>(0, numThisBlock, result.numSamples - pos));
+
+            //the last block is usually short. hosts do the same, and processBlock() handles it.
+            buffer.setSize(2, numThisBlock, false, false, true);
+            buffer.clear();
+            if( numToRead > 0 )
+            {
+                reader->read(&buffer, 0, numToRead, pos, true, numInputChannels > 1);
+                if( numInputChannels == 1 )
+                    buffer.copyFrom(1, 0, buffer, 0, 0, numToRead);
+            }
+
+            auto start = std::chrono::steady_clock::now();
+            processor.processBlock(buffer, midi);
+            processTime += std::chrono::steady_clock::now() - start;
+
+            auto numToSkip = static_cast<int>(juce::jlimit<juce::int64>(0, numThisBlock, latency - pos));
+            if( numToSkip == numThisBlock )
+                continue;
+
+            juce::AudioBuffer<float> rendered(buffer.getArrayOfWritePointers(), 2, numToSkip, numThisBlock - numToSkip);
+            if( mappedWriter != nullptr )
+                mappedWriter->write(rendered, rendered.getNumSamples());
+            else if( writer->writeFromAudioSampleBuffer(rendered, 0, rendered.getNumSamples()) == false )
+                return fail(result, "write failed: " + output.getFullPathName());
+        }
+
+        processor.releaseResources();
+        //flushes and unmaps the file
+        writer.reset();
+        mappedWriter.reset();
+
+        result.processSeconds = std::chrono::duration<double>(processTime).count();
+        result.totalSeconds = secondsSince(totalStart);
+        result.ok = true;
+        return result;
+    }
+
+private:
+    juce::AudioFormatManager& formats;
+    const RenderSettings& settings;
+    Project13AudioProcessor processor;
+    bool stateLoaded = false;
+
+    juce::AudioBuffer<float> buffer;
+    juce::MidiBuffer midi;
+};
+
+//==============================================================================
+juce::Array<juce::File> collectBatchInputs(const juce::File& source)
+{
+    juce::Array<juce::File> inputs;
+    if( source.isDirectory() )
+    {
+        inputs = source.findChildFiles(juce::File::findFiles, false, "*.wav;*.flac;*.aif;*.aiff");
+        inputs.sort();
+        return inputs;
+    }
+
+    juce::StringArray lines;
+    lines.addLines(source.loadFileAsString());
+    for( auto& line : lines )
+    {
+        if( line.trim().isNotEmpty() )
+            inputs.add(source.getParentDirectory().getChildFile(line.trim()));
+    }
+
+    return inputs;
+}
+
+struct WorkerStats
+{
+    int numFiles = 0, numFailed = 0;
+    juce::int64 numSamples = 0;
+    double processSeconds = 0.0;
+};
+
+int runBatch(juce::AudioFormatManager& formats,
+             const juce::Array<juce::File>& inputs,
+             const juce::File& outDir,
+             const juce::String& extension,
+             int numJobs,
+             const RenderSettings& settings)
+{
+    if( outDir.createDirectory().failed() )
+    {
+        std::cerr << "Project13Render: can't create " << outDir.getFullPathName() << std::endl;
+        return 1;
+    }
+
+    std::cout << "Project13Render: " << inputs.size() << " files, " << numJobs << " jobs, block size "
+              << settings.blockSize << std::endl;
+
+    /*
+     one job per worker, not per file: every worker builds its processor once and then keeps taking
+        the next file until none are left, so a slow file never holds up the others.
+     */
+    std::atomic<int> nextInput { 0 };
+    std::vector<WorkerStats> stats(static_cast<size_t>(numJobs));
+    juce::CriticalSection printLock;
+
+    auto wallStart = std::chrono::steady_clock::now();
+    {
+        juce::ThreadPool pool(numJobs);
+        for( int job = 0; job < numJobs; ++job )
+        {
+            pool.addJob([&, job]()
+            {
+                Renderer renderer(formats, settings);
+                auto& s = stats[static_cast<size_t>(job)];
+
+                for( auto i = nextInput++; i < inputs.size(); i = nextInput++ )
+                {
+                    const auto& input = inputs.getReference(i);
+                    auto output = outDir.getChildFile(input.getFileNameWithoutExtension() + extension);
+                    auto result = renderer.render(input, output);
+
+                    ++s.numFiles;
+                    if( result.ok == false )
+                    {
+                        ++s.numFailed;
+                        const juce::ScopedLock sl(printLock);
+                        std::cerr << "Project13Render: " << result.error << std::endl;
+                        continue;
+                    }
+
+                    s.numSamples += result.numSamples;
+                    s.processSeconds += result.processSeconds;
+                }
+            });
+        }
+
+        //the pool's destructor waits for every worker to finish
+    }
+    auto wallSeconds = secondsSince(wallStart);
+
+    WorkerStats total;
+    double perWorkerRate = 0.0;
+    int activeWorkers = 0;
+    for( const auto& s : stats )
+    {
+        total.numFiles += s.numFiles;
+        total.numFailed += s.numFailed;
+        total.numSamples += s.numSamples;
+        total.processSeconds += s.processSeconds;
+        if( s.processSeconds > 0.0 )
+        {
+            perWorkerRate += static_cast<double>(s.numSamples) / s.processSeconds;
+            ++activeWorkers;
+        }
+    }
+
+    /*
+     per-core scaling compares the whole run against what one worker manages on its own,
+        so memory bandwidth, I/O and the workers that finished early all show up in it.
+     */
+    auto aggregateRate = wallSeconds > 0.0 ? static_cast<double>(total.numSamples) / wallSeconds : 0.0;
+    perWorkerRate = activeWorkers > 0 ? perWorkerRate / activeWorkers : 0.0;
+    auto scaling = perWorkerRate > 0.0 ? aggregateRate / perWorkerRate : 0.0;
+
+    std::cout << "files rendered      " << total.numFiles - total.numFailed << " of " << inputs.size() << std::endl
+              << "wall time           " << juce::String(wallSeconds, 3) << " s" << std::endl
+              << "aggregate           " << juce::String(aggregateRate / 1.0e6, 3) << " M samples/s" << std::endl
+              << "per worker          " << juce::String(perWorkerRate / 1.0e6, 3) << " M samples/s" << std::endl
+              << "scaling             " << juce::String(scaling, 2) << "x on " << numJobs << " jobs ("
+              << juce::String(100.0 * scaling / numJobs, 1) << "% per core)" << std::endl;
+
+    return total.numFailed == 0 ? 0 : 1;
+}
+
+void printUsage()
+{
+    std::cout << "usage: Project13Render --in <file> --out <file> [--state <file>] [--block-size N] [--bits N]" << std::endl
+              << "       Project13Render --batch <folder or list> --out-dir <folder> [--jobs N] [--format wav|flac]"
+              << " [--state <file>] [--block-size N] [--bits N]" << std::endl;
+}
+} //end anonymous namespace
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    //the APVTS, the preset library and the state reclaim timer expect a message manager.
+    juce::ScopedJuceInitialiser_GUI juceInit;
+
+    juce::StringArray args(argv + 1, argc - 1);
+    auto getArg = [&args](const juce::String& name) -> juce::String
+    {
+        auto idx = args.indexOf(name);
+        return idx >= 0 && idx + 1 < args.size() ? args[idx + 1] : juce::String();
+    };
+
+    auto cwd = juce::File::getCurrentWorkingDirectory();
+    const auto batchPath = getArg("--batch");
+    const auto isBatch = batchPath.isNotEmpty();
+
+    RenderSettings settings;
+    //big blocks amortize the per-block work. latency doesn't matter offline.
+    settings.blockSize = isBatch ? 4096 : 512;
+    if( auto state = getArg("--state"); state.isNotEmpty() )
+        settings.stateFile = cwd.getChildFile(state);
+    if( auto blockSize = getArg("--block-size"); blockSize.isNotEmpty() )
+        settings.blockSize = juce::jlimit(1, 65536, blockSize.getIntValue());
+    if( auto bits = getArg("--bits"); bits.isNotEmpty() )
+        settings.bitsPerSample = bits.getIntValue();
+
+    if( settings.bitsPerSample != 16 && settings.bitsPerSample != 24 && settings.bitsPerSample != 32 )
+    {
+        printUsage();
+        return 1;
+    }
+
+    juce::AudioFormatManager formats;
+    formats.registerBasicFormats();
+
+    if( isBatch )
+    {
+        auto outDir = getArg("--out-dir");
+        if( outDir.isEmpty() )
+        {
+            printUsage();
+            return 1;
+        }
+
+        auto numJobs = juce::SystemStats::getNumCpus();
+        if( auto jobs = getArg("--jobs"); jobs.isNotEmpty() )
+            numJobs = juce::jmax(1, jobs.getIntValue());
+
+        auto extension = "." + (getArg("--format").isNotEmpty() ? getArg("--format") : juce::String("wav"));
+        return runBatch(formats,
+                        collectBatchInputs(cwd.getChildFile(batchPath)),
+                        cwd.getChildFile(outDir),
+                        extension,
+                        numJobs,
+                        settings);
+    }
+
+    auto inPath = getArg("--in");
+    auto outPath = getArg("--out");
+    if( inPath.isEmpty() || outPath.isEmpty() )
+    {
+        printUsage();
+        return 1;
+    }
+
+    Renderer renderer(formats, settings);
+    auto result = renderer.render(cwd.getChildFile(inPath), cwd.getChildFile(outPath));
+    if( result.ok == false )
+    {
+        std::cerr << "Project13Render: " << result.error << std::endl;
+        return 1;
+    }
+
+    std::cout << "rendered " << juce::String(static_cast<double>(result.numSamples) / result.sampleRate, 2)
+              << " s of audio in " << juce::String(result.totalSeconds, 3) << " s"
+              << " (processBlock " << juce::String(result.processSeconds, 3) << " s)"
+              << ", realtime factor " << juce::String(result.getRealtimeFactor(), 1) << "x"
+              << std::endl;
+
+    return 0;
+}